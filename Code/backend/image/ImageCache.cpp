@@ -0,0 +1,174 @@
+// header file
+#include "ImageCache.h"
+
+// for holding data
+#include <QCache>
+#include <QCoreApplication>
+#include <climits>
+
+// for debug output
+#include <QDebug>
+
+namespace AWE
+{
+	/** \brief One cached image, which keeps the byte count right. **/
+	struct ImageCacheEntry
+	{
+		ImageCacheEntry(QPixmap image, qint64* residentBytes)
+			:	image(image),
+				bytes(qint64(image.width()) * image.height()
+					* qMax(image.depth(), 8) / 8),
+				residentBytes(residentBytes)
+		{
+			*residentBytes += bytes;
+		}
+
+		~ImageCacheEntry()
+		{
+			*residentBytes -= bytes;
+		}
+
+		QPixmap image;
+		qint64 bytes;
+		qint64* residentBytes;
+	};
+
+	class ImageCachePrivate
+	{
+		public:
+			// get the key for an entry
+			static QString keyFor(QString source, QSize size,
+				Qt::AspectRatioMode mode);
+			// the cost of an entry, in kilobytes so that
+			// big budgets still fit
+			static int costOf(qint64 bytes);
+
+			QCache<QString, ImageCacheEntry> cache;
+			qint64 maxBytes;
+			qint64 residentBytes;
+			qint64 hits;
+			qint64 misses;
+	};
+}
+
+using namespace AWE;
+
+ImageCache* ImageCache::instance()
+{
+	// the pixmaps have to go before the application does
+	static ImageCache* cache = new ImageCache(QCoreApplication::instance());
+	return cache;
+}
+
+ImageCache::ImageCache(QObject* parent)
+	:	QObject(parent),
+		d(new ImageCachePrivate)
+{
+	d->residentBytes = 0;
+	d->hits = 0;
+	d->misses = 0;
+	setMaxBytes(128 * 1024 * 1024);
+}
+
+ImageCache::~ImageCache()
+{
+	// entries point at the byte count
+	d->cache.clear();
+	delete d;
+}
+
+QPixmap ImageCache::find(QString source, QSize size, Qt::AspectRatioMode mode)
+{
+	ImageCacheEntry* entry = d->cache.object(
+		ImageCachePrivate::keyFor(source, size, mode));
+	if (entry)
+	{
+		++ d->hits;
+		return entry->image;
+	}
+	++ d->misses;
+	return QPixmap();
+}
+
+bool ImageCache::contains(QString source, QSize size,
+	Qt::AspectRatioMode mode) const
+{
+	return d->cache.contains(ImageCachePrivate::keyFor(source, size, mode));
+}
+
+bool ImageCache::insert(QString source, QPixmap image, QSize size,
+	Qt::AspectRatioMode mode)
+{
+	if (image.isNull())
+	{
+		return false;
+	}
+	ImageCacheEntry* entry = new ImageCacheEntry(image, &d->residentBytes);
+	// QCache deletes the entry right away if it does not fit
+	if (!d->cache.insert(ImageCachePrivate::keyFor(source, size, mode),
+		entry, ImageCachePrivate::costOf(entry->bytes)))
+	{
+		qWarning() << "ImageCache: Image" << source << "is bigger than the budget";
+		return false;
+	}
+	return true;
+}
+
+void ImageCache::remove(QString source, QSize size, Qt::AspectRatioMode mode)
+{
+	d->cache.remove(ImageCachePrivate::keyFor(source, size, mode));
+}
+
+void ImageCache::clear()
+{
+	d->cache.clear();
+}
+
+void ImageCache::setMaxBytes(qint64 maxBytes)
+{
+	d->maxBytes = maxBytes;
+	d->cache.setMaxCost(ImageCachePrivate::costOf(maxBytes));
+}
+
+qint64 ImageCache::getMaxBytes() const
+{
+	return d->maxBytes;
+}
+
+qint64 ImageCache::getResidentBytes() const
+{
+	return d->residentBytes;
+}
+
+int ImageCache::count() const
+{
+	return d->cache.count();
+}
+
+qint64 ImageCache::getHits() const
+{
+	return d->hits;
+}
+
+qint64 ImageCache::getMisses() const
+{
+	return d->misses;
+}
+
+QString ImageCache::sourceFor(const QPixmap& image)
+{
+	return "pixmap:" + QString::number(image.cacheKey());
+}
+
+QString ImageCachePrivate::keyFor(QString source, QSize size,
+	Qt::AspectRatioMode mode)
+{
+	return source + '\n' + QString::number(size.width())
+		+ 'x' + QString::number(size.height())
+		+ '\n' + QString::number(mode);
+}
+
+int ImageCachePrivate::costOf(qint64 bytes)
+{
+	return (int) qMin<qint64>((bytes + 1023) / 1024, INT_MAX);
+}
@@ -0,0 +1,198 @@
+#ifndef IMAGE_CACHE_H
+#define IMAGE_CACHE_H
+
+// for the library
+#include "macros/BackendLibraryMacros.h"
+
+// superclass
+#include <QObject>
+
+// for holding data
+#include <QString>
+#include <QSize>
+#include <QPixmap>
+
+namespace AWE
+{
+	// internal data
+	class ImageCachePrivate;
+
+	/**
+	 * \brief Holds decoded and scaled images in memory,
+	 *			up to a fixed number of bytes.
+	 *
+	 * Entries are keyed by the source of the image (usually
+	 * the path to the image file), the size it was scaled to
+	 * and the aspect ratio mode used to scale it. The full,
+	 * unscaled image uses a null size. Every widget that shows
+	 * the same image at the same size shares one entry.
+	 *
+	 * When the cache grows past its budget, the entries that
+	 * were used the longest time ago are dropped. Widgets only
+	 * look their icons up here instead of keeping them, so
+	 * memory use stays bounded no matter how big the library
+	 * is. The exceptions are images given to a widget directly
+	 * as a pixmap, and icons too big for the whole budget,
+	 * which stay with the widget that shows them.
+	 *
+	 * There is only one image cache, obtained through
+	 * `ImageCache::instance()`. It must only be used from
+	 * the GUI thread.
+	 **/
+	class AWEMC_BACKEND_LIBRARY ImageCache : public QObject
+	{
+		Q_OBJECT
+
+		public:
+			/**
+			 * \brief Get the image cache.
+			 *
+			 * \returns The image cache.
+			 **/
+			static ImageCache* instance();
+
+			/**
+			 * \brief Destroy this object and every entry.
+			 **/
+			virtual ~ImageCache();
+
+			/**
+			 * \brief Get an image.
+			 *
+			 * Finding an image counts as a hit and makes it
+			 * the most recently used entry; not finding it
+			 * counts as a miss.
+			 *
+			 * \param source The source of the image.
+			 * \param size The size it was scaled to, or a null
+			 *			size for the full image.
+			 * \param mode How the aspect ratio was kept.
+			 *
+			 * \returns The image, or a null pixmap if it is
+			 *			not in the cache.
+			 **/
+			QPixmap find(QString source, QSize size = QSize(),
+				Qt::AspectRatioMode mode = Qt::IgnoreAspectRatio);
+
+			/**
+			 * \brief Determine if an image is in the cache,
+			 *			without counting it as a use.
+			 *
+			 * \param source The source of the image.
+			 * \param size The size it was scaled to, or a null
+			 *			size for the full image.
+			 * \param mode How the aspect ratio was kept.
+			 *
+			 * \returns `true` if it is there, `false` otherwise.
+			 **/
+			bool contains(QString source, QSize size = QSize(),
+				Qt::AspectRatioMode mode = Qt::IgnoreAspectRatio) const;
+
+			/**
+			 * \brief Store an image, replacing the old one with
+			 *			the same key.
+			 *
+			 * \param source The source of the image.
+			 * \param image The image.
+			 * \param size The size it was scaled to, or a null
+			 *			size for the full image.
+			 * \param mode How the aspect ratio was kept.
+			 *
+			 * \returns `true` if the image was stored, `false` if
+			 *			it is bigger than the whole budget.
+			 **/
+			bool insert(QString source, QPixmap image, QSize size = QSize(),
+				Qt::AspectRatioMode mode = Qt::IgnoreAspectRatio);
+
+			/**
+			 * \brief Drop an image.
+			 *
+			 * \param source The source of the image.
+			 * \param size The size it was scaled to, or a null
+			 *			size for the full image.
+			 * \param mode How the aspect ratio was kept.
+			 **/
+			void remove(QString source, QSize size = QSize(),
+				Qt::AspectRatioMode mode = Qt::IgnoreAspectRatio);
+
+			/**
+			 * \brief Drop every image.
+			 **/
+			void clear();
+
+			/**
+			 * \brief Set the budget.
+			 *
+			 * If the cache is already bigger than this,
+			 * entries are dropped right away.
+			 *
+			 * \param maxBytes The number of bytes the cached
+			 *			images may use.
+			 **/
+			void setMaxBytes(qint64 maxBytes);
+
+			/**
+			 * \brief Get the budget.
+			 *
+			 * By default, this is 128 megabytes.
+			 *
+			 * \returns The number of bytes the cached images
+			 *			may use.
+			 **/
+			qint64 getMaxBytes() const;
+
+			/**
+			 * \brief Get the number of bytes used by the
+			 *			cached images.
+			 *
+			 * \returns The resident bytes.
+			 **/
+			qint64 getResidentBytes() const;
+
+			/**
+			 * \brief Get the number of cached images.
+			 *
+			 * \returns The number of images.
+			 **/
+			int count() const;
+
+			/**
+			 * \brief Get the number of times `find()`
+			 *			found an image.
+			 *
+			 * \returns The number of hits.
+			 **/
+			qint64 getHits() const;
+
+			/**
+			 * \brief Get the number of times `find()` did
+			 *			not find an image.
+			 *
+			 * \returns The number of misses.
+			 **/
+			qint64 getMisses() const;
+
+			/**
+			 * \brief Get the source to use for an image that
+			 *			did not come from a file.
+			 *
+			 * \param image The image.
+			 *
+			 * \returns A source that is unique to `image`
+			 *			and its copies.
+			 **/
+			static QString sourceFor(const QPixmap& image);
+
+		private:
+			/**
+			 * \brief Make an empty cache.
+			 * \param parent The parent object.
+			 **/
+			ImageCache(QObject* parent);
+
+			/** \brief Internal data. **/
+			ImageCachePrivate* d;
+	};
+}
+
+#endif // IMAGE_CACHE_H
@@ -0,0 +1,157 @@
+// header file
+#include "ImageHandle.h"
+
+// for explicit sharing
+#include <QSharedData>
+
+// for reading headers
+#include <QImageReader>
+
+// for decoding
+#include "ImageLoader.h"
+
+// for holding the decoded image
+#include "ImageCache.h"
+
+namespace AWE
+{
+	class ImageHandlePrivate : public QSharedData
+	{
+		public:
+			ImageHandlePrivate()
+				:	valid(false),
+					loading(false)
+				{ }
+
+			QString file;
+			QSize size;
+			bool valid;
+
+			// the pixels themselves live in the image cache
+			bool loading;
+	};
+}
+
+using namespace AWE;
+
+ImageHandle::ImageHandle()
+	{ }
+
+ImageHandle::ImageHandle(QString file)
+	:	d(new ImageHandlePrivate)
+{
+	d->file = file;
+	// only look at the header
+	QImageReader reader(file);
+	if (reader.canRead())
+	{
+		d->valid = true;
+		d->size = reader.size();
+	}
+}
+
+ImageHandle::ImageHandle(QString file, QImage image)
+	:	d(new ImageHandlePrivate)
+{
+	d->file = file;
+	d->valid = !image.isNull();
+	d->size = image.size();
+	if (d->valid)
+	{
+		ImageCache::instance()->insert(file, QPixmap::fromImage(image));
+	}
+}
+
+ImageHandle::ImageHandle(const ImageHandle& other)
+	:	d(other.d)
+	{ }
+
+ImageHandle::~ImageHandle() { }
+
+ImageHandle& ImageHandle::operator= (const ImageHandle& other)
+{
+	if (d == other.d) return *this;
+	d = other.d;
+	return *this;
+}
+
+bool ImageHandle::operator== (const ImageHandle& other) const
+{
+	return d == other.d;
+}
+
+bool ImageHandle::operator!= (const ImageHandle& other) const
+{
+	return d != other.d;
+}
+
+bool ImageHandle::isNull() const
+{
+	return !d;
+}
+
+bool ImageHandle::isValid() const
+{
+	return d && d->valid;
+}
+
+QString ImageHandle::getFile() const
+{
+	if (!d) return QString();
+	return d->file;
+}
+
+QSize ImageHandle::getSize() const
+{
+	if (!d) return QSize();
+	return d->size;
+}
+
+bool ImageHandle::isLoaded() const
+{
+	return d && d->valid && ImageCache::instance()->contains(d->file);
+}
+
+bool ImageHandle::isLoading() const
+{
+	return d && d->loading;
+}
+
+QPixmap ImageHandle::getPixmap() const
+{
+	if (!isValid()) return QPixmap();
+	return ImageCache::instance()->find(d->file);
+}
+
+void ImageHandle::load(QObject* context, std::function<void ()> whenLoaded) const
+{
+	if (!isValid() || isLoaded())
+	{
+		whenLoaded();
+		return;
+	}
+	ImageLoader::instance()->load(*this, context, whenLoaded);
+}
+
+void ImageHandle::setLoading()
+{
+	d->loading = true;
+}
+
+void ImageHandle::setImage(QImage image)
+{
+	d->loading = false;
+	if (image.isNull())
+	{
+		d->valid = false;
+	}
+	else
+	{
+		d->size = image.size();
+		// other handles for the same file share it
+		if (!ImageCache::instance()->contains(d->file))
+		{
+			ImageCache::instance()->insert(d->file, QPixmap::fromImage(image));
+		}
+	}
+}
@@ -0,0 +1,208 @@
+#ifndef IMAGE_HANDLE_H
+#define IMAGE_HANDLE_H
+
+// for the library
+#include "macros/BackendLibraryMacros.h"
+
+// for holding data
+#include <QString>
+#include <QSize>
+#include <QImage>
+#include <QPixmap>
+
+// for load callbacks
+#include <QObject>
+#include <functional>
+
+// for explicit sharing
+#include <QExplicitlySharedDataPointer>
+
+namespace AWE
+{
+	// internal data
+	class ImageHandlePrivate;
+
+	/**
+	 * \brief A reference to an image file that is only
+	 *			decoded when someone actually needs it.
+	 *
+	 * Making a handle only reads the header of the file,
+	 * which is enough to know whether it is a real image
+	 * and how big it is. The pixels are decoded on a
+	 * worker thread by the `ImageLoader` when `load()`
+	 * is called.
+	 *
+	 * Handles are explicitly shared: every copy refers to
+	 * the same image. The decoded pixels are not kept in the
+	 * handle but in the `ImageCache`, keyed by the file, so
+	 * every handle for the same file shares them and they
+	 * can be dropped when memory runs short (in which case
+	 * the image is simply decoded again the next time it
+	 * is needed). Handles should only be used from the GUI
+	 * thread.
+	 **/
+	class AWEMC_BACKEND_LIBRARY ImageHandle
+	{
+		public:
+			/**
+			 * \brief Make a null handle.
+			 **/
+			ImageHandle();
+
+			/**
+			 * \brief Make a handle for the given image file.
+			 *
+			 * Only the header of `file` is read.
+			 *
+			 * \param file The path to the image file.
+			 **/
+			explicit ImageHandle(QString file);
+
+			/**
+			 * \brief Make a handle for an image that has
+			 *			already been decoded.
+			 *
+			 * The image is put in the `ImageCache`.
+			 *
+			 * \param file The path to the image file.
+			 * \param image The decoded image.
+			 **/
+			ImageHandle(QString file, QImage image);
+
+			/**
+			 * \brief Make a handle that refers to the same
+			 *			image as `other`.
+			 *
+			 * \param other The handle to copy.
+			 **/
+			ImageHandle(const ImageHandle& other);
+
+			/**
+			 * \brief Destroy this handle.
+			 **/
+			~ImageHandle();
+
+			/**
+			 * \brief Refer to the same image as `other`.
+			 *
+			 * \param other The handle to copy.
+			 **/
+			ImageHandle& operator= (const ImageHandle& other);
+
+			/**
+			 * \brief Determine if two handles refer to
+			 *			the same image.
+			 *
+			 * \param other The handle to compare to.
+			 *
+			 * \returns `true` if they share the same image,
+			 *			`false` otherwise.
+			 **/
+			bool operator== (const ImageHandle& other) const;
+
+			/**
+			 * \brief Determine if two handles refer to
+			 *			different images.
+			 *
+			 * \param other The handle to compare to.
+			 *
+			 * \returns `true` if they do not share the same
+			 *			image, `false` otherwise.
+			 **/
+			bool operator!= (const ImageHandle& other) const;
+
+			/**
+			 * \brief Determine if this handle refers to nothing.
+			 *
+			 * \returns `true` if this is a null handle,
+			 *			`false` otherwise.
+			 **/
+			bool isNull() const;
+
+			/**
+			 * \brief Determine if the file looked like
+			 *			a readable image.
+			 *
+			 * \returns `true` if the image can be decoded,
+			 *			`false` otherwise.
+			 **/
+			bool isValid() const;
+
+			/**
+			 * \brief Get the path to the image file.
+			 *
+			 * \returns The path to the image file.
+			 **/
+			QString getFile() const;
+
+			/**
+			 * \brief Get the size of the image, as read
+			 *			from the header.
+			 *
+			 * \returns The size of the image.
+			 **/
+			QSize getSize() const;
+
+			/**
+			 * \brief Determine if the decoded pixels are in
+			 *			the `ImageCache`.
+			 *
+			 * \returns `true` if `getPixmap()` will return the
+			 *			decoded image, `false` otherwise.
+			 **/
+			bool isLoaded() const;
+
+			/**
+			 * \brief Determine if the image is being decoded
+			 *			right now.
+			 *
+			 * \returns `true` if a decode has been started
+			 *			but has not finished, `false` otherwise.
+			 **/
+			bool isLoading() const;
+
+			/**
+			 * \brief Get the decoded image from the
+			 *			`ImageCache`.
+			 *
+			 * \returns The decoded pixmap, or a null pixmap
+			 *			if it is not loaded.
+			 **/
+			QPixmap getPixmap() const;
+
+			/**
+			 * \brief Decode the image on a worker thread.
+			 *
+			 * `whenLoaded` is called on the GUI thread once
+			 * the image is ready, unless `context` has been
+			 * destroyed by then. If the image is already
+			 * loaded (or can never be), `whenLoaded`
+			 * is called right away.
+			 *
+			 * \param context The object that owns the callback.
+			 * \param whenLoaded The function to call.
+			 **/
+			void load(QObject* context, std::function<void ()> whenLoaded) const;
+
+		private:
+			friend class ImageLoader;
+
+			/**
+			 * \brief Mark that a decode has been started.
+			 **/
+			void setLoading();
+
+			/**
+			 * \brief Store the decoded image in the
+			 *			`ImageCache`.
+			 *
+			 * \param image The decoded image.
+			 **/
+			void setImage(QImage image);
+
+			/** \brief Internal data. **/
+			QExplicitlySharedDataPointer<ImageHandlePrivate> d;
+	};
+}
+
+#endif // IMAGE_HANDLE_H
@@ -0,0 +1,298 @@
+// header file
+#include "ImageLoader.h"
+
+// for decoding
+#include <QImageReader>
+
+// for storing thumbnails
+#include "ThumbnailCache.h"
+
+// for threading
+#include <QThreadPool>
+#include <QRunnable>
+
+// for holding data
+#include <QHash>
+#include <QList>
+#include <QPointer>
+#include <QCoreApplication>
+
+// for debug output
+#include <QDebug>
+
+namespace AWE
+{
+	/** \brief Someone waiting for an image. **/
+	struct ImageLoaderRequest
+	{
+		ImageHandle image;
+		QPointer<QObject> context;
+		std::function<void ()> whenLoaded;
+	};
+
+	/** \brief Someone waiting for a thumbnail. **/
+	struct ThumbnailRequest
+	{
+		QPointer<QObject> context;
+		std::function<void (QImage)> whenLoaded;
+	};
+
+	/** \brief Decodes one file on a worker thread. **/
+	class ImageLoaderJob : public QRunnable
+	{
+		public:
+			ImageLoaderJob(ImageLoader* loader, QString file)
+				:	loader(loader),
+					file(file)
+				{ }
+
+			void run()
+			{
+				QImageReader reader(file);
+				QImage image = reader.read();
+				if (image.isNull())
+				{
+					qWarning() << "ImageLoader: Could not decode" << file
+						<< ":" << reader.errorString();
+				}
+				QMetaObject::invokeMethod(loader, "finish", Qt::QueuedConnection,
+					Q_ARG(QString, file), Q_ARG(QImage, image));
+			}
+
+		private:
+			ImageLoader* loader;
+			QString file;
+	};
+
+	/** \brief Decodes one thumbnail on a worker thread. **/
+	class ThumbnailJob : public QRunnable
+	{
+		public:
+			ThumbnailJob(ImageLoader* loader, QString key, QString file,
+					QSize stored, QImage thumbnail, QSize size,
+					qreal devicePixelRatio)
+				:	loader(loader),
+					key(key),
+					file(file),
+					stored(stored),
+					thumbnail(thumbnail),
+					size(size),
+					devicePixelRatio(devicePixelRatio)
+				{ }
+
+			void run()
+			{
+				if (thumbnail.isNull())
+				{
+					QImageReader reader(file);
+					// let the format skip what it does not need
+					reader.setScaledSize(stored);
+					thumbnail = reader.read();
+					if (thumbnail.isNull())
+					{
+						qWarning() << "ImageLoader: Could not decode" << file
+							<< ":" << reader.errorString();
+					}
+					else
+					{
+						thumbnail = thumbnail.convertToFormat(
+							QImage::Format_ARGB32_Premultiplied);
+						// kept in pixels, at one of a few sizes
+						ThumbnailCache::instance()->insert(file, stored, 1,
+							thumbnail);
+					}
+				}
+				QSize pixels = size * devicePixelRatio;
+				if (!thumbnail.isNull() && thumbnail.size() != pixels)
+				{
+					thumbnail = thumbnail.scaled(pixels, Qt::IgnoreAspectRatio,
+						Qt::SmoothTransformation);
+				}
+				thumbnail.setDevicePixelRatio(devicePixelRatio);
+				QMetaObject::invokeMethod(loader, "finishThumbnail",
+					Qt::QueuedConnection,
+					Q_ARG(QString, key), Q_ARG(QImage, thumbnail));
+			}
+
+		private:
+			ImageLoader* loader;
+			QString key;
+			QString file;
+			// the size it is kept at, and what it was if it was found
+			QSize stored;
+			QImage thumbnail;
+			QSize size;
+			qreal devicePixelRatio;
+	};
+
+	/** \brief Smoothly scales one image on a worker thread. **/
+	class ScaleJob : public QRunnable
+	{
+		public:
+			ScaleJob(ImageLoader* loader, QString key, QImage image,
+					QSize size, qreal devicePixelRatio,
+					Qt::AspectRatioMode mode)
+				:	loader(loader),
+					key(key),
+					image(image),
+					size(size),
+					devicePixelRatio(devicePixelRatio),
+					mode(mode)
+				{ }
+
+			void run()
+			{
+				QImage scaled = image.scaled(size * devicePixelRatio, mode,
+					Qt::SmoothTransformation);
+				scaled.setDevicePixelRatio(devicePixelRatio);
+				QMetaObject::invokeMethod(loader, "finishThumbnail",
+					Qt::QueuedConnection,
+					Q_ARG(QString, key), Q_ARG(QImage, scaled));
+			}
+
+		private:
+			ImageLoader* loader;
+			QString key;
+			QImage image;
+			QSize size;
+			qreal devicePixelRatio;
+			Qt::AspectRatioMode mode;
+	};
+
+	class ImageLoaderPrivate
+	{
+		public:
+			QThreadPool pool;
+
+			// everyone waiting on a file
+			QHash<QString, QList<ImageLoaderRequest> > pending;
+
+			// everyone waiting on a thumbnail
+			QHash<QString, QList<ThumbnailRequest> > pendingThumbnails;
+	};
+}
+
+using namespace AWE;
+
+ImageLoader* ImageLoader::instance()
+{
+	static ImageLoader* loader = new ImageLoader(QCoreApplication::instance());
+	return loader;
+}
+
+ImageLoader::ImageLoader(QObject* parent)
+	:	QObject(parent),
+		d(new ImageLoaderPrivate)
+{
+	qRegisterMetaType<QImage>("QImage");
+}
+
+ImageLoader::~ImageLoader()
+{
+	d->pool.waitForDone();
+	delete d;
+}
+
+void ImageLoader::load(ImageHandle image, QObject* context,
+	std::function<void ()> whenLoaded)
+{
+	QString file = image.getFile();
+	ImageLoaderRequest request = { image, context, whenLoaded };
+	image.setLoading();
+	// only decode each file once
+	bool alreadyPending = d->pending.contains(file);
+	d->pending[file] << request;
+	if (!alreadyPending)
+	{
+		d->pool.start(new ImageLoaderJob(this, file));
+	}
+}
+
+void ImageLoader::loadThumbnail(ImageHandle image, QSize size,
+	qreal devicePixelRatio, QObject* context,
+	std::function<void (QImage)> whenLoaded)
+{
+	QString file = image.getFile();
+	// kept at one of a few sizes, so that every size the
+	// window is resized to does not make a new one
+	QSize pixels = size * devicePixelRatio;
+	QSize stored = ThumbnailCache::snap(pixels, image.getSize());
+	// made in this run or a previous one
+	QImage thumbnail = ThumbnailCache::instance()->find(file, stored, 1);
+	if (!thumbnail.isNull() && thumbnail.size() == pixels)
+	{
+		thumbnail.setDevicePixelRatio(devicePixelRatio);
+		whenLoaded(thumbnail);
+		return;
+	}
+	// only make each thumbnail once
+	QString key = file + '\n' + QString::number(size.width())
+		+ 'x' + QString::number(size.height())
+		+ '@' + QString::number(devicePixelRatio);
+	ThumbnailRequest request = { context, whenLoaded };
+	bool alreadyPending = d->pendingThumbnails.contains(key);
+	d->pendingThumbnails[key] << request;
+	if (!alreadyPending)
+	{
+		// a thumbnail that was found only needs scaling
+		d->pool.start(new ThumbnailJob(this, key, file, stored, thumbnail,
+			size, devicePixelRatio));
+	}
+}
+
+void ImageLoader::scale(QImage image, QString source, QSize size,
+	qreal devicePixelRatio, Qt::AspectRatioMode mode, QObject* context,
+	std::function<void (QImage)> whenScaled)
+{
+	// waits alongside the thumbnails, which are keyed by file
+	QString key = "scaled:" + source + '\n' + QString::number(size.width())
+		+ 'x' + QString::number(size.height())
+		+ '@' + QString::number(devicePixelRatio)
+		+ '#' + QString::number((int) mode);
+	ThumbnailRequest request = { context, whenScaled };
+	bool alreadyPending = d->pendingThumbnails.contains(key);
+	d->pendingThumbnails[key] << request;
+	if (!alreadyPending)
+	{
+		d->pool.start(new ScaleJob(this, key, image, size,
+			devicePixelRatio, mode));
+	}
+}
+
+int ImageLoader::numPending() const
+{
+	return d->pending.count() + d->pendingThumbnails.count();
+}
+
+void ImageLoader::setMaxThreadCount(int threads)
+{
+	d->pool.setMaxThreadCount(threads);
+}
+
+void ImageLoader::finish(QString file, QImage image)
+{
+	QList<ImageLoaderRequest> requests = d->pending.take(file);
+	// store the image first, so that every callback sees it
+	for (ImageLoaderRequest& request : requests)
+	{
+		request.image.setImage(image);
+	}
+	for (const ImageLoaderRequest& request : requests)
+	{
+		if (request.context)
+		{
+			request.whenLoaded();
+		}
+	}
+}
+
+void ImageLoader::finishThumbnail(QString key, QImage thumbnail)
+{
+	for (const ThumbnailRequest& request : d->pendingThumbnails.take(key))
+	{
+		if (request.context)
+		{
+			request.whenLoaded(thumbnail);
+		}
+	}
+}
@@ -0,0 +1,166 @@
+#ifndef IMAGE_LOADER_H
+#define IMAGE_LOADER_H
+
+// for the library
+#include "macros/BackendLibraryMacros.h"
+
+// superclass
+#include <QObject>
+
+// for holding data
+#include <QString>
+#include <QSize>
+#include <QImage>
+#include "ImageHandle.h"
+
+// for callbacks
+#include <functional>
+
+namespace AWE
+{
+	// internal data
+	class ImageLoaderPrivate;
+
+	/**
+	 * \brief Decodes images on a pool of worker threads.
+	 *
+	 * There is only one loader, which is obtained through
+	 * `ImageLoader::instance()`. It must first be obtained
+	 * from the GUI thread, since that is where it delivers
+	 * decoded images.
+	 *
+	 * Requests for a file that is already being decoded
+	 * are merged into the pending request, so a file is
+	 * never decoded twice at the same time.
+	 **/
+	class AWEMC_BACKEND_LIBRARY ImageLoader : public QObject
+	{
+		Q_OBJECT
+
+		public:
+			/**
+			 * \brief Get the image loader.
+			 *
+			 * \returns The image loader.
+			 **/
+			static ImageLoader* instance();
+
+			/**
+			 * \brief Destroy this object, waiting for any
+			 *			decodes that are still running.
+			 **/
+			virtual ~ImageLoader();
+
+			/**
+			 * \brief Decode the image referred to by `image`.
+			 *
+			 * When the image is ready, it is stored in `image`
+			 * (and thus all of its copies) and `whenLoaded` is
+			 * called on the GUI thread, as long as `context`
+			 * still exists.
+			 *
+			 * \param image The image to decode.
+			 * \param context The object that owns the callback.
+			 * \param whenLoaded The function to call.
+			 **/
+			virtual void load(ImageHandle image, QObject* context,
+				std::function<void ()> whenLoaded);
+
+			/**
+			 * \brief Get a thumbnail of the image referred
+			 *			to by `image`.
+			 *
+			 * Thumbnails are kept in the `ThumbnailCache` at one
+			 * of a few sizes (see `ThumbnailCache::snap()`). If it
+			 * already has one at exactly this size, `whenLoaded`
+			 * is called right away. Otherwise, on a worker thread,
+			 * the image is decoded straight to the kept size (so
+			 * formats like JPEG never decode the full image) and
+			 * stored, or the one that was kept is used, and it is
+			 * scaled to this size. Then `whenLoaded` is called on
+			 * the GUI thread as long as `context` still exists.
+			 *
+			 * \param image The image to make a thumbnail of.
+			 * \param size The size the thumbnail is drawn at.
+			 * \param devicePixelRatio The ratio of pixels to
+			 *			drawing units.
+			 * \param context The object that owns the callback.
+			 * \param whenLoaded The function to call with the
+			 *			thumbnail, which is null if the image
+			 *			could not be decoded.
+			 **/
+			virtual void loadThumbnail(ImageHandle image, QSize size,
+				qreal devicePixelRatio, QObject* context,
+				std::function<void (QImage)> whenLoaded);
+
+			/**
+			 * \brief Smoothly scale an image that is already
+			 *			in memory on a worker thread.
+			 *
+			 * Requests for the same source at the same size
+			 * are only scaled once. `whenScaled` is called on
+			 * the GUI thread as long as `context` still exists.
+			 *
+			 * \param image The full image.
+			 * \param source The name of the image, like
+			 *			`ImageCache::sourceFor()` gives.
+			 * \param size The size the image is drawn at.
+			 * \param devicePixelRatio The ratio of pixels to
+			 *			drawing units.
+			 * \param mode How the aspect ratio is kept.
+			 * \param context The object that owns the callback.
+			 * \param whenScaled The function to call with the
+			 *			scaled image.
+			 **/
+			virtual void scale(QImage image, QString source, QSize size,
+				qreal devicePixelRatio, Qt::AspectRatioMode mode,
+				QObject* context, std::function<void (QImage)> whenScaled);
+
+			/**
+			 * \brief Get the number of files waiting to be
+			 *			decoded.
+			 *
+			 * \returns The number of pending files.
+			 **/
+			virtual int numPending() const;
+
+			/**
+			 * \brief Set the number of images that can be
+			 *			decoded at the same time.
+			 *
+			 * \param threads The maximum number of threads.
+			 **/
+			virtual void setMaxThreadCount(int threads);
+
+		private slots:
+			/**
+			 * \brief Deliver a decoded image.
+			 *
+			 * \param file The file that was decoded.
+			 * \param image The decoded image.
+			 **/
+			void finish(QString file, QImage image);
+
+			/**
+			 * \brief Deliver a thumbnail or a scaled image.
+			 *
+			 * \param key The file, size and pixel ratio
+			 *			of the thumbnail.
+			 * \param thumbnail The thumbnail.
+			 **/
+			void finishThumbnail(QString key, QImage thumbnail);
+
+		private:
+			/**
+			 * \brief Make the loader.
+			 *
+			 * \param parent The parent object.
+			 **/
+			ImageLoader(QObject* parent);
+
+			/** \brief Internal data. **/
+			ImageLoaderPrivate* d;
+	};
+}
+
+#endif // IMAGE_LOADER_H
@@ -0,0 +1,391 @@
+// header file
+#include "ThumbnailCache.h"
+
+// for the cache file
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+
+// for checking the image files
+#include "settings/FileInfoCache.h"
+
+// for holding data
+#include <QHash>
+#include <QList>
+#include <QByteArray>
+#include <cstring>
+
+// for thread safety
+#include <QMutex>
+#include <QMutexLocker>
+
+// for debug output
+#include <QDebug>
+
+namespace AWE
+{
+	/** \brief The start of every cache file. **/
+	static const char thumbnailFileMagic[8] = { 'A', 'W', 'E', 'T', 'H', 'M', 'B', '1' };
+
+	/** \brief The start of every thumbnail record. **/
+	static const quint32 thumbnailRecordMagic = 0x424d4854;
+
+	/** \brief Everything in the file starts on this boundary. **/
+	static const qint64 thumbnailAlignment = 16;
+
+	/** \brief How much the file grows by, and is mapped, at once. **/
+	static const qint64 thumbnailChunkBytes = 16 * 1024 * 1024;
+
+	/** \brief The sizes thumbnails are made at, in pixels. **/
+	static const int thumbnailBuckets[] = { 32, 48, 64, 96, 128, 192, 256,
+		384, 512, 768, 1024, 1536, 2048 };
+
+	/** \brief Past the last bucket, sizes are rounded up to this. **/
+	static const int thumbnailBucketStep = 512;
+
+	/** \brief What comes before the key and pixels of a thumbnail. **/
+	struct ThumbnailRecord
+	{
+		quint32 magic;
+		quint32 keyLength;
+		quint32 width;
+		quint32 height;
+		quint32 bytesPerLine;
+		quint32 reserved;
+		quint64 dataLength;
+	};
+
+	/** \brief One mapped part of the file. **/
+	struct ThumbnailRegion
+	{
+		qint64 start;
+		qint64 length;
+		uchar* base;
+	};
+
+	/** \brief Where to find a thumbnail in the mapped file. **/
+	struct ThumbnailEntry
+	{
+		const uchar* data;
+		int width;
+		int height;
+		int bytesPerLine;
+	};
+
+	class ThumbnailCachePrivate
+	{
+		public:
+			// make the key for a thumbnail, or an
+			// empty key if the source does not exist
+			QByteArray keyFor(QString file, QSize size, qreal devicePixelRatio) const;
+			// read every record in the mapped file
+			void readIndex(uchar* base, qint64 length);
+			// clear the file and write the header
+			bool reset();
+			// get the mapped memory from start to end,
+			// growing the file by a chunk if needed
+			uchar* reserve(qint64 start, qint64 end);
+
+			mutable QMutex mutex;
+
+			QFile file;
+			qint64 maxBytes;
+			// where the next record goes
+			qint64 used;
+			// every part of the file that is mapped, in order
+			QList<ThumbnailRegion> regions;
+
+			QHash<QByteArray, ThumbnailEntry> index;
+	};
+}
+
+using namespace AWE;
+
+static qint64 alignedPosition(qint64 pos)
+{
+	return (pos + thumbnailAlignment - 1) / thumbnailAlignment * thumbnailAlignment;
+}
+
+ThumbnailCache* ThumbnailCache::instance()
+{
+	static ThumbnailCache cache;
+	return &cache;
+}
+
+ThumbnailCache::ThumbnailCache()
+	:	d(new ThumbnailCachePrivate)
+{
+	d->maxBytes = 0;
+	d->used = 0;
+}
+
+ThumbnailCache::~ThumbnailCache()
+{
+	close();
+	delete d;
+}
+
+bool ThumbnailCache::open(QString file, qint64 maxBytes)
+{
+	close();
+	QMutexLocker lock(&d->mutex);
+	QDir().mkpath(QFileInfo(file).absolutePath());
+	d->file.setFileName(file);
+	d->maxBytes = maxBytes;
+	if (!d->file.open(QIODevice::ReadWrite))
+	{
+		qWarning() << "ThumbnailCache: Could not open" << file;
+		return false;
+	}
+	// it may have just been made
+	FileInfoCache::instance()->invalidate(file);
+	// check the header, and start over if it is bad or too big
+	char magic[sizeof(thumbnailFileMagic)];
+	if (d->file.size() >= maxBytes
+		|| d->file.read(magic, sizeof(magic)) != sizeof(magic)
+		|| memcmp(magic, thumbnailFileMagic, sizeof(magic)) != 0)
+	{
+		if (!d->reset())
+		{
+			qWarning() << "ThumbnailCache: Could not clear" << file;
+			d->file.close();
+			return false;
+		}
+		return true;
+	}
+	// map the whole thing and find every thumbnail
+	qint64 length = d->file.size();
+	uchar* base = d->file.map(0, length);
+	if (!base)
+	{
+		qWarning() << "ThumbnailCache: Could not map" << file;
+		d->file.close();
+		return false;
+	}
+	ThumbnailRegion region = { 0, length, base };
+	d->regions << region;
+	d->readIndex(base, length);
+	// start over if there is no room left for another chunk
+	if (maxBytes - d->used < thumbnailChunkBytes)
+	{
+		d->file.unmap(base);
+		if (!d->reset())
+		{
+			qWarning() << "ThumbnailCache: Could not clear" << file;
+			d->file.close();
+			return false;
+		}
+	}
+	return true;
+}
+
+void ThumbnailCache::close()
+{
+	QMutexLocker lock(&d->mutex);
+	d->index.clear();
+	d->regions.clear();
+	d->used = 0;
+	if (d->file.isOpen())
+	{
+		// unmaps everything too
+		d->file.close();
+	}
+}
+
+bool ThumbnailCache::isOpen() const
+{
+	QMutexLocker lock(&d->mutex);
+	return d->file.isOpen();
+}
+
+QImage ThumbnailCache::find(QString file, QSize size, qreal devicePixelRatio)
+{
+	QByteArray key = d->keyFor(file, size, devicePixelRatio);
+	QMutexLocker lock(&d->mutex);
+	if (key.isEmpty() || !d->index.contains(key))
+	{
+		return QImage();
+	}
+	const ThumbnailEntry& entry = d->index[key];
+	// refer to the mapped memory, no copying
+	QImage ans(entry.data, entry.width, entry.height, entry.bytesPerLine,
+		QImage::Format_ARGB32_Premultiplied);
+	ans.setDevicePixelRatio(devicePixelRatio);
+	return ans;
+}
+
+bool ThumbnailCache::insert(QString file, QSize size, qreal devicePixelRatio,
+	QImage thumbnail)
+{
+	if (thumbnail.isNull())
+	{
+		return false;
+	}
+	QByteArray key = d->keyFor(file, size, devicePixelRatio);
+	if (key.isEmpty())
+	{
+		return false;
+	}
+	thumbnail = thumbnail.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+	QMutexLocker lock(&d->mutex);
+	if (!d->file.isOpen() || d->index.contains(key))
+	{
+		return false;
+	}
+	// write the record at the end of what is used
+	ThumbnailRecord record;
+	record.magic = thumbnailRecordMagic;
+	record.keyLength = key.size();
+	record.width = thumbnail.width();
+	record.height = thumbnail.height();
+	record.bytesPerLine = thumbnail.bytesPerLine();
+	record.reserved = 0;
+	record.dataLength = thumbnail.byteCount();
+	qint64 start = d->used;
+	qint64 dataStart = alignedPosition(start + sizeof(record) + key.size());
+	qint64 end = alignedPosition(dataStart + record.dataLength);
+	// the file is cleared the next time it is opened
+	if (end > d->maxBytes)
+	{
+		return false;
+	}
+	uchar* base = d->reserve(start, end);
+	if (!base)
+	{
+		qWarning() << "ThumbnailCache: Could not store thumbnail for" << file;
+		return false;
+	}
+	// the header goes in last, so a record that was cut
+	// short looks like the end of the file
+	memset(base, 0, sizeof(record));
+	memcpy(base + sizeof(record), key.constData(), key.size());
+	uchar* data = base + (dataStart - start);
+	memcpy(data, thumbnail.constBits(), record.dataLength);
+	memcpy(base, &record, sizeof(record));
+	d->used = end;
+	ThumbnailEntry entry = { data, thumbnail.width(), thumbnail.height(),
+		thumbnail.bytesPerLine() };
+	d->index[key] = entry;
+	return true;
+}
+
+int ThumbnailCache::count() const
+{
+	QMutexLocker lock(&d->mutex);
+	return d->index.count();
+}
+
+QSize ThumbnailCache::snap(QSize pixels, QSize imageSize)
+{
+	int longest = qMax(pixels.width(), pixels.height());
+	// the smallest bucket that is big enough
+	int bucket = (longest + thumbnailBucketStep - 1) / thumbnailBucketStep
+		* thumbnailBucketStep;
+	for (int size : thumbnailBuckets)
+	{
+		if (size >= longest)
+		{
+			bucket = size;
+			break;
+		}
+	}
+	QSize ans = imageSize.isEmpty() ? pixels : imageSize;
+	ans.scale(bucket, bucket, Qt::KeepAspectRatio);
+	return ans;
+}
+
+QByteArray ThumbnailCachePrivate::keyFor(QString file, QSize size,
+	qreal devicePixelRatio) const
+{
+	// this is asked for while painting, so nothing here
+	// should touch the disk more than once per file
+	QString path = FileInfoCache::resolve(file);
+	FileInfoCache* files = FileInfoCache::instance();
+	qint64 modified = files->getLastModified(path);
+	qint64 bytes = files->getSize(path);
+	if (modified < 0 || bytes < 0)
+	{
+		return QByteArray();
+	}
+	QString key = path
+		+ '\n' + QString::number(modified)
+		+ '\n' + QString::number(bytes)
+		+ '\n' + QString::number(size.width())
+		+ 'x' + QString::number(size.height())
+		+ '@' + QString::number(devicePixelRatio);
+	return key.toUtf8();
+}
+
+uchar* ThumbnailCachePrivate::reserve(qint64 start, qint64 end)
+{
+	if (!regions.isEmpty())
+	{
+		const ThumbnailRegion& last = regions.last();
+		if (start >= last.start && end <= last.start + last.length)
+		{
+			return last.base + (start - last.start);
+		}
+	}
+	// grow by a whole chunk, and map it once, from where the
+	// record starts so that it is all in one piece; the old
+	// mappings stay, since found thumbnails point into them
+	qint64 newEnd = qMin(qMax(end, start + thumbnailChunkBytes), maxBytes);
+	if (file.size() < newEnd && !file.resize(newEnd))
+	{
+		return nullptr;
+	}
+	uchar* base = file.map(start, newEnd - start);
+	if (!base)
+	{
+		return nullptr;
+	}
+	ThumbnailRegion region = { start, newEnd - start, base };
+	regions << region;
+	return base;
+}
+
+void ThumbnailCachePrivate::readIndex(uchar* base, qint64 length)
+{
+	qint64 pos = alignedPosition(sizeof(thumbnailFileMagic));
+	used = pos;
+	while (pos + (qint64) sizeof(ThumbnailRecord) <= length)
+	{
+		ThumbnailRecord record;
+		memcpy(&record, base + pos, sizeof(record));
+		if (record.magic == 0)
+		{
+			// the rest of the last chunk, which is still empty
+			return;
+		}
+		qint64 dataStart = alignedPosition(pos + sizeof(record) + record.keyLength);
+		qint64 end = alignedPosition(dataStart + record.dataLength);
+		if (record.magic != thumbnailRecordMagic || end > length
+			|| (qint64) record.bytesPerLine * record.height != (qint64) record.dataLength)
+		{
+			// a record that was only partly written, so drop the
+			// rest; the file stays the same size while it is mapped
+			qWarning() << "ThumbnailCache: Dropping damaged thumbnails from"
+				<< file.fileName();
+			memset(base + pos, 0, sizeof(record));
+			return;
+		}
+		QByteArray key((const char*) base + pos + sizeof(record), record.keyLength);
+		ThumbnailEntry entry = { base + dataStart, (int) record.width,
+			(int) record.height, (int) record.bytesPerLine };
+		index[key] = entry;
+		pos = end;
+		used = pos;
+	}
+}
+
+bool ThumbnailCachePrivate::reset()
+{
+	index.clear();
+	regions.clear();
+	used = alignedPosition(sizeof(thumbnailFileMagic));
+	return file.resize(0)
+		&& file.seek(0)
+		&& file.write(thumbnailFileMagic, sizeof(thumbnailFileMagic))
+			== sizeof(thumbnailFileMagic)
+		&& file.flush();
+}
@@ -0,0 +1,149 @@
+#ifndef THUMBNAIL_CACHE_H
+#define THUMBNAIL_CACHE_H
+
+// for the library
+#include "macros/BackendLibraryMacros.h"
+
+// for holding data
+#include <QString>
+#include <QSize>
+#include <QImage>
+
+namespace AWE
+{
+	// internal data
+	class ThumbnailCachePrivate;
+
+	/**
+	 * \brief A persistent store of pre-scaled images.
+	 *
+	 * Every thumbnail is kept in a single packed file that
+	 * is memory-mapped while AWEMC is running, so a thumbnail
+	 * that was made in a previous run can be drawn without
+	 * decoding or scaling anything.
+	 *
+	 * Thumbnails are keyed by the path, modification time and
+	 * size of the source image, along with the target size and
+	 * device pixel ratio, so changing the source file makes a
+	 * new thumbnail. Thumbnails should only be made at the few
+	 * sizes given by `snap()` and scaled from there, so that
+	 * resizing the window does not keep adding new ones.
+	 *
+	 * New thumbnails are appended to the end of the file, which
+	 * grows and is mapped a large chunk at a time. If the file
+	 * does not have room for another chunk, it is cleared the
+	 * next time it is opened. The source image's size and time
+	 * come from `FileInfoCache`, so an image rewritten in place
+	 * by another program is only noticed once its directory
+	 * changes.
+	 *
+	 * There is only one thumbnail cache, obtained through
+	 * `ThumbnailCache::instance()`. It may be used from any
+	 * thread.
+	 **/
+	class AWEMC_BACKEND_LIBRARY ThumbnailCache
+	{
+		public:
+			/**
+			 * \brief Get the thumbnail cache.
+			 *
+			 * \returns The thumbnail cache.
+			 **/
+			static ThumbnailCache* instance();
+
+			/**
+			 * \brief Destroy this object, closing the file.
+			 **/
+			~ThumbnailCache();
+
+			/**
+			 * \brief Open (or create) the cache file.
+			 *
+			 * Until this is called, nothing is found and
+			 * nothing is stored.
+			 *
+			 * \param file The path to the cache file.
+			 * \param maxBytes The size the file should not
+			 *			grow past.
+			 *
+			 * \returns `true` if the file could be opened,
+			 *			`false` otherwise.
+			 **/
+			bool open(QString file, qint64 maxBytes);
+
+			/**
+			 * \brief Close the cache file.
+			 **/
+			void close();
+
+			/**
+			 * \brief Determine if the cache file is open.
+			 *
+			 * \returns `true` if it is open, `false` otherwise.
+			 **/
+			bool isOpen() const;
+
+			/**
+			 * \brief Find the thumbnail for the given image.
+			 *
+			 * The returned image refers directly to the mapped
+			 * file, so it is only good until the cache is closed.
+			 *
+			 * \param file The path to the source image.
+			 * \param size The size the thumbnail is drawn at.
+			 * \param devicePixelRatio The ratio of pixels to
+			 *			drawing units.
+			 *
+			 * \returns The thumbnail, or a null image if there
+			 *			is none.
+			 **/
+			QImage find(QString file, QSize size, qreal devicePixelRatio);
+
+			/**
+			 * \brief Store a thumbnail for the given image.
+			 *
+			 * \param file The path to the source image.
+			 * \param size The size the thumbnail is drawn at.
+			 * \param devicePixelRatio The ratio of pixels to
+			 *			drawing units.
+			 * \param thumbnail The scaled image.
+			 *
+			 * \returns `true` if the thumbnail was stored,
+			 *			`false` otherwise.
+			 **/
+			bool insert(QString file, QSize size, qreal devicePixelRatio,
+				QImage thumbnail);
+
+			/**
+			 * \brief Get the number of thumbnails in the cache.
+			 *
+			 * \returns The number of thumbnails.
+			 **/
+			int count() const;
+
+			/**
+			 * \brief Get the size a thumbnail should be made
+			 *			at, out of a few fixed sizes.
+			 *
+			 * \param pixels The size it is drawn at, in pixels.
+			 * \param imageSize The size of the source image, or
+			 *			an empty size if it is not known.
+			 *
+			 * \returns A size with the aspect ratio of the source
+			 *			image, whose longest side is at least
+			 *			as long as that of `pixels`.
+			 **/
+			static QSize snap(QSize pixels, QSize imageSize);
+
+		private:
+			/**
+			 * \brief Make an empty, closed cache.
+			 **/
+			ThumbnailCache();
+
+			/** \brief Internal data. **/
+			ThumbnailCachePrivate* d;
+	};
+}
+
+#endif // THUMBNAIL_CACHE_H
@@ -8,11 +8,27 @@
 #include <QList>
 #include <QString>
 
+// for resolving item paths
+#include "settings/FileInfoCache.h"
+
 namespace AWE {
 	class FolderPrivate
 	{
 		public:
+			// the folder this belongs to
+			Folder* p;
+
+			// read the paths to the items from the config file
+			void makeStubs();
+			// make the `i`th item if it has not been made yet
+			MediaItem* makeItem(int i);
+
+			// the config file of every item, in order
+			QList<QString> itemFiles;
+			// the items themselves, null until they are made
 			QList<MediaItem*> items;
+			// which of the items have been made
+			QList<bool> made;
 	};
 }
 
@@ -23,84 +39,128 @@ Folder::Folder(QString file)
 	:	MediaItem(file),
 		d(new FolderPrivate)
 {
-	// make the items array if necessary
-	if (!getConfigFile()->getMember({"items"}).isArray())
-	{
-		getConfigFile()->addMember({"items"}, JsonValue::Array);
-	}
-	// get all of the items
-	int i = 0;
-	JsonArray arr = getConfigFile()->getMember({"items"}).toArray();
-	while (i < arr.count())
-	{
-		MediaItem* temp = MediaItem::makeItem(getConfigFile()
-			->getPathToConfigFile().absoluteFilePath(arr[i].toString()));
-		if (temp)
-		{
-			// its a valid item, so add it
-			d->items << temp;
-			++ i;
-		}
-		else
-		{
-			// not a valid item, so remove it
-			arr.removeAt(i);
-			getConfigFile()->removeMember({"items", i});
-		}
-	}
+	d->p = this;
+	d->makeStubs();
 }
 
 Folder::Folder(ConfigFile* file)
 	:	MediaItem(file),
 		d(new FolderPrivate)
 {
-	// make the items array if necessary
-	if (!getConfigFile()->getMember({"items"}).isArray())
-	{
-		getConfigFile()->addMember({"items"}, JsonValue::Array);
-	}
-	// get all of the items
+	d->p = this;
+	d->makeStubs();
+}
+
+Folder::~Folder()
+{
+	delete d;
+}
+
+MediaItem::ItemType Folder::getItemType() const
+{
+	return FOLDER;
+}
+
+QList<MediaItem*> Folder::getItems()
+{
+	// make everything, getting rid of bad items
 	int i = 0;
-	JsonArray arr = getConfigFile()->getMember({"items"}).toArray();
-	while (i < arr.count())
+	while (i < d->items.count())
 	{
-		MediaItem* temp = MediaItem::makeItem(getConfigFile()
-			->getPathToConfigFile().absoluteFilePath(arr[i].toString()));
-		if (temp)
+		if (d->makeItem(i))
 		{
-			// its a valid item, so add it
-			d->items << temp;
 			++ i;
 		}
 		else
 		{
 			// not a valid item, so remove it
-			arr.removeAt(i);
+			d->itemFiles.removeAt(i);
+			d->items.removeAt(i);
+			d->made.removeAt(i);
 			getConfigFile()->removeMember({"items", i});
 		}
 	}
+	return d->items;
 }
 
-Folder::~Folder()
+int Folder::numItems() const
 {
-	delete d;
+	return d->items.count();
 }
 
-MediaItem::ItemType Folder::getItemType() const
+MediaItem* Folder::getItem(int i)
 {
-	return FOLDER;
+	if (i < 0 || i >= numItems())
+	{
+		return nullptr;
+	}
+	return d->makeItem(i);
 }
 
-QList<MediaItem*> Folder::getItems()
+QString Folder::getItemFile(int i) const
 {
-	return d->items;
+	if (i < 0 || i >= numItems())
+	{
+		return QString();
+	}
+	return d->itemFiles[i];
+}
+
+bool Folder::isItemMade(int i) const
+{
+	if (i < 0 || i >= numItems())
+	{
+		return false;
+	}
+	return d->made[i];
 }
 
 void Folder::addItem(MediaItem* item)
 {
 	if (item && !d->items.contains(item))
 	{
+		d->itemFiles << QString();
 		d->items << item;
+		d->made << true;
 		emit itemAdded(item);
 	}
 }
+
+void FolderPrivate::makeStubs()
+{
+	// make the items array if necessary
+	if (!p->getConfigFile()->getMember({"items"}).isArray())
+	{
+		p->getConfigFile()->addMember({"items"}, JsonValue::Array);
+	}
+	// only hold on to the paths, nothing is parsed yet
+	int i = 0;
+	QString base = p->getConfigFile()->getPathToConfigFile().absolutePath();
+	JsonArray arr = p->getConfigFile()->getMember({"items"}).toArray();
+	while (i < arr.count())
+	{
+		if (arr.at(i).isString())
+		{
+			itemFiles << FileInfoCache::resolve(arr.at(i).toString(), base);
+			items << nullptr;
+			made << false;
+			++ i;
+		}
+		else
+		{
+			// not a path, so remove it
+			arr.removeAt(i);
+			p->getConfigFile()->removeMember({"items", i});
+		}
+	}
+}
+
+MediaItem* FolderPrivate::makeItem(int i)
+{
+	if (!made[i])
+	{
+		made[i] = true;
+		items[i] = MediaItem::makeItem(itemFiles[i]);
+	}
+	return items[i];
+}
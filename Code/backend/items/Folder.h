@@ -13,6 +13,11 @@ namespace AWE {
 
 	/**
 	 * \brief A folder that contains `MediaItem`s.
+	 *
+	 * The items are not made when the folder is. Until
+	 * an item is asked for, the folder only knows the path
+	 * to its configuration file, so making a folder does
+	 * not read anything below it.
      */
     class AWEMC_BACKEND_LIBRARY Folder : public MediaItem {
 		Q_OBJECT
@@ -47,10 +52,54 @@ namespace AWE {
 			/**
 			 * \brief Get a list of all of the items this folder contains.
 			 *
+			 * This makes every item that has not been made yet.
+			 * Items that turn out to be invalid are removed.
+			 *
 			 * \returns All of the items this folder contains.
              */
             auto getItems() -> QList<MediaItem*>;
 
+			/**
+			 * \brief Get the number of items this folder contains.
+			 *
+			 * Items that have not been made yet are counted,
+			 * even if they may turn out to be invalid.
+			 *
+			 * \returns The number of items.
+             */
+            auto numItems() const -> int;
+
+			/**
+			 * \brief Get the `i`th item, making it if necessary.
+			 *
+			 * \param i The index of the item.
+			 *
+			 * \returns The `i`th item, or `nullptr` if the index
+			 *			is bad or the item is invalid.
+             */
+            auto getItem(int i) -> MediaItem*;
+
+			/**
+			 * \brief Get the path to the `i`th item's
+			 *			configuration file without making it.
+			 *
+			 * \param i The index of the item.
+			 *
+			 * \returns The path to the `i`th item's
+			 *			configuration file, or an empty string
+			 *			if it was added with `addItem()`.
+             */
+            auto getItemFile(int i) const -> QString;
+
+			/**
+			 * \brief Determine if the `i`th item has been made.
+			 *
+			 * \param i The index of the item.
+			 *
+			 * \returns `true` if it has been made, `false` if not.
+             */
+            auto isItemMade(int i) const -> bool;
+
 		public slots:
 			/**
 			 * \brief Add an item.
@@ -17,6 +17,9 @@
 // for holding settings data
 #include "settings/ConfigFile.h"
 
+// for checking files
+#include "settings/FileInfoCache.h"
+
 namespace AWE
 {
 	// internal data class that is, at the moment, used
@@ -38,8 +41,8 @@ MediaItem::MediaItem(QString file)
 {
 	if (getConfigFile()->isValid())
 	{
-		QString f = getConfigFile()->getPathToConfigFile()
-			.absoluteFilePath(getConfigFile()->getConfigFileName());
+		QString f = FileInfoCache::resolve(getConfigFile()->getConfigFileName(),
+			getConfigFile()->getPathToConfigFile().path());
 		MediaItemPrivate::items[f] = this;
 	}
 }
@@ -49,8 +52,8 @@ MediaItem::MediaItem(ConfigFile* file)
 {
 	if (file && file->isValid())
 	{
-		QString f = file->getPathToConfigFile().absoluteFilePath(
-			file->getConfigFileName());
+		QString f = FileInfoCache::resolve(file->getConfigFileName(),
+			file->getPathToConfigFile().path());
 		MediaItemPrivate::items[f] = this;
 	}
 }
@@ -61,8 +64,8 @@ MediaItem::~MediaItem()
 	// called by deleteAllItems, but if this isn't called
 	// by deleteAllItems, there could be errors by leaving
 	// hanging pointer, so set it to nullptr to avoid errors.
-	QString f = getConfigFile()->getPathToConfigFile().absoluteFilePath(
-		getConfigFile()->getConfigFileName());
+	QString f = FileInfoCache::resolve(getConfigFile()->getConfigFileName(),
+		getConfigFile()->getPathToConfigFile().path());
 	MediaItemPrivate::items[f] = nullptr;
 }
 
@@ -84,12 +87,19 @@ bool MediaItem::isService() const
 MediaItem* MediaItem::makeItem(QString file)
 {
 	// check to see if the item is already there
-	if (MediaItemPrivate::items.contains(QDir::cleanPath(file)))
+	QString key = FileInfoCache::resolve(file);
+	auto i = MediaItemPrivate::items.constFind(key);
+	if (i != MediaItemPrivate::items.constEnd())
+	{
+		return i.value();
+	}
+	// missing files would just be made empty
+	if (!FileInfoCache::instance()->exists(key))
 	{
-		return MediaItemPrivate::items[QDir::cleanPath(file)];
+		return nullptr;
 	}
 	// get the data and check for validity
-	ConfigFile* conf = new ConfigFile(file);
+	ConfigFile* conf = new ConfigFile(key);
 	if (!conf->isValid())
 	{
 		delete conf;
@@ -6,7 +6,10 @@
 
 // for making the service
 #include "service/MediaServiceFactory.h"
-#include <QPluginLoader>
+#include "settings/PluginPool.h"
+
+// so that plugins are not loaded just to check them
+#include "settings/PluginCache.h"
 
 // for debug
 #include <QDebug>
@@ -19,12 +22,15 @@ namespace AWE
 			MediaServiceHandler* p;
 
 			MediaService* service;
-			QPluginLoader plugin;
+			// the path to the plugin
+			QString plugin;
 			bool open;
 			bool valid;
 
 			bool tryToLoad();
 			void unload();
+			// find the plugin and determine validity
+			void setUp();
 	};
 }
 
@@ -36,43 +42,15 @@ MediaServiceHandler::MediaServiceHandler(QString file)
 		d(new MediaServiceHandlerPrivate)
 {
 	d->p = this;
-	d->plugin.setFileName(getConfigFile()->getPathToConfigFile()
-		.absoluteFilePath(getLocation()));
-	d->open = false;
-	d->service = nullptr;
-
-	// determine validity
-	d->valid = true;
-	if (!d->tryToLoad())
-	{
-		d->valid = false;
-	}
-	else
-	{
-		d->unload();
-	}
+	d->setUp();
 }
 
 MediaServiceHandler::MediaServiceHandler(ConfigFile* file)
 	:	MediaItem(file),
 		d(new MediaServiceHandlerPrivate)
 {
-	d->plugin.setFileName(getConfigFile()->getPathToConfigFile()
-		.absoluteFilePath(getLocation()));
-	d->open = false;
-	d->service = nullptr;
-
-	// determine validity
-	d->valid = true;
-	if (!d->tryToLoad())
-	{
-		qWarning() << "MediaServiceHandler: Invalid service" << getName();
-		d->valid = false;
-	}
-	else
-	{
-		d->unload();
-	}
+	d->p = this;
+	d->setUp();
 }
 
 MediaServiceHandler::~MediaServiceHandler()
@@ -140,37 +118,31 @@ bool MediaServiceHandlerPrivate::tryToLoad()
 	{
 		return false;
 	}
-	// try to load it
-	if (!plugin.load())
-	{
-		return false;
-	}
-	// get the factory
-	QObject* inst = plugin.instance();
+	// get the factory, which stays loaded for a while
+	QObject* inst = PluginPool::instance()->acquire(plugin);
 	if (!inst)
 	{
-		plugin.unload();
 		return false;
 	}
 	MediaServiceFactory* factory 
 		= qobject_cast<MediaServiceFactory*>(inst);
 	if (!factory)
 	{
-		plugin.unload();
+		PluginPool::instance()->release(plugin);
 		return false;
 	}
 	// get the service
 	service = factory->create(p->getConfigFile());
 	if (!service)
 	{
-		plugin.unload();
+		PluginPool::instance()->release(plugin);
 		return false;
 	}
 	if (!service->isValid())
 	{
 		delete service;
 		service = nullptr;
-		plugin.unload();
+		PluginPool::instance()->release(plugin);
 		return false;
 	}
 	open = true;
@@ -185,6 +157,38 @@ void MediaServiceHandlerPrivate::unload()
 	}
 	delete service;
 	service = nullptr;
-	plugin.unload();
+	PluginPool::instance()->release(plugin);
 	open = false;
 }
+
+void MediaServiceHandlerPrivate::setUp()
+{
+	QString pluginFile = p->getConfigFile()->getPathToConfigFile()
+		.absoluteFilePath(p->getLocation());
+	QString configFile = p->getConfigFile()->getPathToConfigFile()
+		.absoluteFilePath(p->getConfigFile()->getConfigFileName());
+	plugin = pluginFile;
+	open = false;
+	service = nullptr;
+
+	// determine validity, which only means loading the
+	// plugin if it or its config file changed
+	PluginCache* cache = PluginCache::instance();
+	if (!cache->findValidity(pluginFile, configFile, &valid))
+	{
+		valid = true;
+		if (!tryToLoad())
+		{
+			valid = false;
+		}
+		else
+		{
+			unload();
+		}
+		cache->recordValidity(pluginFile, configFile, valid);
+	}
+	if (!valid)
+	{
+		qWarning() << "MediaServiceHandler: Invalid service" << p->getName();
+	}
+}
@@ -0,0 +1,179 @@
+#include "http_client.h"
+
+// for holding handles
+#include <QList>
+
+// for thread safety
+#include <QMutex>
+#include <QMutexLocker>
+
+namespace AWE
+{
+	class HttpClientPrivate
+	{
+		public:
+			// set up the shared caches, if they are not
+			void makeShare();
+			// set the options every request uses
+			void setDefaults(CURL* handle);
+
+			// used by libcurl to lock the shared caches
+			static void lockShare(CURL* handle, curl_lock_data data,
+				curl_lock_access access, void* client);
+			static void unlockShare(CURL* handle, curl_lock_data data,
+				void* client);
+
+			mutable QMutex mutex;
+			QList<CURL*> idle;
+			int inUse;
+
+			CURLSH* share;
+			QMutex shareLocks[CURL_LOCK_DATA_LAST];
+
+			int handlesMade;
+			int requests;
+	};
+}
+
+using namespace AWE;
+
+HttpClient* HttpClient::instance()
+{
+	static HttpClient client;
+	return &client;
+}
+
+HttpClient::HttpClient()
+	:	d(new HttpClientPrivate)
+{
+	d->inUse = 0;
+	d->share = nullptr;
+	d->handlesMade = 0;
+	d->requests = 0;
+}
+
+HttpClient::~HttpClient()
+{
+	// libcurl may be gone by now, so nothing is cleaned up
+	// here; that is what clear() is for
+	delete d;
+}
+
+CURL* HttpClient::acquire()
+{
+	CURL* handle = nullptr;
+	{
+		QMutexLocker lock(&d->mutex);
+		d->makeShare();
+		++ d->requests;
+		++ d->inUse;
+		if (!d->idle.isEmpty())
+		{
+			handle = d->idle.takeLast();
+		}
+		else
+		{
+			++ d->handlesMade;
+		}
+	}
+	if (handle)
+	{
+		// forgets the last request's options, but keeps
+		// its connections and caches
+		curl_easy_reset(handle);
+	}
+	else
+	{
+		handle = curl_easy_init();
+	}
+	d->setDefaults(handle);
+	return handle;
+}
+
+void HttpClient::release(CURL* handle)
+{
+	if (!handle)
+	{
+		return;
+	}
+	QMutexLocker lock(&d->mutex);
+	-- d->inUse;
+	d->idle << handle;
+}
+
+void HttpClient::clear()
+{
+	QMutexLocker lock(&d->mutex);
+	for (auto handle : d->idle)
+	{
+		curl_easy_cleanup(handle);
+	}
+	d->idle.clear();
+	if (d->inUse == 0 && d->share)
+	{
+		curl_share_cleanup(d->share);
+		d->share = nullptr;
+	}
+}
+
+int HttpClient::numHandlesMade() const
+{
+	QMutexLocker lock(&d->mutex);
+	return d->handlesMade;
+}
+
+int HttpClient::numRequests() const
+{
+	QMutexLocker lock(&d->mutex);
+	return d->requests;
+}
+
+void HttpClientPrivate::makeShare()
+{
+	if (share)
+	{
+		return;
+	}
+	share = curl_share_init();
+	curl_share_setopt(share, CURLSHOPT_LOCKFUNC, &HttpClientPrivate::lockShare);
+	curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, &HttpClientPrivate::unlockShare);
+	curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+	curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+	curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+#if LIBCURL_VERSION_NUM >= 0x073900
+	// open connections can only be shared since 7.57
+	curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+#endif
+}
+
+void HttpClientPrivate::setDefaults(CURL* handle)
+{
+	curl_easy_setopt(handle, CURLOPT_SHARE, share);
+	curl_easy_setopt(handle, CURLOPT_FOLLOWLOCATION, 1L);
+	curl_easy_setopt(handle, CURLOPT_TCP_KEEPALIVE, 1L);
+	// every encoding libcurl was built with
+	curl_easy_setopt(handle, CURLOPT_ACCEPT_ENCODING, "");
+#ifdef CURL_HTTP_VERSION_2TLS
+	// falls back to HTTP/1.1 if the server does not speak it
+	curl_easy_setopt(handle, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+#endif
+#if LIBCURL_VERSION_NUM >= 0x072B00
+	// wait for a connection that can be shared instead of opening another
+	curl_easy_setopt(handle, CURLOPT_PIPEWAIT, 1L);
+#endif
+}
+
+void HttpClientPrivate::lockShare(CURL* handle, curl_lock_data data,
+	curl_lock_access access, void* client)
+{
+	Q_UNUSED(handle);
+	Q_UNUSED(access);
+	((HttpClientPrivate*) client)->shareLocks[data].lock();
+}
+
+void HttpClientPrivate::unlockShare(CURL* handle, curl_lock_data data,
+	void* client)
+{
+	Q_UNUSED(handle);
+	((HttpClientPrivate*) client)->shareLocks[data].unlock();
+}
@@ -0,0 +1,92 @@
+#ifndef HTTP_CLIENT_H
+#define HTTP_CLIENT_H
+
+// backend library macros
+#include "macros/BackendLibraryMacros.h"
+
+#include <curl/curl.h>
+
+namespace AWE
+{
+	// internal data
+	class HttpClientPrivate;
+
+	/** \brief Hands out libcurl handles that remember
+	 *			what earlier requests learned.
+	 *
+	 * Every handle shares one DNS cache, TLS session cache
+	 * and (with libcurl 7.57 or newer) connection cache, and
+	 * handles are kept after they are used instead of being
+	 * cleaned up. So after the first page from a host, later
+	 * pages skip the DNS lookup, TCP connection and TLS
+	 * handshake and go over the connection that is already
+	 * open. Handles also ask for HTTP/2 over TLS (if libcurl
+	 * supports it) and for compressed transfers.
+	 *
+	 * There is only one client, obtained through
+	 * `HttpClient::instance()`. It may be used from any
+	 * thread. `clear()` must be called before
+	 * `curl_global_cleanup()`.
+	 */
+	class AWEMC_BACKEND_LIBRARY HttpClient
+	{
+		public:
+			/** \brief Get the client.
+			 *
+			 * \returns The client.
+			 */
+			static HttpClient* instance();
+
+			/** \brief Destroy this object.
+			 */
+			~HttpClient();
+
+			/** \brief Get a handle to make a request with.
+			 *
+			 * The handle has the shared caches and the default
+			 * options set, and nothing else.
+			 *
+			 * \returns The handle, which must be given back
+			 *			with `release()`.
+			 */
+			CURL* acquire();
+
+			/** \brief Give back a handle.
+			 *
+			 * The handle keeps its connections open for the
+			 * next request.
+			 *
+			 * \param handle The handle from `acquire()`.
+			 */
+			void release(CURL* handle);
+
+			/** \brief Clean up every handle that is not in use,
+			 *			and the shared caches once none are.
+			 */
+			void clear();
+
+			/** \brief Get the number of handles made.
+			 *
+			 * \returns The number of handles made since
+			 *			the client was made.
+			 */
+			int numHandlesMade() const;
+
+			/** \brief Get the number of requests made.
+			 *
+			 * \returns The number of times `acquire()`
+			 *			was called.
+			 */
+			int numRequests() const;
+
+		private:
+			/** \brief Make the client.
+			 */
+			HttpClient();
+
+			/** \brief Internal data. */
+			HttpClientPrivate* d;
+	};
+}
+
+#endif // HTTP_CLIENT_H
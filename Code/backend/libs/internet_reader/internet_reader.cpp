@@ -1,89 +1,91 @@
 #include "internet_reader.h"
 
-#include <curl/curl.h>
-#include <cstddef>
-#include <QUrl>
+// for reading in the background
+#include "web_fetcher.h"
 
-/**
- * \brief Used by libcurl to read pages from the internet.
- *
- * Writes the information from `readFromMe` onto `writeToMe`.
- *
- * NOTE: You really, really, really should never call this function directly.
- *
- * \param[in] readFromMe The data to write to `writeToMe`.
- * \param[in] size Part of the size of `readFromMe`.
- * \param[in] nmemb The other part of the size of `readFromMe`.
- * \param[in] writeToMe A `QTextStream*` to write data to.
- **/
-size_t writeCallback(char* readFromMe, size_t size, size_t nmemb, void* writeToMe)
-{
-	QTextStream* temp = (QTextStream*) writeToMe;
-	for (size_t i = 0; i < size * nmemb; ++ i)
-	{
-		temp->operator<< (readFromMe[i]);
-	}
-	return size * nmemb;
-}
+using namespace AWE;
 
 /**
- * \brief Used by libcurl to read pages from the internet.
- *
- * Writes the information from `readFromMe` onto `writeToMe`.
+ * \brief Get the contents of web pages, waiting for the
+ *			`WebFetcher` to read them.
  *
- * NOTE: You really, really, really should never call this function directly.
+ * \param[in] pagesToRead The addresses of the pages.
+ * \param[out] out The contents of each page.
+ * \param[out] charsets The character set of each page,
+ *			if they are wanted.
+ * \param[in] maxPerHost The number of pages to read from
+ *			one host at a time, or 0 for the default.
  *
- * \param[in] readFromMe The data to write to `writeToMe`.
- * \param[in] size Part of the size of `readFromMe`.
- * \param[in] nmemb The other part of the size of `readFromMe`.
- * \param[in] writeToMe A `QIODevice*` to write data to.
+ * \returns `true` if every page was read, `false` otherwise.
  **/
-size_t writeCallbackIODevice(char* readFromMe, size_t size, size_t nmemb, void* writeToMe)
+static bool readURLs(QList<QString> pagesToRead, QList<QByteArray>& out,
+	QList<QString>* charsets = nullptr, int maxPerHost = 0)
 {
-	QIODevice* temp = (QIODevice*) writeToMe;
-	return temp->write(readFromMe, size * nmemb);
+	return WebFetcher::instance()->fetchAndWait(pagesToRead, out, charsets,
+		maxPerHost);
 }
 
 bool readURLIntoStream(QString pageToRead, QTextStream& out)
 {
-	// check for url validity
-	QUrl url(pageToRead);
-	if (!url.isValid() && !url.isRelative())
+	QString text;
+	if (!readURLIntoString(pageToRead, text))
 	{
 		return false;
 	}
+	out << text;
+	return !out.status();
+}
 
-	// now read
-	CURL* curl = curl_easy_init();
-
-	curl_easy_setopt(curl, CURLOPT_URL, pageToRead.toStdString().data());
-	curl_easy_setopt(curl, CURLOPT_WRITEDATA, &out);
-	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &writeCallback);
-	curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+bool readURLIntoString(QString pageToRead, QString& out)
+{
+	QList<QByteArray> bodies;
+	QList<QString> charsets;
+	if (!readURLs(QList<QString>() << pageToRead, bodies, &charsets))
+	{
+		return false;
+	}
+	// decoded all at once
+	out = WebFetcher::decode(bodies[0], charsets[0]);
+	return true;
+}
 
-	bool ans = !curl_easy_perform(curl);
-	curl_easy_cleanup(curl);
+bool readURLIntoByteArray(QString pageToRead, QByteArray& out)
+{
+	QList<QByteArray> bodies;
+	bool ans = readURLs(QList<QString>() << pageToRead, bodies);
+	// shares the buffer the page was downloaded into
+	out = bodies.value(0);
 	return ans;
 }
 
 bool readURLIntoIODevice(QString pageToRead, QIODevice& out)
 {
-	// check for url validity
-	QUrl url(pageToRead);
-	if (!url.isValid() && !url.isRelative())
+	QByteArray body;
+	if (!readURLIntoByteArray(pageToRead, body))
 	{
 		return false;
 	}
+	return out.write(body) == body.size();
+}
 
-	// now read
-	CURL* curl = curl_easy_init();
-
-	curl_easy_setopt(curl, CURLOPT_URL, pageToRead.toStdString().data());
-	curl_easy_setopt(curl, CURLOPT_WRITEDATA, &out);
-	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &writeCallbackIODevice);
-	curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+bool readURLsIntoByteArrays(QList<QString> pagesToRead, QList<QByteArray>& out,
+	int maxPerHost)
+{
+	return readURLs(pagesToRead, out, nullptr, maxPerHost);
+}
 
-	bool ans = !curl_easy_perform(curl);
-	curl_easy_cleanup(curl);
+bool readURLsIntoStrings(QList<QString> pagesToRead, QList<QString>& out,
+	int maxPerHost)
+{
+	QList<QByteArray> bodies;
+	QList<QString> charsets;
+	bool ans = readURLs(pagesToRead, bodies, &charsets, maxPerHost);
+	out.clear();
+	for (int i = 0; i < bodies.count(); ++ i)
+	{
+		out << WebFetcher::decode(bodies[i], charsets[i]);
+		// the bytes are not needed any more
+		bodies[i] = QByteArray();
+	}
 	return ans;
-}
\ No newline at end of file
+}
@@ -7,6 +7,8 @@
 #include <QString>
 #include <QTextStream>
 #include <QIODevice>
+#include <QList>
+#include <QByteArray>
 
 /** \brief Read the given web page.
  *
@@ -32,4 +34,71 @@ AWEMC_BACKEND_LIBRARY auto readURLIntoStream(QString pageToRead,
 AWEMC_BACKEND_LIBRARY auto readURLIntoIODevice(QString pageToRead,
                                                QIODevice& out) -> bool;
 
+/** \brief Read the given web page as text.
+ *
+ * The page is decoded once, using the character set the
+ * server sent (or the page declares).
+ *
+ * \param pageToRead The address of the page to read.
+ * \param out The string to put the text in.
+ *
+ * \returns `true` if `pageToRead` is a valid URL and
+ *					was read,
+ *			`false` if an error occured.
+ */
+AWEMC_BACKEND_LIBRARY auto readURLIntoString(QString pageToRead,
+                                             QString& out) -> bool;
+
+/** \brief Read the given web file as bytes.
+ *
+ * `out` shares the buffer the file was downloaded into,
+ * so nothing is copied.
+ *
+ * \param pageToRead The address of the file to read.
+ * \param out The buffer to put the file in.
+ *
+ * \returns `true` if `pageToRead` is a valid URL and
+ *					was read,
+ *			`false` if an error occured.
+ */
+AWEMC_BACKEND_LIBRARY auto readURLIntoByteArray(QString pageToRead,
+                                                QByteArray& out) -> bool;
+
+/** \brief Read several web files at once.
+ *
+ * The files are read in parallel, with at most `maxPerHost`
+ * of them read from the same host at a time.
+ *
+ * \param pagesToRead The addresses of the files to read.
+ * \param out The contents of each file, in the same order
+ *			as `pagesToRead`. Files that could not be read
+ *			are left empty.
+ * \param maxPerHost The number of files to read from one
+ *			host at a time, or 0 for `WebFetcher::getMaxPerHost()`.
+ *
+ * \returns `true` if every file was read,
+ *			`false` if an error occured.
+ */
+AWEMC_BACKEND_LIBRARY auto readURLsIntoByteArrays(QList<QString> pagesToRead,
+                                                  QList<QByteArray>& out,
+                                                  int maxPerHost = 0) -> bool;
+
+/** \brief Read several web pages at once, as text.
+ *
+ * Like `readURLsIntoByteArrays()`, with each page decoded
+ * like `readURLIntoString()` does.
+ *
+ * \param pagesToRead The addresses of the pages to read.
+ * \param out The text of each page, in the same order
+ *			as `pagesToRead`.
+ * \param maxPerHost The number of pages to read from one
+ *			host at a time, or 0 for `WebFetcher::getMaxPerHost()`.
+ *
+ * \returns `true` if every page was read,
+ *			`false` if an error occured.
+ */
+AWEMC_BACKEND_LIBRARY auto readURLsIntoStrings(QList<QString> pagesToRead,
+                                               QList<QString>& out,
+                                               int maxPerHost = 0) -> bool;
+
 #endif
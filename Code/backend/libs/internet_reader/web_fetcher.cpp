@@ -0,0 +1,905 @@
+#include "web_fetcher.h"
+
+#include <curl/curl.h>
+#include <cstddef>
+#include <QUrl>
+#include <QByteArray>
+#include <QTextCodec>
+
+// for holding data
+#include <QHash>
+#include <QList>
+#include <QPair>
+#include <QPointer>
+#include <QCoreApplication>
+
+// for the network thread
+#include <QThread>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSemaphore>
+#include <QElapsedTimer>
+
+// for pages read recently
+#include "settings/HttpCache.h"
+
+// for handles that keep their connections
+#include "http_client.h"
+
+// for debug output
+#include <QDebug>
+
+using namespace AWE;
+
+/**
+ * \brief Used by libcurl to read pages from the internet.
+ *
+ * Appends the information from `readFromMe` onto `writeToMe`.
+ *
+ * NOTE: You really, really, really should never call this function directly.
+ *
+ * \param[in] readFromMe The data to write to `writeToMe`.
+ * \param[in] size Part of the size of `readFromMe`.
+ * \param[in] nmemb The other part of the size of `readFromMe`.
+ * \param[in] writeToMe A `QByteArray*` to write data to.
+ **/
+size_t writeCallbackByteArray(char* readFromMe, size_t size, size_t nmemb, void* writeToMe)
+{
+	QByteArray* temp = (QByteArray*) writeToMe;
+	temp->append(readFromMe, (int) (size * nmemb));
+	return size * nmemb;
+}
+
+/** \brief What the headers of a response said. **/
+struct ResponseHeaders
+{
+	// for the HttpCache
+	QString etag;
+	QString lastModified;
+	qint64 maxAge;
+	bool noStore;
+
+	// from the Content-Type
+	QString charset;
+
+	// seconds to wait before trying again, or -1
+	qint64 retryAfter;
+};
+
+/** \brief One page being read. **/
+struct URLRequest
+{
+	QString page;
+	QByteArray address;
+	QByteArray* body;
+
+	bool cacheable;
+	ResponseHeaders headers;
+	struct curl_slist* conditions;
+	CURL* curl;
+};
+
+/**
+ * \brief Used by libcurl to read the headers of a response.
+ *
+ * Picks out the headers that matter to the `HttpCache`, the
+ * character set of the page, and its length, which is used
+ * to make room for the whole page at once.
+ *
+ * NOTE: You really, really, really should never call this function directly.
+ *
+ * \param[in] readFromMe One header line.
+ * \param[in] size Part of the size of `readFromMe`.
+ * \param[in] nmemb The other part of the size of `readFromMe`.
+ * \param[in] writeToMe A `URLRequest*` to fill in.
+ **/
+size_t headerCallback(char* readFromMe, size_t size, size_t nmemb, void* writeToMe)
+{
+	URLRequest* request = (URLRequest*) writeToMe;
+	ResponseHeaders* headers = &request->headers;
+	QString line = QString::fromLatin1(readFromMe, (int) (size * nmemb)).trimmed();
+	if (line.startsWith("HTTP/"))
+	{
+		// a new response, after a redirect
+		*headers = ResponseHeaders { QString(), QString(), -1, false, QString(), -1 };
+		return size * nmemb;
+	}
+	int colon = line.indexOf(':');
+	if (colon == -1)
+	{
+		return size * nmemb;
+	}
+	QString name = line.left(colon).trimmed().toLower();
+	QString value = line.mid(colon + 1).trimmed();
+	if (name == "etag")
+	{
+		headers->etag = value;
+	}
+	else if (name == "last-modified")
+	{
+		headers->lastModified = value;
+	}
+	else if (name == "content-type")
+	{
+		for (auto parameter : value.split(';', QString::SkipEmptyParts))
+		{
+			parameter = parameter.trimmed();
+			if (parameter.startsWith("charset=", Qt::CaseInsensitive))
+			{
+				headers->charset = parameter.mid(8).remove('"').trimmed();
+			}
+		}
+	}
+	else if (name == "content-length")
+	{
+		// room for the whole page, unless the server is being silly
+		bool ok;
+		qint64 length = value.toLongLong(&ok);
+		if (ok && length > request->body->capacity()
+			&& length < 64 * 1024 * 1024)
+		{
+			request->body->reserve((int) length);
+		}
+	}
+	else if (name == "retry-after")
+	{
+		// only the number of seconds, not the date
+		bool ok;
+		qint64 seconds = value.toLongLong(&ok);
+		if (ok)
+		{
+			headers->retryAfter = seconds;
+		}
+	}
+	else if (name == "cache-control")
+	{
+		for (auto directive : value.split(',', QString::SkipEmptyParts))
+		{
+			directive = directive.trimmed().toLower();
+			if (directive == "no-store")
+			{
+				headers->noStore = true;
+			}
+			else if (directive == "no-cache")
+			{
+				headers->maxAge = 0;
+			}
+			else if (directive.startsWith("max-age="))
+			{
+				bool ok;
+				qint64 maxAge = directive.mid(8).toLongLong(&ok);
+				if (ok)
+				{
+					headers->maxAge = maxAge;
+				}
+			}
+		}
+	}
+	return size * nmemb;
+}
+
+/**
+ * \brief Start reading a web page.
+ *
+ * If the `HttpCache` has a fresh copy of the page, it is used
+ * and no handle is made. Otherwise, `request.curl` is a handle
+ * that is ready to be performed and handed to `finishRequest()`.
+ *
+ * \param[in,out] request The page to read, with `page` and
+ *			`body` filled in.
+ *
+ * \returns `true` if the page can be read, `false` if it is
+ *			not a valid URL.
+ **/
+static bool startRequest(URLRequest& request)
+{
+	request.curl = nullptr;
+	request.conditions = nullptr;
+	request.headers = ResponseHeaders { QString(), QString(), -1, false, QString(), -1 };
+
+	// check for url validity
+	QUrl url(request.page);
+	if (!url.isValid() && !url.isRelative())
+	{
+		return false;
+	}
+
+	// read recently, so do not read it again
+	HttpCache* cache = HttpCache::instance();
+	request.cacheable = HttpCache::isCacheable(request.page);
+	if (request.cacheable && cache->findFresh(request.page, request.body,
+		&request.headers.charset))
+	{
+		return true;
+	}
+
+	// now read, over a connection that is already open if possible
+	CURL* curl = HttpClient::instance()->acquire();
+	request.curl = curl;
+	request.address = request.page.toUtf8();
+
+	curl_easy_setopt(curl, CURLOPT_URL, request.address.data());
+	curl_easy_setopt(curl, CURLOPT_WRITEDATA, request.body);
+	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, &writeCallbackByteArray);
+	curl_easy_setopt(curl, CURLOPT_HEADERDATA, &request);
+	curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, &headerCallback);
+
+	// a stale page only has to be read again if it changed
+	QString etag, lastModified;
+	if (request.cacheable
+		&& cache->findValidators(request.page, &etag, &lastModified))
+	{
+		if (!etag.isEmpty())
+		{
+			QByteArray line = "If-None-Match: " + etag.toLatin1();
+			request.conditions = curl_slist_append(request.conditions,
+				line.data());
+		}
+		if (!lastModified.isEmpty())
+		{
+			QByteArray line = "If-Modified-Since: " + lastModified.toLatin1();
+			request.conditions = curl_slist_append(request.conditions,
+				line.data());
+		}
+		curl_easy_setopt(curl, CURLOPT_HTTPHEADER, request.conditions);
+	}
+	return true;
+}
+
+/**
+ * \brief Finish reading a web page, giving back its handle.
+ *
+ * \param[in] request The page that was read.
+ * \param[in] result What libcurl said about reading it.
+ * \param[out] status The HTTP status of the response, or 0.
+ *
+ * \returns `true` if the page was read, `false` otherwise.
+ **/
+static bool finishRequest(URLRequest& request, CURLcode result, long* status)
+{
+	bool ans = result == CURLE_OK;
+	*status = 0;
+	curl_easy_getinfo(request.curl, CURLINFO_RESPONSE_CODE, status);
+	HttpClient::instance()->release(request.curl);
+	curl_slist_free_all(request.conditions);
+	request.curl = nullptr;
+	request.conditions = nullptr;
+
+	HttpCache* cache = HttpCache::instance();
+	if (ans && *status == 304)
+	{
+		// it did not change
+		request.body->clear();
+		ans = cache->refresh(request.page, request.headers.maxAge,
+			request.body, &request.headers.charset);
+	}
+	else if (ans && *status == 200 && request.cacheable
+		&& !request.headers.noStore)
+	{
+		cache->insert(request.page, *request.body, request.headers.etag,
+			request.headers.lastModified, request.headers.maxAge,
+			request.headers.charset);
+	}
+	else if (!ans)
+	{
+		// never half a page
+		request.body->clear();
+	}
+	return ans;
+}
+
+namespace AWE
+{
+	/** \brief One page that someone asked for. **/
+	struct FetchRequest
+	{
+		int id;
+		int priority;
+		int maxPerHost;
+		QString host;
+
+		URLRequest request;
+		QByteArray body;
+
+		// tries so far, and when the next may start
+		int attempts;
+		qint64 notBefore;
+		bool running;
+		bool canceled;
+
+		// the answer
+		bool ok;
+
+		// who is waiting, one or the other
+		QPointer<QObject> context;
+		std::function<void (bool, QByteArray, QString)> whenDone;
+		QSemaphore* waiter;
+	};
+
+	/** \brief A token bucket, and what is running, for one host. **/
+	struct HostState
+	{
+		HostState()
+			:	running(0),
+				perSecond(0),
+				burst(1),
+				tokens(1),
+				lastRefill(0)
+			{ }
+
+		int running;
+		double perSecond;
+		int burst;
+		double tokens;
+		qint64 lastRefill;
+	};
+
+	/** \brief Runs the network loop. **/
+	class WebFetcherThread : public QThread
+	{
+		public:
+			WebFetcherThread(WebFetcherPrivate* d)
+				:	d(d)
+				{ }
+
+		protected:
+			void run();
+
+		private:
+			WebFetcherPrivate* d;
+	};
+
+	class WebFetcherPrivate
+	{
+		public:
+			WebFetcher* p;
+
+			// take on a new request
+			void enqueue(FetchRequest* request);
+			// put a request in the queue, in priority order
+			void queueUp(FetchRequest* request);
+			// start every queued request that may start, and
+			// return how long to wait before looking again
+			int startRequests(CURLM* multi);
+			// a request is over, for better or worse
+			void complete(FetchRequest* request, bool ok);
+			// decide whether to try a request again
+			bool shouldRetry(FetchRequest* request, CURLcode result, long status);
+			// the milliseconds since the thread started
+			qint64 now() const { return clock.elapsed(); }
+
+			mutable QMutex mutex;
+			WebFetcherThread* thread;
+			bool stopping;
+			QElapsedTimer clock;
+			CURLM* multi;
+
+			int nextId;
+			QHash<int, FetchRequest*> requests;
+			QList<FetchRequest*> queue;
+			QHash<CURL*, FetchRequest*> running;
+			QHash<QString, HostState> hosts;
+
+			int maxPerHost;
+			int connectTimeout;
+			int totalTimeout;
+			int retries;
+			int backoff;
+	};
+}
+
+WebFetcher* WebFetcher::instance()
+{
+	static WebFetcher* fetcher = new WebFetcher(QCoreApplication::instance());
+	return fetcher;
+}
+
+WebFetcher::WebFetcher(QObject* parent)
+	:	QObject(parent),
+		d(new WebFetcherPrivate)
+{
+	d->p = this;
+	d->stopping = false;
+	d->multi = nullptr;
+	d->nextId = 0;
+	d->maxPerHost = 4;
+	d->connectTimeout = 10 * 1000;
+	d->totalTimeout = 60 * 1000;
+	d->retries = 2;
+	d->backoff = 1000;
+	d->clock.start();
+	d->thread = new WebFetcherThread(d);
+	d->thread->start();
+}
+
+WebFetcher::~WebFetcher()
+{
+	stop();
+	delete d->thread;
+	delete d;
+}
+
+int WebFetcher::fetch(QString url, QObject* context,
+	std::function<void (bool, QByteArray, QString)> whenDone,
+	Priority priority)
+{
+	FetchRequest* request = new FetchRequest;
+	request->request.page = url;
+	request->priority = priority;
+	request->maxPerHost = 0;
+	request->context = context;
+	request->whenDone = whenDone;
+	request->waiter = nullptr;
+	QMutexLocker lock(&d->mutex);
+	d->enqueue(request);
+	return request->id;
+}
+
+bool WebFetcher::fetchAndWait(QList<QString> urls, QList<QByteArray>& bodies,
+	QList<QString>* charsets, int maxPerHost, Priority priority)
+{
+	QSemaphore done;
+	QList<FetchRequest*> mine;
+	{
+		QMutexLocker lock(&d->mutex);
+		for (auto url : urls)
+		{
+			FetchRequest* request = new FetchRequest;
+			request->request.page = url;
+			request->priority = priority;
+			request->maxPerHost = maxPerHost;
+			request->waiter = &done;
+			d->enqueue(request);
+			mine << request;
+		}
+	}
+	// the network thread does the work
+	done.acquire(mine.count());
+
+	bool ans = true;
+	bodies.clear();
+	if (charsets)
+	{
+		charsets->clear();
+	}
+	for (auto request : mine)
+	{
+		ans = ans && request->ok;
+		bodies << request->body;
+		if (charsets)
+		{
+			*charsets << request->request.headers.charset;
+		}
+		delete request;
+	}
+	return ans;
+}
+
+bool WebFetcher::cancel(int request)
+{
+	QMutexLocker lock(&d->mutex);
+	FetchRequest* data = d->requests.value(request);
+	if (!data || data->canceled || data->waiter)
+	{
+		return false;
+	}
+	data->canceled = true;
+	if (!data->running)
+	{
+		// never started, so it is simply forgotten
+		d->queue.removeOne(data);
+		d->requests.remove(request);
+		delete data;
+	}
+	// running ones are removed by the network thread
+	if (d->multi)
+	{
+#if LIBCURL_VERSION_NUM >= 0x074400
+		curl_multi_wakeup(d->multi);
+#endif
+	}
+	return true;
+}
+
+int WebFetcher::numPending() const
+{
+	QMutexLocker lock(&d->mutex);
+	return d->requests.count();
+}
+
+void WebFetcher::setRateLimit(QString host, double perSecond, int burst)
+{
+	QMutexLocker lock(&d->mutex);
+	HostState& state = d->hosts[host.toLower()];
+	state.perSecond = perSecond;
+	state.burst = qMax(1, burst);
+	state.tokens = state.burst;
+	state.lastRefill = d->now();
+}
+
+void WebFetcher::setMaxPerHost(int requests)
+{
+	QMutexLocker lock(&d->mutex);
+	d->maxPerHost = requests;
+}
+
+int WebFetcher::getMaxPerHost() const
+{
+	QMutexLocker lock(&d->mutex);
+	return d->maxPerHost;
+}
+
+void WebFetcher::setTimeouts(int connectMsec, int totalMsec)
+{
+	QMutexLocker lock(&d->mutex);
+	d->connectTimeout = connectMsec;
+	d->totalTimeout = totalMsec;
+}
+
+int WebFetcher::getConnectTimeout() const
+{
+	QMutexLocker lock(&d->mutex);
+	return d->connectTimeout;
+}
+
+int WebFetcher::getTotalTimeout() const
+{
+	QMutexLocker lock(&d->mutex);
+	return d->totalTimeout;
+}
+
+void WebFetcher::setRetries(int retries, int backoffMsec)
+{
+	QMutexLocker lock(&d->mutex);
+	d->retries = retries;
+	d->backoff = backoffMsec;
+}
+
+int WebFetcher::getRetries() const
+{
+	QMutexLocker lock(&d->mutex);
+	return d->retries;
+}
+
+void WebFetcher::stop()
+{
+	{
+		QMutexLocker lock(&d->mutex);
+		if (d->stopping)
+		{
+			return;
+		}
+		d->stopping = true;
+#if LIBCURL_VERSION_NUM >= 0x074400
+		if (d->multi)
+		{
+			curl_multi_wakeup(d->multi);
+		}
+#endif
+	}
+	d->thread->wait();
+}
+
+QString WebFetcher::decode(const QByteArray& body, QString charset)
+{
+	QTextCodec* codec = nullptr;
+	if (!charset.isEmpty())
+	{
+		codec = QTextCodec::codecForName(charset.toLatin1());
+	}
+	if (!codec)
+	{
+		// a byte order mark or <meta charset>, otherwise
+		// what HTTP has always said
+		codec = QTextCodec::codecForHtml(body,
+			QTextCodec::codecForName("ISO-8859-1"));
+	}
+	return codec->toUnicode(body);
+}
+
+void WebFetcher::finish(int request)
+{
+	FetchRequest* data;
+	{
+		QMutexLocker lock(&d->mutex);
+		data = d->requests.take(request);
+	}
+	if (!data)
+	{
+		// canceled since
+		return;
+	}
+	if (!data->canceled && data->context && data->whenDone)
+	{
+		data->whenDone(data->ok, data->body, data->request.headers.charset);
+	}
+	delete data;
+}
+
+void WebFetcherPrivate::enqueue(FetchRequest* request)
+{
+	request->id = nextId ++;
+	request->host = QUrl(request->request.page).host().toLower();
+	request->request.body = &request->body;
+	request->request.curl = nullptr;
+	request->request.conditions = nullptr;
+	request->attempts = 0;
+	request->notBefore = 0;
+	request->running = false;
+	request->canceled = false;
+	request->ok = false;
+	requests[request->id] = request;
+	if (stopping)
+	{
+		complete(request, false);
+		return;
+	}
+	queueUp(request);
+}
+
+void WebFetcherPrivate::queueUp(FetchRequest* request)
+{
+	// after everything at least as urgent
+	int i = 0;
+	while (i < queue.count() && queue[i]->priority >= request->priority)
+	{
+		++ i;
+	}
+	queue.insert(i, request);
+#if LIBCURL_VERSION_NUM >= 0x074400
+	if (multi)
+	{
+		curl_multi_wakeup(multi);
+	}
+#endif
+}
+
+int WebFetcherPrivate::startRequests(CURLM* multi)
+{
+	// without a way to wake the thread up, it looks
+	// at the queue every so often
+#if LIBCURL_VERSION_NUM >= 0x074400
+	int wait = 1000;
+#else
+	int wait = 50;
+#endif
+	qint64 time = now();
+	for (auto i = queue.begin(); i != queue.end(); )
+	{
+		FetchRequest* request = *i;
+		if (request->notBefore > time)
+		{
+			// waiting to be tried again
+			wait = qMin(wait, (int) (request->notBefore - time));
+			++ i;
+			continue;
+		}
+		HostState& host = hosts[request->host];
+		int cap = request->maxPerHost > 0 ? request->maxPerHost : maxPerHost;
+		if (cap > 0 && host.running >= cap)
+		{
+			++ i;
+			continue;
+		}
+		if (host.perSecond > 0)
+		{
+			// refill the bucket for the time that passed
+			host.tokens = qMin((double) host.burst, host.tokens
+				+ (time - host.lastRefill) * host.perSecond / 1000.0);
+			host.lastRefill = time;
+			if (host.tokens < 1)
+			{
+				wait = qMin(wait, qMax(1, (int) ((1 - host.tokens) * 1000.0
+					/ host.perSecond)));
+				++ i;
+				continue;
+			}
+		}
+		i = queue.erase(i);
+		request->body.clear();
+		if (!startRequest(request->request))
+		{
+			complete(request, false);
+			continue;
+		}
+		if (!request->request.curl)
+		{
+			// it was fresh, so the host never hears about it
+			complete(request, true);
+			continue;
+		}
+		if (host.perSecond > 0)
+		{
+			host.tokens -= 1;
+		}
+		++ host.running;
+		++ request->attempts;
+		request->running = true;
+		curl_easy_setopt(request->request.curl, CURLOPT_CONNECTTIMEOUT_MS,
+			(long) connectTimeout);
+		curl_easy_setopt(request->request.curl, CURLOPT_TIMEOUT_MS,
+			(long) totalTimeout);
+		running[request->request.curl] = request;
+		curl_multi_add_handle(multi, request->request.curl);
+	}
+	return wait;
+}
+
+void WebFetcherPrivate::complete(FetchRequest* request, bool ok)
+{
+	request->ok = ok;
+	request->running = false;
+	if (request->waiter)
+	{
+		// belongs to fetchAndWait() from here on
+		requests.remove(request->id);
+		request->waiter->release();
+	}
+	else
+	{
+		QMetaObject::invokeMethod(p, "finish", Qt::QueuedConnection,
+			Q_ARG(int, request->id));
+	}
+}
+
+bool WebFetcherPrivate::shouldRetry(FetchRequest* request, CURLcode result,
+	long status)
+{
+	if (stopping || request->canceled || request->attempts > retries)
+	{
+		return false;
+	}
+	bool transient = false;
+	switch (result)
+	{
+		case CURLE_OK:
+			// the server was there but could not answer
+			transient = status == 408 || status == 429 || status == 500
+				|| status == 502 || status == 503 || status == 504;
+			break;
+		case CURLE_OPERATION_TIMEDOUT: case CURLE_COULDNT_CONNECT:
+		case CURLE_COULDNT_RESOLVE_HOST: case CURLE_SEND_ERROR:
+		case CURLE_RECV_ERROR: case CURLE_GOT_NOTHING:
+		case CURLE_PARTIAL_FILE:
+			transient = true;
+			break;
+		default:
+			break;
+	}
+	if (!transient)
+	{
+		return false;
+	}
+	// twice as long every time, unless the server says otherwise,
+	// but never longer than a request is allowed to take
+	qint64 delay = (qint64) backoff << (request->attempts - 1);
+	if (request->request.headers.retryAfter >= 0)
+	{
+		delay = qMin(request->request.headers.retryAfter * 1000,
+			(qint64) totalTimeout);
+	}
+	request->notBefore = now() + delay;
+	qWarning() << "WebFetcher: Trying" << request->request.page << "again in"
+		<< delay << "ms";
+	return true;
+}
+
+void WebFetcherThread::run()
+{
+	CURLM* multi = curl_multi_init();
+#ifdef CURLPIPE_MULTIPLEX
+	// pages from one host share an HTTP/2 connection
+	curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+#endif
+	{
+		QMutexLocker lock(&d->mutex);
+		d->multi = multi;
+	}
+	while (true)
+	{
+		int wait;
+		{
+			QMutexLocker lock(&d->mutex);
+			if (d->stopping)
+			{
+				break;
+			}
+			// requests canceled while they were running
+			for (auto i = d->running.begin(); i != d->running.end(); )
+			{
+				FetchRequest* request = i.value();
+				if (!request->canceled)
+				{
+					++ i;
+					continue;
+				}
+				curl_multi_remove_handle(multi, i.key());
+				HttpClient::instance()->release(i.key());
+				curl_slist_free_all(request->request.conditions);
+				-- d->hosts[request->host].running;
+				d->requests.remove(request->id);
+				delete request;
+				i = d->running.erase(i);
+			}
+			wait = d->startRequests(multi);
+		}
+
+		int stillRunning;
+		curl_multi_perform(multi, &stillRunning);
+
+		// collect the pages that are done
+		QList<QPair<FetchRequest*, CURLcode> > finished;
+		int left;
+		while (CURLMsg* message = curl_multi_info_read(multi, &left))
+		{
+			if (message->msg != CURLMSG_DONE)
+			{
+				continue;
+			}
+			CURL* curl = message->easy_handle;
+			curl_multi_remove_handle(multi, curl);
+
+			QMutexLocker lock(&d->mutex);
+			FetchRequest* request = d->running.take(curl);
+			-- d->hosts[request->host].running;
+			finished << qMakePair(request, message->data.result);
+		}
+
+		// finished without the lock, since that may write to the
+		// cache; they are still marked as running, so cancel()
+		// leaves them alone until then
+		for (auto done : finished)
+		{
+			FetchRequest* request = done.first;
+			CURLcode result = done.second;
+			long status;
+			bool ok = finishRequest(request->request, result, &status);
+
+			QMutexLocker lock(&d->mutex);
+			if (request->canceled)
+			{
+				d->requests.remove(request->id);
+				delete request;
+			}
+			else if (d->shouldRetry(request, result, status))
+			{
+				request->running = false;
+				d->queueUp(request);
+			}
+			else
+			{
+				if (!ok)
+				{
+					qWarning() << "WebFetcher: Could not read"
+						<< request->request.page << ":"
+						<< curl_easy_strerror(result);
+				}
+				d->complete(request, ok);
+			}
+		}
+
+#if LIBCURL_VERSION_NUM >= 0x071C00
+		curl_multi_wait(multi, nullptr, 0, wait, nullptr);
+#else
+		QThread::msleep(qMin(wait, 50));
+#endif
+	}
+
+	// nothing more is read
+	QMutexLocker lock(&d->mutex);
+	for (auto i = d->running.begin(); i != d->running.end(); ++ i)
+	{
+		curl_multi_remove_handle(multi, i.key());
+		HttpClient::instance()->release(i.key());
+		curl_slist_free_all(i.value()->request.conditions);
+		d->complete(i.value(), false);
+	}
+	d->running.clear();
+	for (auto request : d->queue)
+	{
+		d->complete(request, false);
+	}
+	d->queue.clear();
+	d->multi = nullptr;
+	curl_multi_cleanup(multi);
+}
@@ -0,0 +1,241 @@
+#ifndef WEB_FETCHER_H
+#define WEB_FETCHER_H
+
+// backend library macros
+#include "macros/BackendLibraryMacros.h"
+
+// superclass
+#include <QObject>
+
+// for holding data
+#include <QString>
+#include <QByteArray>
+#include <QList>
+
+// for callbacks
+#include <functional>
+
+namespace AWE
+{
+	// internal data
+	class WebFetcherPrivate;
+
+	/** \brief Reads web pages in the background.
+	 *
+	 * Every page is read on one network thread, which keeps
+	 * all of the requests in flight at once through a curl
+	 * multi handle, so callers never wait on the network
+	 * themselves. `fetch()` returns right away and calls back
+	 * on the GUI thread; `fetchAndWait()` is for code that is
+	 * already running on a worker thread and has nothing else
+	 * to do until its pages are read.
+	 *
+	 * Requests are started highest priority first, with at
+	 * most a few running per host at once. A host can also be
+	 * given a rate limit (a token bucket), so that scrapers do
+	 * not go over the quota of a site's API. Every request
+	 * has a connect deadline and a total deadline, and requests
+	 * that time out or that the server could not answer (like
+	 * `503` or `429`) are tried again after a delay that doubles
+	 * every time, or after the server's `Retry-After` (up to the
+	 * total timeout).
+	 *
+	 * Pages go through the `HttpCache` and the `HttpClient`
+	 * like every other page.
+	 *
+	 * There is only one fetcher, obtained through
+	 * `WebFetcher::instance()`, which should first be called
+	 * on the GUI thread. `stop()` must be called before
+	 * `curl_global_cleanup()`.
+	 */
+	class AWEMC_BACKEND_LIBRARY WebFetcher : public QObject
+	{
+		Q_OBJECT
+
+		public:
+			/** \brief How urgent a request is.
+			 */
+			enum Priority
+			{
+				/** \brief Work that nobody is waiting for. */
+				Low = 0,
+				/** \brief The default. */
+				Normal = 1,
+				/** \brief Work that the user asked for. */
+				High = 2
+			};
+
+			/** \brief Get the fetcher.
+			 *
+			 * \returns The fetcher.
+			 */
+			static WebFetcher* instance();
+
+			/** \brief Destroy this object, stopping the
+			 *			network thread.
+			 */
+			virtual ~WebFetcher();
+
+			/** \brief Read a page in the background.
+			 *
+			 * \param url The address of the page.
+			 * \param context If this is deleted before the page
+			 *			is read, `whenDone` is not called.
+			 * \param whenDone Called on the GUI thread with
+			 *			whether the page was read, its contents
+			 *			and its character set.
+			 * \param priority How urgent the request is.
+			 *
+			 * \returns The ID of the request.
+			 */
+			virtual int fetch(QString url, QObject* context,
+				std::function<void (bool, QByteArray, QString)> whenDone,
+				Priority priority = Normal);
+
+			/** \brief Read several pages and wait for all of them.
+			 *
+			 * This blocks the calling thread until every page is
+			 * done, which the deadlines and retries limit.
+			 *
+			 * \param[in] urls The addresses of the pages.
+			 * \param[out] bodies The contents of each page, in
+			 *			the same order as `urls`. Pages that could
+			 *			not be read are left empty.
+			 * \param[out] charsets The character set of each
+			 *			page, if they are wanted.
+			 * \param[in] maxPerHost The number of these pages to
+			 *			read from one host at a time, or 0 to use
+			 *			`getMaxPerHost()`.
+			 * \param[in] priority How urgent the requests are.
+			 *
+			 * \returns `true` if every page was read,
+			 *			`false` otherwise.
+			 */
+			virtual bool fetchAndWait(QList<QString> urls,
+				QList<QByteArray>& bodies, QList<QString>* charsets = nullptr,
+				int maxPerHost = 0, Priority priority = Normal);
+
+			/** \brief Cancel a request from `fetch()`.
+			 *
+			 * Its callback is not called.
+			 *
+			 * \param request The ID of the request.
+			 *
+			 * \returns `true` if the request was canceled,
+			 *			`false` if it is already done.
+			 */
+			virtual bool cancel(int request);
+
+			/** \brief Get the number of requests that are
+			 *			not done yet.
+			 *
+			 * \returns The number of requests.
+			 */
+			virtual int numPending() const;
+
+			/** \brief Limit how often a host is asked for pages.
+			 *
+			 * \param host The host, like `"api.themoviedb.org"`.
+			 * \param perSecond The number of requests per second,
+			 *			or 0 for no limit.
+			 * \param burst The number of requests that may be
+			 *			made at once after the host was left
+			 *			alone for a while.
+			 */
+			virtual void setRateLimit(QString host, double perSecond,
+				int burst = 1);
+
+			/** \brief Set how many requests may run for one
+			 *			host at once.
+			 *
+			 * \param requests The number of requests, or 0
+			 *			for no limit.
+			 */
+			virtual void setMaxPerHost(int requests);
+
+			/** \brief Get how many requests may run for one
+			 *			host at once.
+			 *
+			 * \returns The number of requests, 4 by default.
+			 */
+			virtual int getMaxPerHost() const;
+
+			/** \brief Set the deadlines of every request.
+			 *
+			 * \param connectMsec How long connecting may take.
+			 * \param totalMsec How long one try at reading a
+			 *			page may take, including connecting.
+			 */
+			virtual void setTimeouts(int connectMsec, int totalMsec);
+
+			/** \brief Get how long connecting may take.
+			 *
+			 * \returns The time in milliseconds, 10 seconds
+			 *			by default.
+			 */
+			virtual int getConnectTimeout() const;
+
+			/** \brief Get how long one try at reading
+			 *			a page may take.
+			 *
+			 * \returns The time in milliseconds, 60 seconds
+			 *			by default.
+			 */
+			virtual int getTotalTimeout() const;
+
+			/** \brief Set how requests are tried again.
+			 *
+			 * \param retries How many more times a request is
+			 *			tried after it first fails.
+			 * \param backoffMsec How long to wait before the
+			 *			first retry. Every later retry waits twice
+			 *			as long as the one before.
+			 */
+			virtual void setRetries(int retries, int backoffMsec);
+
+			/** \brief Get how many more times a request
+			 *			is tried after it first fails.
+			 *
+			 * \returns The number of retries, 2 by default.
+			 */
+			virtual int getRetries() const;
+
+			/** \brief Stop the network thread.
+			 *
+			 * Requests that are not done fail, and later
+			 * requests fail right away.
+			 */
+			virtual void stop();
+
+			/** \brief Turn the contents of a page into text.
+			 *
+			 * \param body The contents of the page.
+			 * \param charset The character set the server sent,
+			 *			if any.
+			 *
+			 * \returns The text of the page.
+			 */
+			static QString decode(const QByteArray& body, QString charset);
+
+		private slots:
+			/** \brief Call back for a request that is done.
+			 *
+			 * \param request The ID of the request.
+			 */
+			void finish(int request);
+
+		private:
+			friend class WebFetcherPrivate;
+
+			/** \brief Make the fetcher.
+			 *
+			 * \param parent The parent object.
+			 */
+			WebFetcher(QObject* parent);
+
+			/** \brief Internal data. */
+			WebFetcherPrivate* d;
+	};
+}
+
+#endif // WEB_FETCHER_H
@@ -9,6 +9,11 @@
 
 // backend forwards
 namespace AWE {
+    // image
+    class ImageCache;
+    class ImageHandle;
+    class ImageLoader;
+    class ThumbnailCache;
     // items
     class Folder;
     class MediaFile;
@@ -18,18 +23,31 @@ namespace AWE {
     class MediaPlayer;
     class MediaPlayerFactory;
     class MediaPlayerHandler;
+    class PlayableFileIndex;
     // scraper
     class MetadataScraper;
     class MetadataScraperFactory;
     class MetadataScraperHandler;
+    class ScrapeJobManager;
+    class ScrapedMetadata;
     // service
     class MediaService;
     class MediaServiceFactory;
     // settings
     class AWEMC;
     class ConfigFile;
+    class ConfigPreloader;
+    class ConfigWriter;
+    class FileInfoCache;
     class GlobalSettings;
+    class HttpCache;
+    class HttpClient;
+    class WebFetcher;
+    class LibrarySnapshot;
+    class MetadataChanges;
     class MetadataHolder;
+    class PluginCache;
+    class PluginPool;
 }
 
 namespace UI {
@@ -54,6 +72,10 @@ namespace UI {
     class ItemCollectionWidget;
     class ItemGridWidget;
     class ItemListWidget;
+    class ItemModel;
+    class ItemMultiViewWidget;
+    class ItemSelectionModel;
+    class MediaItemModel;
     // items
     class ImageItemWidget;
     class ItemWidget;
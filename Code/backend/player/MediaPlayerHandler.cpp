@@ -6,7 +6,15 @@
 
 // for loading the plugin and creating the player
 #include "MediaPlayerFactory.h"
-#include <QPluginLoader>
+#include "settings/PluginPool.h"
+
+// so that plugins are not loaded just to check them
+#include "settings/PluginCache.h"
+
+// for what the plugin can play
+#include "items/MediaFile.h"
+#include <QJsonArray>
+#include <QRegExp>
 
 // for debug
 #include <QDebug>
@@ -18,13 +26,21 @@ namespace AWE
 		public:
 			MediaPlayerHandler* p;
 
-			QPluginLoader plugin;
+			// the path to the plugin
+			QString plugin;
 			MediaPlayer* player;
 			bool open;
 			bool valid;
 
+			// what the plugin says it can play, if it says
+			bool knowsPlayable;
+			QList<QString> patterns;
+			QList<QRegExp> playable;
+
 			bool tryToLoad();
 			void unload();
+			// read what the plugin declares about itself
+			void readMetaData(QJsonObject metaData);
 	};
 }
 
@@ -37,21 +53,34 @@ MediaPlayerHandler::MediaPlayerHandler(QString file)
 {
 	d->p = this;
 	d->player = nullptr;
-	d->plugin.setFileName(getConfigFile()->getPathToConfigFile()
-		.absoluteFilePath(getLocation()));
+	QString pluginFile = getConfigFile()->getPathToConfigFile()
+		.absoluteFilePath(getLocation());
+	QString configFile = getConfigFile()->getPathToConfigFile()
+		.absoluteFilePath(getConfigFile()->getConfigFileName());
+	d->plugin = pluginFile;
 	d->open = false;
 
-	// determine validity
-	d->valid = true;
-	if (!d->tryToLoad())
+	// determine validity, which only means loading the
+	// plugin if it or its config file changed
+	PluginCache* cache = PluginCache::instance();
+	if (!cache->findValidity(pluginFile, configFile, &d->valid))
 	{
-		qWarning() << "MediaPlayerHandler: Invalid player" << getName();
-		d->valid = false;
+		d->valid = true;
+		if (!d->tryToLoad())
+		{
+			d->valid = false;
+		}
+		else
+		{
+			d->unload();
+		}
+		cache->recordValidity(pluginFile, configFile, d->valid);
 	}
-	else
+	if (!d->valid)
 	{
-		d->unload();
+		qWarning() << "MediaPlayerHandler: Invalid player" << getName();
 	}
+	d->readMetaData(cache->getMetaData(pluginFile));
 }
 
 MediaPlayerHandler::~MediaPlayerHandler()
@@ -62,8 +91,21 @@ MediaPlayerHandler::~MediaPlayerHandler()
 
 bool MediaPlayerHandler::canPlay(MediaFile* file) const
 {
-	if (!d->valid)
+	if (!d->valid || !file)
+	{
+		return false;
+	}
+	// the plugin said what it can play, so it is not loaded
+	if (d->knowsPlayable)
 	{
+		QString f = file->getMediaFile();
+		for (auto regex : d->playable)
+		{
+			if (regex.exactMatch(f))
+			{
+				return true;
+			}
+		}
 		return false;
 	}
 	// load if necessary
@@ -89,6 +131,16 @@ bool MediaPlayerHandler::canPlay(MediaFile* file) const
 	return ans;
 }
 
+bool MediaPlayerHandler::declaresPlayable() const
+{
+	return d->knowsPlayable;
+}
+
+QList<QString> MediaPlayerHandler::getPlayablePatterns() const
+{
+	return d->patterns;
+}
+
 bool MediaPlayerHandler::isPlaying() const
 {
 	return d->open && d->player->isPlaying();
@@ -178,37 +230,31 @@ bool MediaPlayerHandlerPrivate::tryToLoad()
 	{
 		return false;
 	}
-	// try to load it
-	if (!plugin.load())
-	{
-		return false;
-	}
-	// get the factory
-	QObject* inst = plugin.instance();
+	// get the factory, which stays loaded for a while
+	QObject* inst = PluginPool::instance()->acquire(plugin);
 	if (!inst)
 	{
-		plugin.unload();
 		return false;
 	}
 	MediaPlayerFactory* factory 
 		= qobject_cast<MediaPlayerFactory*>(inst);
 	if (!factory)
 	{
-		plugin.unload();
+		PluginPool::instance()->release(plugin);
 		return false;
 	}
 	// get the player
 	player = factory->create(p->getConfigFile());
 	if (!player)
 	{
-		plugin.unload();
+		PluginPool::instance()->release(plugin);
 		return false;
 	}
 	if (!player->isValid())
 	{
 		delete player;
 		player = nullptr;
-		plugin.unload();
+		PluginPool::instance()->release(plugin);
 		return false;
 	}
 	open = true;
@@ -223,6 +269,46 @@ void MediaPlayerHandlerPrivate::unload()
 	}
 	delete player;
 	player = nullptr;
-	plugin.unload();
+	PluginPool::instance()->release(plugin);
 	open = false;
-}
\ No newline at end of file
+}
+
+void MediaPlayerHandlerPrivate::readMetaData(QJsonObject metaData)
+{
+	knowsPlayable = false;
+	patterns.clear();
+	playable.clear();
+	// either a list of patterns, or "config" to use
+	// the "can play" list in the config file
+	QJsonValue canPlay = metaData.value("can play");
+	if (canPlay.isArray())
+	{
+		knowsPlayable = true;
+		for (auto pattern : canPlay.toArray())
+		{
+			if (pattern.isString())
+			{
+				patterns << pattern.toString();
+			}
+		}
+	}
+	else if (canPlay.toString() == "config")
+	{
+		JsonValue arr = p->getConfigFile()->getMember({"config", "can play"});
+		if (arr.isArray())
+		{
+			knowsPlayable = true;
+			for (auto pattern : arr.constToArray())
+			{
+				if (pattern.isString())
+				{
+					patterns << pattern.toString();
+				}
+			}
+		}
+	}
+	for (auto pattern : patterns)
+	{
+		playable << QRegExp(pattern, Qt::CaseSensitive, QRegExp::Wildcard);
+	}
+}
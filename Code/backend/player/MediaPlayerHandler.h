@@ -6,6 +6,7 @@
 
 // for data
 #include <QString>
+#include <QList>
 
 namespace AWE {
 	// forward declarations
@@ -18,8 +19,8 @@ namespace AWE {
 	 *
 	 * This automatically loads and unloads the plugin,
 	 * unlike `MetadataScraperHandler`. Calling `play()`
-	 * will load the plugin, and the plugin will be closed
-	 * once the player stops running.
+	 * will load the plugin, and the plugin will be handed
+	 * back to the `PluginPool` once the player stops running.
      */
     class AWEMC_BACKEND_LIBRARY MediaPlayerHandler : public MetadataHolder {
 		Q_OBJECT
@@ -48,6 +49,27 @@ namespace AWE {
              */
 			virtual bool canPlay(MediaFile* file) const;
 
+			/**
+			 * \brief Determine if the plugin says what it
+			 *			can play.
+			 *
+			 * \returns `true` if `getPlayablePatterns()` is all
+			 *			that `canPlay()` looks at, `false` if the
+			 *			plugin has to be asked.
+             */
+			virtual bool declaresPlayable() const;
+
+			/**
+			 * \brief Get the wildcard patterns for the files
+			 *			that this player can play.
+			 *
+			 * These come from the plugin's metadata, see
+			 * `declaresPlayable()`.
+			 *
+			 * \returns The patterns.
+             */
+			virtual QList<QString> getPlayablePatterns() const;
+
 			/**
 			 * \brief Determine if the player is being used.
 			 *
@@ -0,0 +1,230 @@
+// header file
+#include "PlayableFileIndex.h"
+
+// the players and files
+#include "MediaPlayerHandler.h"
+#include "items/MediaFile.h"
+
+// for matching files
+#include <QRegExp>
+
+// for holding data
+#include <QStringList>
+#include <QHash>
+#include <QMultiHash>
+#include <QSet>
+#include <QPair>
+
+namespace AWE
+{
+	class PlayableFileIndexPrivate
+	{
+		public:
+			// get the extension of a path, if it has one
+			static bool extensionOf(QString path, QString* ext);
+			// rebuild the expression for every pattern
+			void combine();
+
+			// every player, in order
+			QList<MediaPlayerHandler*> players;
+
+			// players by the extensions they play
+			QMultiHash<QString, MediaPlayerHandler*> byExtension;
+
+			// players with other patterns, along with an
+			// expression for all of the player's patterns
+			QList<QPair<MediaPlayerHandler*, QRegExp> > byPattern;
+			// every pattern of every player in `byPattern`
+			QStringList allPatterns;
+			QRegExp anyPattern;
+
+			// players that have to be asked
+			QList<MediaPlayerHandler*> undeclared;
+
+			// what was found for each media file
+			QHash<QString, QList<MediaPlayerHandler*> > answers;
+	};
+}
+
+using namespace AWE;
+
+PlayableFileIndex::PlayableFileIndex()
+	:	d(new PlayableFileIndexPrivate)
+{
+	d->combine();
+}
+
+PlayableFileIndex::~PlayableFileIndex()
+{
+	delete d;
+}
+
+void PlayableFileIndex::addPlayer(MediaPlayerHandler* player,
+	QList<QString> patterns)
+{
+	d->players << player;
+	QStringList others;
+	for (auto pattern : patterns)
+	{
+		// "*.mkv" only looks at the extension
+		QString ext = pattern.mid(2);
+		if (pattern.startsWith("*.") && !ext.isEmpty()
+			&& !ext.contains(QRegExp("[*?\\[\\]/.\\\\]")))
+		{
+			d->byExtension.insert(ext, player);
+		}
+		else
+		{
+			others << wildcardToRegExp(pattern);
+		}
+	}
+	if (!others.isEmpty())
+	{
+		d->byPattern << qMakePair(player, QRegExp("(?:" + others.join('|')
+			+ ")", Qt::CaseSensitive, QRegExp::RegExp2));
+		d->allPatterns << others;
+		d->combine();
+	}
+	d->answers.clear();
+}
+
+void PlayableFileIndex::addUndeclaredPlayer(MediaPlayerHandler* player)
+{
+	d->players << player;
+	d->undeclared << player;
+	d->answers.clear();
+}
+
+void PlayableFileIndex::clear()
+{
+	d->players.clear();
+	d->byExtension.clear();
+	d->byPattern.clear();
+	d->allPatterns.clear();
+	d->undeclared.clear();
+	d->answers.clear();
+	d->combine();
+}
+
+QList<MediaPlayerHandler*> PlayableFileIndex::find(MediaFile* file)
+{
+	if (!file)
+	{
+		return QList<MediaPlayerHandler*>();
+	}
+	QString path = file->getMediaFile();
+	auto cached = d->answers.constFind(path);
+	if (cached != d->answers.constEnd())
+	{
+		return cached.value();
+	}
+
+	QSet<MediaPlayerHandler*> found;
+	QString ext;
+	if (PlayableFileIndexPrivate::extensionOf(path, &ext))
+	{
+		for (auto player : d->byExtension.values(ext))
+		{
+			found.insert(player);
+		}
+	}
+	// only look at each player's patterns if one of them matches
+	if (!d->allPatterns.isEmpty() && d->anyPattern.exactMatch(path))
+	{
+		for (auto& entry : d->byPattern)
+		{
+			if (!found.contains(entry.first) && entry.second.exactMatch(path))
+			{
+				found.insert(entry.first);
+			}
+		}
+	}
+	for (auto player : d->undeclared)
+	{
+		if (player->canPlay(file))
+		{
+			found.insert(player);
+		}
+	}
+
+	QList<MediaPlayerHandler*> ans;
+	for (auto player : d->players)
+	{
+		if (found.contains(player) && player->isValid())
+		{
+			ans << player;
+		}
+	}
+	d->answers[path] = ans;
+	return ans;
+}
+
+QString PlayableFileIndex::wildcardToRegExp(QString pattern)
+{
+	QString ans;
+	bool inSet = false;
+	for (int i = 0; i < pattern.length(); ++ i)
+	{
+		QChar c = pattern[i];
+		if (inSet)
+		{
+			// sets are the same in both
+			if (c == ']')
+			{
+				inSet = false;
+			}
+			else if (c == '\\')
+			{
+				ans += '\\';
+			}
+			ans += c;
+		}
+		else if (c == '*')
+		{
+			ans += ".*";
+		}
+		else if (c == '?')
+		{
+			ans += '.';
+		}
+		else if (c == '[' && pattern.indexOf(']', i + 2) != -1)
+		{
+			inSet = true;
+			ans += c;
+			// "[]...]" and "[!]...]" start with a literal ']'
+			if (i + 1 < pattern.length() && pattern[i + 1] == '!')
+			{
+				ans += '^';
+				++ i;
+			}
+			if (i + 1 < pattern.length() && pattern[i + 1] == ']')
+			{
+				ans += "\\]";
+				++ i;
+			}
+		}
+		else
+		{
+			ans += QRegExp::escape(QString(c));
+		}
+	}
+	return ans;
+}
+
+bool PlayableFileIndexPrivate::extensionOf(QString path, QString* ext)
+{
+	int dot = path.lastIndexOf('.');
+	if (dot == -1 || path.indexOf('/', dot) != -1)
+	{
+		return false;
+	}
+	*ext = path.mid(dot + 1);
+	return !ext->isEmpty();
+}
+
+void PlayableFileIndexPrivate::combine()
+{
+	QString joined = allPatterns.join('|');
+	anyPattern = QRegExp("(?:" + joined + ")", Qt::CaseSensitive,
+		QRegExp::RegExp2);
+}
@@ -0,0 +1,101 @@
+#ifndef PLAYABLE_FILE_INDEX_H
+#define PLAYABLE_FILE_INDEX_H
+
+// for the library
+#include "macros/BackendLibraryMacros.h"
+
+// for holding data
+#include <QList>
+#include <QString>
+
+namespace AWE
+{
+	// forward declarations
+	class MediaFile;
+	class MediaPlayerHandler;
+	// internal data
+	class PlayableFileIndexPrivate;
+
+	/**
+	 * \brief Finds the players that can play a file without
+	 *			asking each one of them.
+	 *
+	 * Every player hands its `"can play"` wildcard patterns
+	 * to the index once. Patterns that only check the
+	 * extension (like `*.mkv`) go into a hash from extension
+	 * to players, and the rest are turned into regular
+	 * expressions and combined, so that a file is checked
+	 * against one expression to find out if any of them
+	 * could match, and then against one expression per
+	 * player that has such patterns.
+	 *
+	 * Players that do not say what they can play are still
+	 * asked with `MediaPlayerHandler::canPlay()`.
+	 *
+	 * Answers are remembered per media file path, so showing
+	 * the same file again costs a single lookup.
+	 **/
+	class AWEMC_BACKEND_LIBRARY PlayableFileIndex
+	{
+		public:
+			/**
+			 * \brief Make an empty index.
+			 **/
+			PlayableFileIndex();
+
+			/**
+			 * \brief Destroy this object.
+			 **/
+			~PlayableFileIndex();
+
+			/**
+			 * \brief Add a player with the patterns it can play.
+			 *
+			 * \param player The player.
+			 * \param patterns The wildcard patterns for the
+			 *			files it can play.
+			 **/
+			void addPlayer(MediaPlayerHandler* player,
+				QList<QString> patterns);
+
+			/**
+			 * \brief Add a player that has to be asked.
+			 *
+			 * \param player The player.
+			 **/
+			void addUndeclaredPlayer(MediaPlayerHandler* player);
+
+			/**
+			 * \brief Forget every player.
+			 **/
+			void clear();
+
+			/**
+			 * \brief Find the players that can play a file.
+			 *
+			 * \param file The file to play.
+			 *
+			 * \returns The players that can play `file`,
+			 *			in the order they were added.
+			 **/
+			QList<MediaPlayerHandler*> find(MediaFile* file);
+
+			/**
+			 * \brief Turn a wildcard pattern into the
+			 *			equivalent regular expression.
+			 *
+			 * This follows `QRegExp::Wildcard`.
+			 *
+			 * \param pattern The wildcard pattern.
+			 *
+			 * \returns The regular expression.
+			 **/
+			static QString wildcardToRegExp(QString pattern);
+
+		private:
+			/** \brief Internal data. **/
+			PlayableFileIndexPrivate* d;
+	};
+}
+
+#endif // PLAYABLE_FILE_INDEX_H
@@ -11,6 +11,9 @@
 #include "items/MediaItem.h"
 #include <QList>
 
+// for scraping off the GUI thread
+#include "ScrapedMetadata.h"
+
 namespace AWE {
 	/**
 	 * \brief Defines the general interface for a metadata scraper.
@@ -22,8 +25,10 @@ namespace AWE {
 	 * In order to scrape for metadata, AWEMC does the following:
 	 *	- Creates the scraper using a `MetadataScraperFactory` in
      *    a plugin.
-	 *	- Scrape for metadata using `scrapeDataForFile()`, multiple
-     *    times if necessary.
+	 *	- Scrape for metadata using `addMetadata()`, multiple
+     *    times if necessary. Reentrant scrapers are instead
+     *    given items with `scrape()` on a pool of worker
+     *    threads.
 	 *	- Deletes the scraper afterward to save memory.
 	 *
 	 * `MetadataScraper` implementations should be largely immutable,
@@ -126,6 +131,44 @@ namespace AWE {
 			 * \returns The media type name for the scraper.
              */
 			virtual QString getType() = 0;
+
+			/**
+			 * \brief Determines if `scrape()` may be called from
+			 *		  several threads at once.
+			 *
+			 * Scrapers that return `true` are used for batches
+			 * of items on a pool of worker threads.
+			 *
+			 * \returns `true` if `scrape()` is reentrant,
+			 *			`false` otherwise (the default).
+             */
+			virtual bool isReentrant() { return false; }
+
+			/**
+			 * \brief Retrieves metadata for a copy of a
+			 *		  metadata object.
+			 *
+			 * Unlike `addMetadata()`, this never touches the item
+			 * itself, so it can run on any thread. Everything that
+			 * is found is recorded in `metadata` and later applied
+			 * to the item with `ScrapedMetadata::applyTo()`.
+			 *
+			 * Only used when `isReentrant()` returns `true`.
+			 *
+			 * \param[inout] metadata The copy of the item, made
+			 *		  with `ScrapedMetadata::forItem()`.
+			 * \param[in] config Settings to determine scraping behaviour.
+			 *
+			 * \returns `true` if the scraper was able to get the metadata,
+			 *			`false` if it was not.
+             */
+			virtual bool scrape(ScrapedMetadata& metadata,
+				ScraperSettings config)
+			{
+				Q_UNUSED(metadata);
+				Q_UNUSED(config);
+				return false;
+			}
 	};
 }
 
@@ -50,6 +50,6 @@ namespace AWE {
 }
 
 // this makes it available to QPluginLoader
-Q_DECLARE_INTERFACE(AWE::MetadataScraperFactory, "com.awe.MetadataScraperFactory")
+Q_DECLARE_INTERFACE(AWE::MetadataScraperFactory, "com.awe.MetadataScraperFactory/2")
 
 #endif // METADATA_SCRAPER_FACTORY_H
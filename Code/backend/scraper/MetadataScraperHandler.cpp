@@ -8,17 +8,60 @@
 #include "MetadataScraperFactory.h"
 #include <QObject>
 
-// plugin class
-#include <QPluginLoader>
+// for loading the plugin
+#include "settings/PluginPool.h"
+
+// for what the plugin declares about itself
+#include "settings/PluginCache.h"
+#include <QJsonArray>
+
+// for scraping batches
+#include <QThreadPool>
+#include <QRunnable>
+#include <QVector>
+
+// for debug
+#include <QDebug>
 
 namespace AWE
 {
 	class MetadataScraperHandlerPrivate
 	{
 		public:
-			QPluginLoader plugin;
+			// the path to the plugin
+			QString plugin;
 			MetadataScraper* scraper;
 			bool prepared;
+
+			// the types the plugin says it works on, if it says
+			QList<QString> types;
+	};
+
+	/** \brief Scrapes one item of a batch. **/
+	class MetadataScraperJob : public QRunnable
+	{
+		public:
+			MetadataScraperJob(MetadataScraper* scraper,
+				ScrapedMetadata* metadata, bool* ok,
+				MetadataScraper::ScraperSettings flags)
+				:	scraper(scraper),
+					metadata(metadata),
+					ok(ok),
+					flags(flags)
+				{ }
+
+			void run()
+			{
+				*ok = scraper->scrape(*metadata, flags);
+				// downloaded here, so applying them is quick
+				metadata->fetchImages();
+			}
+
+		private:
+			MetadataScraper* scraper;
+			ScrapedMetadata* metadata;
+			bool* ok;
+			MetadataScraper::ScraperSettings flags;
 	};
 }
 
@@ -30,9 +73,33 @@ MetadataScraperHandler::MetadataScraperHandler(QString file)
 		d(new MetadataScraperHandlerPrivate)
 {
 	d->scraper = nullptr;
-	d->plugin.setFileName(getConfigFile()->getPathToConfigFile()
-		.absoluteFilePath(getLocation()));
+	d->plugin = getConfigFile()->getPathToConfigFile()
+		.absoluteFilePath(getLocation());
 	d->prepared = false;
+
+	// either a list of types, or "config" (or nothing)
+	// to use the type of the scraper itself
+	QJsonValue types = PluginCache::instance()
+		->getMetaData(d->plugin).value("types");
+	if (types.isArray())
+	{
+		for (auto type : types.toArray())
+		{
+			if (type.isString())
+			{
+				d->types << type.toString();
+			}
+		}
+	}
+	else if (types.toString() == "config")
+	{
+		// the type the scraper reads from its config file
+		JsonValue type = getConfigFile()->getMember({"metadata", "type"});
+		if (type.isString())
+		{
+			d->types << type.toString();
+		}
+	}
 }
 
 MetadataScraperHandler::~MetadataScraperHandler()
@@ -43,37 +110,31 @@ MetadataScraperHandler::~MetadataScraperHandler()
 
 bool MetadataScraperHandler::prepare()
 {
-	// try to load it
-	if (!d->plugin.load())
-	{
-		return false;
-	}
-	// get the factory
-	QObject* inst = d->plugin.instance();
+	// get the factory, which stays loaded for a while
+	QObject* inst = PluginPool::instance()->acquire(d->plugin);
 	if (!inst)
 	{
-		d->plugin.unload();
 		return false;
 	}
 	MetadataScraperFactory* factory 
 		= qobject_cast<MetadataScraperFactory*>(inst);
 	if (!factory)
 	{
-		d->plugin.unload();
+		PluginPool::instance()->release(d->plugin);
 		return false;
 	}
 	// get the scraper
 	d->scraper = factory->create(getConfigFile());
 	if (!d->scraper)
 	{
-		d->plugin.unload();
+		PluginPool::instance()->release(d->plugin);
 		return false;
 	}
 	if (!d->scraper->isValid())
 	{
 		delete d->scraper;
 		d->scraper = nullptr;
-		d->plugin.unload();
+		PluginPool::instance()->release(d->plugin);
 		return false;
 	}
 	d->prepared = true;
@@ -88,6 +149,86 @@ bool MetadataScraperHandler::addMetadata(MetadataHolder* item, MetadataScraper::
 	}
 	return d->scraper->addMetadata(item, flags);
 }
+int MetadataScraperHandler::addMetadata(QList<MetadataHolder*> items,
+	MetadataScraper::ScraperSettings flags, int threads)
+{
+	// loaded once for the whole batch
+	bool wasPrepared = isValid();
+	if (!wasPrepared && !prepare())
+	{
+		return 0;
+	}
+	int ans = 0;
+	if (d->scraper->isReentrant())
+	{
+		// copied here, since the items belong to this thread
+		QVector<ScrapedMetadata> results;
+		results.reserve(items.count());
+		for (auto item : items)
+		{
+			results << ScrapedMetadata::forItem(item);
+		}
+		QVector<bool> ok(items.count(), false);
+
+		QThreadPool pool;
+		if (threads > 0)
+		{
+			pool.setMaxThreadCount(threads);
+		}
+		for (int i = 0; i < items.count(); ++ i)
+		{
+			pool.start(new MetadataScraperJob(d->scraper,
+				results.data() + i, ok.data() + i, flags));
+		}
+		pool.waitForDone();
+
+		// every item is edited at the end, in one go
+		for (int i = 0; i < items.count(); ++ i)
+		{
+			results[i].applyTo(items[i]);
+			if (ok[i])
+			{
+				++ ans;
+			}
+		}
+	}
+	else
+	{
+		for (auto item : items)
+		{
+			if (d->scraper->addMetadata(item, flags))
+			{
+				++ ans;
+			}
+		}
+	}
+	if (ans != items.count())
+	{
+		qWarning() << "MetadataScraperHandler: Scraping failed for"
+			<< items.count() - ans << "of" << items.count() << "items";
+	}
+	if (!wasPrepared)
+	{
+		deactivate();
+	}
+	return ans;
+}
+
+bool MetadataScraperHandler::isReentrant() const
+{
+	return isValid() && d->scraper->isReentrant();
+}
+
+bool MetadataScraperHandler::scrape(ScrapedMetadata& metadata,
+	MetadataScraper::ScraperSettings flags) const
+{
+	if (!isValid())
+	{
+		return false;
+	}
+	return d->scraper->scrape(metadata, flags);
+}
+
 #if 0
 QList<MediaItem*> MetadataScraperHandler::makeMediaItems(Folder* placeInMe,
 	QString file, int flags)
@@ -107,7 +248,7 @@ void MetadataScraperHandler::deactivate()
 	}
 	delete d->scraper;
 	d->scraper = nullptr;
-	d->plugin.unload();
+	PluginPool::instance()->release(d->plugin);
 	d->prepared = false;
 }
 
@@ -118,5 +259,9 @@ bool MetadataScraperHandler::isValid() const
 
 bool MetadataScraperHandler::canBeUsedFor(MetadataHolder* item) const
 {
+	if (!d->types.isEmpty())
+	{
+		return d->types.contains(item->getType());
+	}
 	return getType() == item->getType();
 }
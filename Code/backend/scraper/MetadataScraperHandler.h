@@ -63,6 +63,57 @@ namespace AWE {
             virtual bool addMetadata(MetadataHolder* item,
                 MetadataScraper::ScraperSettings flags);
 
+			/**
+			 * \brief Retrieves metadata for many metadata objects.
+			 *
+			 * The scraper is prepared once for the whole batch
+			 * (and deactivated afterwards if it was not prepared
+			 * before). If the scraper is reentrant, up to `threads`
+			 * items are scraped at once on worker threads, and
+			 * the results are applied to the items on this thread
+			 * once every item is done. Otherwise, the items are
+			 * scraped one after another.
+			 *
+			 * This must be called on the GUI thread, and it does
+			 * not return until the whole batch is done.
+			 *
+			 * \param[inout] items The objects to get metadata for.
+			 * \param[in] flags Settings to determine scraping behaviour.
+			 * \param[in] threads The number of items to scrape at
+			 *			once, or 0 for one per core.
+			 *
+			 * \returns The number of items the scraper was able
+			 *			to get metadata for.
+             */
+            virtual int addMetadata(QList<MetadataHolder*> items,
+                MetadataScraper::ScraperSettings flags, int threads = 0);
+
+			/**
+			 * \brief Determine if `scrape()` may be called from
+			 *		  several threads at once.
+			 *
+			 * \returns `true` if the scraper is prepared and
+			 *			reentrant, `false` otherwise.
+             */
+			virtual bool isReentrant() const;
+
+			/**
+			 * \brief Retrieves metadata for a copy of a metadata
+			 *		  object, without touching the object.
+			 *
+			 * This may be called from any thread if `isReentrant()`
+			 * returns `true`. The scraper must stay prepared
+			 * until it returns.
+			 *
+			 * \param[inout] metadata The copy of the object.
+			 * \param[in] flags Settings to determine scraping behaviour.
+			 *
+			 * \returns `true` if the scraper was able to get the metadata,
+			 *			`false` if it was not.
+             */
+			virtual bool scrape(ScrapedMetadata& metadata,
+				MetadataScraper::ScraperSettings flags) const;
+
 			/**
 			 * \brief Create a media item (or multiple if applicable) from a
              *		  given file or folder.
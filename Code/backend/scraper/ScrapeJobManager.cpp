@@ -0,0 +1,405 @@
+// header file
+#include "ScrapeJobManager.h"
+
+// the scrapers and items
+#include "MetadataScraperHandler.h"
+#include "ScrapedMetadata.h"
+#include "settings/MetadataHolder.h"
+
+// for threading
+#include <QThreadPool>
+#include <QRunnable>
+#include <QAtomicInt>
+
+// for holding data
+#include <QHash>
+#include <QVector>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QElapsedTimer>
+#include <QCoreApplication>
+
+// for debug output
+#include <QDebug>
+
+namespace AWE
+{
+	/** \brief One queued or running job. **/
+	struct ScrapeJobData
+	{
+		int id;
+		MetadataScraperHandler* scraper;
+		MetadataScraper::ScraperSettings flags;
+		int priority;
+		bool reentrant;
+
+		// the items, which may be deleted while they wait
+		QList<QPointer<MetadataHolder> > items;
+		// filled in by the worker threads, one item each
+		QVector<ScrapedMetadata> results;
+		QVector<bool> ok;
+
+		QAtomicInt canceled;
+		// items handed to a pool that have not come back
+		int running;
+		// the next item to give to a scraper that is not reentrant
+		int next;
+
+		int done;
+		int succeeded;
+		QElapsedTimer timer;
+	};
+
+	using ScrapeJobPointer = QSharedPointer<ScrapeJobData>;
+
+	/** \brief Scrapes one item of a job on a worker thread. **/
+	class ScrapeJobRunnable : public QRunnable
+	{
+		public:
+			ScrapeJobRunnable(ScrapeJobManager* manager, ScrapeJobPointer job,
+				int index, ScrapedMetadata* metadata, bool* ok)
+				:	manager(manager),
+					job(job),
+					index(index),
+					metadata(metadata),
+					ok(ok)
+				{ }
+
+			void run()
+			{
+				if (!job->canceled.load())
+				{
+					*ok = job->scraper->scrape(*metadata, job->flags);
+					// downloaded here, so applying them is quick
+					metadata->fetchImages();
+				}
+				// applied on the GUI thread
+				QMetaObject::invokeMethod(manager, "itemDone",
+					Qt::QueuedConnection, Q_ARG(int, job->id),
+					Q_ARG(int, index));
+			}
+
+		private:
+			ScrapeJobManager* manager;
+			ScrapeJobPointer job;
+			int index;
+			ScrapedMetadata* metadata;
+			bool* ok;
+	};
+
+	class ScrapeJobManagerPrivate
+	{
+		public:
+			ScrapeJobManager* p;
+
+			// report that an item is done
+			void itemFinished(ScrapeJobPointer job, bool ok);
+			// forget a job once nothing is running for it
+			void finish(ScrapeJobPointer job);
+
+			QThreadPool pool;
+			QHash<int, ScrapeJobPointer> jobs;
+			int nextId;
+			// whether scrapeNextItem() is waiting to run
+			bool serialScheduled;
+
+			// scrapers in use, and which of them were
+			// prepared here and should be deactivated
+			QHash<MetadataScraperHandler*, int> scraperUsers;
+			QHash<MetadataScraperHandler*, bool> preparedHere;
+	};
+}
+
+using namespace AWE;
+
+ScrapeJobManager* ScrapeJobManager::instance()
+{
+	static ScrapeJobManager* manager = new ScrapeJobManager(QCoreApplication::instance());
+	return manager;
+}
+
+ScrapeJobManager::ScrapeJobManager(QObject* parent)
+	:	QObject(parent),
+		d(new ScrapeJobManagerPrivate)
+{
+	d->p = this;
+	d->nextId = 0;
+	d->serialScheduled = false;
+}
+
+ScrapeJobManager::~ScrapeJobManager()
+{
+	cancelAll();
+	delete d;
+}
+
+int ScrapeJobManager::enqueue(QList<MetadataHolder*> items,
+	MetadataScraperHandler* scraper, MetadataScraper::ScraperSettings flags,
+	Priority priority)
+{
+	if (items.isEmpty() || !scraper)
+	{
+		return -1;
+	}
+	// loaded once for every job that uses it
+	if (!d->scraperUsers.contains(scraper))
+	{
+		bool wasPrepared = scraper->isValid();
+		if (!wasPrepared && !scraper->prepare())
+		{
+			qWarning() << "ScrapeJobManager: Scraper" << scraper->getName()
+				<< "not valid.";
+			return -1;
+		}
+		d->scraperUsers[scraper] = 0;
+		d->preparedHere[scraper] = !wasPrepared;
+	}
+	++ d->scraperUsers[scraper];
+
+	ScrapeJobPointer job(new ScrapeJobData);
+	job->id = d->nextId ++;
+	job->scraper = scraper;
+	job->flags = flags;
+	job->priority = priority;
+	job->reentrant = scraper->isReentrant();
+	job->running = 0;
+	job->next = 0;
+	job->done = 0;
+	job->succeeded = 0;
+	for (auto item : items)
+	{
+		job->items << QPointer<MetadataHolder>(item);
+	}
+	d->jobs[job->id] = job;
+
+	// sent once the caller has had a chance to connect
+	QMetaObject::invokeMethod(this, "started", Qt::QueuedConnection,
+		Q_ARG(int, job->id));
+	job->timer.start();
+	if (!job->reentrant)
+	{
+		// like MetadataScraperHandler::addMetadata(), these use
+		// addMetadata() on this thread, one item per event so
+		// that the GUI keeps responding in between
+		if (!d->serialScheduled)
+		{
+			d->serialScheduled = true;
+			QMetaObject::invokeMethod(this, "scrapeNextItem",
+				Qt::QueuedConnection);
+		}
+		return job->id;
+	}
+	// copied here, since the items belong to this thread
+	job->results.reserve(items.count());
+	for (auto item : items)
+	{
+		job->results << ScrapedMetadata::forItem(item);
+	}
+	job->ok.fill(false, items.count());
+	ScrapedMetadata* results = job->results.data();
+	bool* ok = job->ok.data();
+	for (int i = 0; i < items.count(); ++ i)
+	{
+		++ job->running;
+		d->pool.start(new ScrapeJobRunnable(this, job, i,
+			results + i, ok + i), priority);
+	}
+	return job->id;
+}
+
+bool ScrapeJobManager::cancel(int job)
+{
+	ScrapeJobPointer data = d->jobs.value(job);
+	if (!data || data->canceled.load())
+	{
+		return false;
+	}
+	data->canceled.store(1);
+	emit canceled(job);
+	d->finish(data);
+	return true;
+}
+
+void ScrapeJobManager::cancelAll()
+{
+	for (auto job : d->jobs.keys())
+	{
+		cancel(job);
+	}
+	// everything left only has items running
+	d->pool.waitForDone();
+	for (auto job : d->jobs.values())
+	{
+		// nothing is applied any more, and what was
+		// applied already was cleared
+		for (auto& result : job->results)
+		{
+			result.discardImages();
+		}
+		job->running = 0;
+		d->finish(job);
+	}
+}
+
+bool ScrapeJobManager::isActive(int job) const
+{
+	ScrapeJobPointer data = d->jobs.value(job);
+	return data && !data->canceled.load();
+}
+
+int ScrapeJobManager::findJob(MetadataHolder* item) const
+{
+	int ans = -1;
+	for (auto job : d->jobs)
+	{
+		if (job->id > ans && !job->canceled.load()
+			&& job->items.contains(QPointer<MetadataHolder>(item)))
+		{
+			ans = job->id;
+		}
+	}
+	return ans;
+}
+
+int ScrapeJobManager::getDone(int job) const
+{
+	ScrapeJobPointer data = d->jobs.value(job);
+	return data ? data->done : -1;
+}
+
+int ScrapeJobManager::getTotal(int job) const
+{
+	ScrapeJobPointer data = d->jobs.value(job);
+	return data ? data->items.count() : -1;
+}
+
+qint64 ScrapeJobManager::getTimeLeft(int job) const
+{
+	ScrapeJobPointer data = d->jobs.value(job);
+	if (!data || data->done == 0)
+	{
+		return -1;
+	}
+	return data->timer.elapsed() * (data->items.count() - data->done)
+		/ data->done;
+}
+
+int ScrapeJobManager::numActive() const
+{
+	int ans = 0;
+	for (auto job : d->jobs)
+	{
+		if (!job->canceled.load())
+		{
+			++ ans;
+		}
+	}
+	return ans;
+}
+
+void ScrapeJobManager::setMaxThreads(int threads)
+{
+	d->pool.setMaxThreadCount(threads);
+}
+
+int ScrapeJobManager::getMaxThreads() const
+{
+	return d->pool.maxThreadCount();
+}
+
+void ScrapeJobManager::itemDone(int job, int index)
+{
+	ScrapeJobPointer data = d->jobs.value(job);
+	if (!data)
+	{
+		return;
+	}
+	-- data->running;
+	if (data->canceled.load())
+	{
+		data->results[index].discardImages();
+		d->finish(data);
+		return;
+	}
+	MetadataHolder* item = data->items[index];
+	bool ok = item && data->ok[index];
+	if (item)
+	{
+		data->results[index].applyTo(item);
+	}
+	else
+	{
+		data->results[index].discardImages();
+	}
+	// the copy is not needed any more
+	data->results[index] = ScrapedMetadata();
+	d->itemFinished(data, ok);
+}
+
+void ScrapeJobManager::scrapeNextItem()
+{
+	d->serialScheduled = false;
+	// the highest priority job, and the oldest of those
+	ScrapeJobPointer job;
+	for (auto data : d->jobs)
+	{
+		if (data->reentrant || data->canceled.load()
+			|| data->next >= data->items.count())
+		{
+			continue;
+		}
+		if (!job || data->priority > job->priority
+			|| (data->priority == job->priority && data->id < job->id))
+		{
+			job = data;
+		}
+	}
+	if (!job)
+	{
+		return;
+	}
+	// the scraper may ask the user, so nothing else is started
+	// while it runs, not even from new jobs
+	d->serialScheduled = true;
+	MetadataHolder* item = job->items[job->next ++];
+	bool ok = item && job->scraper->addMetadata(item, job->flags);
+	QMetaObject::invokeMethod(this, "scrapeNextItem", Qt::QueuedConnection);
+	d->itemFinished(job, ok);
+}
+
+void ScrapeJobManagerPrivate::itemFinished(ScrapeJobPointer job, bool ok)
+{
+	++ job->done;
+	if (ok)
+	{
+		++ job->succeeded;
+	}
+	int total = job->items.count();
+	emit p->progress(job->id, job->done, total, p->getTimeLeft(job->id));
+	if (job->done == total)
+	{
+		emit p->finished(job->id, job->succeeded, total);
+		finish(job);
+	}
+}
+
+void ScrapeJobManagerPrivate::finish(ScrapeJobPointer job)
+{
+	bool over = job->canceled.load() || job->done == job->items.count();
+	if (!over || job->running > 0 || !jobs.contains(job->id))
+	{
+		return;
+	}
+	jobs.remove(job->id);
+	// the scraper is deactivated once no job needs it
+	MetadataScraperHandler* scraper = job->scraper;
+	if (-- scraperUsers[scraper] == 0)
+	{
+		scraperUsers.remove(scraper);
+		if (preparedHere.take(scraper))
+		{
+			scraper->deactivate();
+		}
+	}
+}
+
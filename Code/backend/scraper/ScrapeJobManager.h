@@ -0,0 +1,250 @@
+#ifndef SCRAPE_JOB_MANAGER_H
+#define SCRAPE_JOB_MANAGER_H
+
+// library macro
+#include "macros/BackendLibraryMacros.h"
+
+// superclass
+#include <QObject>
+
+// for the jobs
+#include <QList>
+#include "MetadataScraper.h"
+
+namespace AWE {
+	// forward declarations
+	class MetadataHolder;
+	class MetadataScraperHandler;
+	// internal data
+	class ScrapeJobManagerPrivate;
+
+	/**
+	 * \brief Runs scrape jobs in the background.
+	 *
+	 * A job is a list of items to scrape with one scraper.
+	 * Jobs are queued with `enqueue()`, which returns right
+	 * away, and the manager reports on them with signals.
+	 *
+	 * Items of reentrant scrapers (see
+	 * `MetadataScraper::isReentrant()`) are scraped with
+	 * `MetadataScraper::scrape()` on a pool of worker threads,
+	 * higher priority jobs first, along with any images they
+	 * import, and only what was found is applied to each item
+	 * on the GUI thread as soon as it is done. The other
+	 * scrapers are given one item at a time with
+	 * `MetadataScraper::addMetadata()` on the GUI thread,
+	 * returning to the event loop between items.
+	 *
+	 * There is only one manager, obtained through
+	 * `ScrapeJobManager::instance()`. It must be used from
+	 * the GUI thread.
+     */
+	class AWEMC_BACKEND_LIBRARY ScrapeJobManager : public QObject
+	{
+		Q_OBJECT
+
+		public:
+			/**
+			 * \brief How urgent a job is.
+             */
+			enum Priority
+			{
+				/** \brief Work that nobody is waiting for. **/
+				Low = 0,
+				/** \brief The default. **/
+				Normal = 1,
+				/** \brief Work that the user asked for. **/
+				High = 2
+			};
+
+			/**
+			 * \brief Get the manager.
+			 *
+			 * \returns The manager.
+             */
+			static ScrapeJobManager* instance();
+
+			/**
+			 * \brief Destroy this object, canceling every job
+			 *			and waiting for running items.
+             */
+			virtual ~ScrapeJobManager();
+
+			/**
+			 * \brief Queue a job.
+			 *
+			 * \param items The items to scrape.
+			 * \param scraper The scraper to use.
+			 * \param flags The settings to use while scraping.
+			 * \param priority How urgent the job is.
+			 *
+			 * \returns The ID of the job, or -1 if it
+			 *			could not be queued.
+             */
+			virtual int enqueue(QList<MetadataHolder*> items,
+				MetadataScraperHandler* scraper,
+				MetadataScraper::ScraperSettings flags,
+				Priority priority = Normal);
+
+			/**
+			 * \brief Cancel a job.
+			 *
+			 * Items that are already being scraped are finished,
+			 * but nothing more is applied to the items.
+			 *
+			 * \param job The ID of the job.
+			 *
+			 * \returns `true` if the job was canceled, `false`
+			 *			if there is no such job.
+             */
+			virtual bool cancel(int job);
+
+			/**
+			 * \brief Cancel every job.
+             */
+			virtual void cancelAll();
+
+			/**
+			 * \brief Determine if a job is queued or running.
+			 *
+			 * \param job The ID of the job.
+			 *
+			 * \returns `true` if the job is not done yet,
+			 *			`false` otherwise.
+             */
+			virtual bool isActive(int job) const;
+
+			/**
+			 * \brief Find the job that is scraping an item.
+			 *
+			 * \param item The item.
+			 *
+			 * \returns The ID of the newest active job that
+			 *			includes `item`, or -1 if there is none.
+             */
+			virtual int findJob(MetadataHolder* item) const;
+
+			/**
+			 * \brief Get the number of items of a job that are done.
+			 *
+			 * \param job The ID of the job.
+			 *
+			 * \returns The number of items done, or -1
+			 *			if there is no such job.
+             */
+			virtual int getDone(int job) const;
+
+			/**
+			 * \brief Get the number of items in a job.
+			 *
+			 * \param job The ID of the job.
+			 *
+			 * \returns The number of items, or -1
+			 *			if there is no such job.
+             */
+			virtual int getTotal(int job) const;
+
+			/**
+			 * \brief Estimate how long a job will take to finish.
+			 *
+			 * The estimate is based on how long the items that
+			 * are done took.
+			 *
+			 * \param job The ID of the job.
+			 *
+			 * \returns The time left in milliseconds, or -1
+			 *			if it is not known yet.
+             */
+			virtual qint64 getTimeLeft(int job) const;
+
+			/**
+			 * \brief Get the number of jobs that are not done.
+			 *
+			 * \returns The number of active jobs.
+             */
+			virtual int numActive() const;
+
+			/**
+			 * \brief Set how many items of reentrant scrapers
+			 *			are scraped at once.
+			 *
+			 * \param threads The number of worker threads.
+             */
+			virtual void setMaxThreads(int threads);
+
+			/**
+			 * \brief Get how many items are scraped at once.
+			 *
+			 * By default, this is one per core.
+			 *
+			 * \returns The number of worker threads.
+             */
+			virtual int getMaxThreads() const;
+
+		signals:
+			/**
+			 * \brief Sent when the first item of a job starts.
+			 *
+			 * \param job The ID of the job.
+             */
+			void started(int job);
+
+			/**
+			 * \brief Sent whenever an item of a job is done.
+			 *
+			 * \param job The ID of the job.
+			 * \param done The number of items done.
+			 * \param total The number of items in the job.
+			 * \param msecLeft The estimated time left, see
+			 *			`getTimeLeft()`.
+             */
+			void progress(int job, int done, int total, qint64 msecLeft);
+
+			/**
+			 * \brief Sent when every item of a job is done.
+			 *
+			 * \param job The ID of the job.
+			 * \param succeeded The number of items that the
+			 *			scraper got metadata for.
+			 * \param total The number of items in the job.
+             */
+			void finished(int job, int succeeded, int total);
+
+			/**
+			 * \brief Sent when a job is canceled.
+			 *
+			 * \param job The ID of the job.
+             */
+			void canceled(int job);
+
+		private slots:
+			/**
+			 * \brief Apply what was found for an item.
+			 *
+			 * \param job The ID of the job.
+			 * \param index The index of the item in the job.
+             */
+			void itemDone(int job, int index);
+
+			/**
+			 * \brief Scrape the next item of the jobs whose
+			 *		  scrapers are not reentrant.
+             */
+			void scrapeNextItem();
+
+		private:
+			friend class ScrapeJobManagerPrivate;
+
+			/**
+			 * \brief Make the manager.
+			 *
+			 * \param parent The parent object.
+             */
+			ScrapeJobManager(QObject* parent);
+
+			/** \brief Internal data. **/
+			ScrapeJobManagerPrivate* d;
+	};
+}
+
+#endif // SCRAPE_JOB_MANAGER_H
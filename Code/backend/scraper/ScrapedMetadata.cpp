@@ -0,0 +1,230 @@
+// header file
+#include "ScrapedMetadata.h"
+
+// the items that are scraped
+#include "settings/MetadataHolder.h"
+
+// for fetching images
+#include <QFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QUrl>
+#include <QImageReader>
+#include "settings/FileInfoCache.h"
+#include "libs/generic_file_reader/file_reader.h"
+
+// for debug output
+#include <QDebug>
+
+using namespace AWE;
+using namespace JSON;
+
+/** \brief Determine if an image file is on the web. **/
+static bool isRemote(QString file)
+{
+	QUrl url(file);
+	return url.isValid() && !url.isRelative();
+}
+
+ScrapedMetadata::ScrapedMetadata()
+	:	nameFound(false),
+		descriptionFound(false)
+{ }
+
+ScrapedMetadata ScrapedMetadata::forItem(MetadataHolder* item)
+{
+	ScrapedMetadata ans;
+	if (!item)
+	{
+		return ans;
+	}
+	ans.location = item->getLocation();
+	ans.name = item->getName();
+	ans.type = item->getType();
+	ans.importPath = item->getImportPath();
+	for (int i = 0; i < item->numDetails(); ++ i)
+	{
+		ans.details[item->getDetailName(i)] = item->getDetailValue(i);
+	}
+	return ans;
+}
+
+QString ScrapedMetadata::getLocation() const
+{
+	return location;
+}
+
+QString ScrapedMetadata::getName() const
+{
+	return name;
+}
+
+QString ScrapedMetadata::getType() const
+{
+	return type;
+}
+
+JsonValue ScrapedMetadata::getDetailValue(QString name) const
+{
+	return details.value(name, JsonValue(JsonValue::Null));
+}
+
+bool ScrapedMetadata::isEmpty() const
+{
+	return !nameFound && !descriptionFound && newDetails.isEmpty()
+		&& newIcons.isEmpty() && newFanarts.isEmpty()
+		&& fetchedIcons.isEmpty() && fetchedFanarts.isEmpty();
+}
+
+void ScrapedMetadata::setName(QString name)
+{
+	this->name = name;
+	nameFound = true;
+}
+
+void ScrapedMetadata::setDescription(QString description)
+{
+	this->description = description;
+	descriptionFound = true;
+}
+
+void ScrapedMetadata::addDetail(QString name, JsonValue value)
+{
+	details[name] = value;
+	newDetails << qMakePair(name, value);
+}
+
+void ScrapedMetadata::addIcon(QString file, bool import)
+{
+	newIcons << qMakePair(file, import);
+}
+
+void ScrapedMetadata::addFanart(QString file, bool import)
+{
+	newFanarts << qMakePair(file, import);
+}
+
+bool ScrapedMetadata::fetchImages()
+{
+	bool ans = fetchImages("icon", newIcons, fetchedIcons);
+	return fetchImages("fanart", newFanarts, fetchedFanarts) && ans;
+}
+
+void ScrapedMetadata::discardImages()
+{
+	for (auto file : fetchedIcons + fetchedFanarts)
+	{
+		QDir::root().remove(file);
+		FileInfoCache::instance()->invalidate(file);
+	}
+	fetchedIcons.clear();
+	fetchedFanarts.clear();
+}
+
+void ScrapedMetadata::applyTo(MetadataHolder* item) const
+{
+	if (!item || isEmpty())
+	{
+		return;
+	}
+	item->beginTransaction();
+	if (nameFound)
+	{
+		item->setName(name);
+	}
+	if (descriptionFound)
+	{
+		item->setDescription(description);
+	}
+	for (auto detail : newDetails)
+	{
+		item->addDetail(detail.first, detail.second);
+	}
+	// whatever is left in these is only linked to
+	for (auto icon : newIcons)
+	{
+		if (!icon.second && !isRemote(icon.first))
+		{
+			item->addIcon(icon.first);
+		}
+		else
+		{
+			qWarning() << "ScrapedMetadata: Icon" << icon.first
+				<< "was not fetched";
+		}
+	}
+	for (auto file : fetchedIcons)
+	{
+		item->adoptIcon(file);
+	}
+	for (auto fanart : newFanarts)
+	{
+		if (!fanart.second && !isRemote(fanart.first))
+		{
+			item->addFanart(fanart.first);
+		}
+		else
+		{
+			qWarning() << "ScrapedMetadata: Fanart" << fanart.first
+				<< "was not fetched";
+		}
+	}
+	for (auto file : fetchedFanarts)
+	{
+		item->adoptFanart(file);
+	}
+	item->commitTransaction();
+}
+
+bool ScrapedMetadata::fetchImages(QString kind,
+	QList<QPair<QString, bool> >& images, QStringList& fetched)
+{
+	bool ans = true;
+	QList<QPair<QString, bool> > linked;
+	for (auto image : images)
+	{
+		// files on the web are always imported, like
+		// MetadataHolder::addIcon() does
+		if (!image.second && !isRemote(image.first))
+		{
+			linked << image;
+			continue;
+		}
+		if (importPath.isEmpty())
+		{
+			ans = false;
+			continue;
+		}
+		QString extension;
+		int ind = image.first.lastIndexOf('.');
+		if (ind != -1)
+		{
+			extension = image.first.mid(ind);
+		}
+		// a new name every time, so a file that is still
+		// in use is never rewritten in place
+		QString file;
+		for (int i = 0; file.isEmpty() || QFileInfo::exists(file); ++ i)
+		{
+			file = importPath + '.' + kind + '.' + QString::number(i)
+				+ extension;
+		}
+		QFile writeToMe(file);
+		bool copied = writeToMe.open(QIODevice::WriteOnly)
+			&& copyFile(image.first, writeToMe);
+		writeToMe.close();
+		if (copied && QImageReader(file).canRead())
+		{
+			fetched << file;
+		}
+		else
+		{
+			qWarning() << "ScrapedMetadata: Could not fetch" << image.first;
+			QDir::root().remove(file);
+			ans = false;
+		}
+		FileInfoCache::instance()->invalidate(file);
+	}
+	images = linked;
+	return ans;
+}
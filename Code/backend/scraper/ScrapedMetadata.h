@@ -0,0 +1,193 @@
+#ifndef SCRAPED_METADATA_H
+#define SCRAPED_METADATA_H
+
+// library macro
+#include "macros/BackendLibraryMacros.h"
+
+// for holding data
+#include <QList>
+#include <QHash>
+#include <QPair>
+#include <QString>
+#include <QStringList>
+#include <JsonDataTree/Json.h>
+
+namespace AWE {
+	// forward declarations
+	class MetadataHolder;
+
+	/**
+	 * \brief What a scraper found for one item, kept apart
+	 *			from the item itself.
+	 *
+	 * `MetadataHolder`s belong to the GUI thread, so scrapers
+	 * that run on worker threads cannot edit them directly.
+	 * Instead, a copy of what the scraper needs to know about
+	 * the item (its location, name, type and details) is made
+	 * with `forItem()` on the GUI thread, the scraper records
+	 * its findings here, `fetchImages()` downloads the images
+	 * that are imported while still on the worker thread, and
+	 * `applyTo()` makes all of the edits on the GUI thread
+	 * afterwards, as a single transaction.
+     */
+	class AWEMC_BACKEND_LIBRARY ScrapedMetadata
+	{
+		public:
+			/**
+			 * \brief Make an empty object for no item.
+             */
+			ScrapedMetadata();
+
+			/**
+			 * \brief Copy what a scraper needs to know
+			 *			about an item.
+			 *
+			 * This must be called on the GUI thread.
+			 *
+			 * \param item The item that will be scraped.
+			 *
+			 * \returns The copy, with nothing found yet.
+             */
+			static ScrapedMetadata forItem(MetadataHolder* item);
+
+			/**
+			 * \brief Get the location of the item.
+			 *
+			 * \returns The location of the item.
+             */
+			QString getLocation() const;
+
+			/**
+			 * \brief Get the name of the item, including
+			 *			any name found so far.
+			 *
+			 * \returns The name of the item.
+             */
+			QString getName() const;
+
+			/**
+			 * \brief Get the type of the item.
+			 *
+			 * \returns The type of the item.
+             */
+			QString getType() const;
+
+			/**
+			 * \brief Get the value of a detail, including
+			 *			any value found so far.
+			 *
+			 * \param name The name of the detail.
+			 *
+			 * \returns The value, or null if there is none.
+             */
+			JSON::JsonValue getDetailValue(QString name) const;
+
+			/**
+			 * \brief Determine if nothing has been found.
+			 *
+			 * \returns `true` if applying this would not change
+			 *			the item, `false` otherwise.
+             */
+			bool isEmpty() const;
+
+			/**
+			 * \brief Record a new name for the item.
+			 *
+			 * \param name The new name.
+             */
+			void setName(QString name);
+
+			/**
+			 * \brief Record a new description for the item.
+			 *
+			 * \param description The new description.
+             */
+			void setDescription(QString description);
+
+			/**
+			 * \brief Record a detail to add to the item.
+			 *
+			 * \param name The name of the detail.
+			 * \param value The value of the detail.
+             */
+			void addDetail(QString name, JSON::JsonValue value);
+
+			/**
+			 * \brief Record an icon to add to the item.
+			 *
+			 * \param file The image file.
+			 * \param import `true` to copy the image next to the
+			 *			item with `fetchImages()`, `false` to only
+			 *			link to it (unless it is on the web).
+             */
+			void addIcon(QString file, bool import);
+
+			/**
+			 * \brief Record a fanart image to add to the item.
+			 *
+			 * \param file The image file.
+			 * \param import `true` to copy the image next to the
+			 *			item with `fetchImages()`, `false` to only
+			 *			link to it (unless it is on the web).
+             */
+			void addFanart(QString file, bool import);
+
+			/**
+			 * \brief Copy every image that is imported next to
+			 *			the item's configuration file.
+			 *
+			 * This is where images are downloaded, so it may
+			 * block for a long time, and should be called on the
+			 * worker thread once scraping is done. Images that
+			 * could not be fetched, or are not images, are dropped.
+			 *
+			 * \returns `true` if every image was fetched,
+			 *			`false` otherwise.
+             */
+			bool fetchImages();
+
+			/**
+			 * \brief Delete the images copied by `fetchImages()`,
+			 *			for when they will never be applied.
+             */
+			void discardImages();
+
+			/**
+			 * \brief Make every recorded edit to an item,
+			 *			in one transaction.
+			 *
+			 * This must be called on the GUI thread. It only
+			 * records local files, so images that are imported
+			 * have to be copied with `fetchImages()` first, and
+			 * are skipped otherwise.
+			 *
+			 * \param item The item to edit.
+             */
+			void applyTo(MetadataHolder* item) const;
+
+		private:
+			// copy the images of one kind that are imported
+			bool fetchImages(QString kind,
+				QList<QPair<QString, bool> >& images, QStringList& fetched);
+
+			// what the item held when it was copied
+			QString location;
+			QString name;
+			QString type;
+			QHash<QString, JSON::JsonValue> details;
+			QString importPath;
+
+			// what was found, in the order it was found
+			bool nameFound;
+			bool descriptionFound;
+			QString description;
+			QList<QPair<QString, JSON::JsonValue> > newDetails;
+			QList<QPair<QString, bool> > newIcons;
+			QList<QPair<QString, bool> > newFanarts;
+			// images already copied next to the item
+			QStringList fetchedIcons;
+			QStringList fetchedFanarts;
+	};
+}
+
+#endif // SCRAPED_METADATA_H
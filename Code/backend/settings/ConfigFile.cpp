@@ -1,6 +1,12 @@
 // header file
 #include "ConfigFile.h"
 
+// for reading and parsing
+#include "ConfigPreloader.h"
+
+// for writing in the background
+#include "ConfigWriter.h"
+
 // debug
 #include <QtDebug>
 
@@ -11,11 +17,20 @@ namespace AWE
 	class ConfigFilePrivate
 	{
 		public:
+			ConfigFile* p;
+
+			// say that the data changed, or remember to
+			// say so when the transaction is committed
+			void changed();
+
 			JsonValue data;
 			QString configFileName;
 			QDir configFilePath;
 			bool edited;
 			bool valid;
+
+			int transactionDepth;
+			bool changedInTransaction;
 	};
 }
 
@@ -24,6 +39,9 @@ using namespace AWE;
 ConfigFile::ConfigFile()
 	:	d(new ConfigFilePrivate)
 {
+	d->p = this;
+	d->transactionDepth = 0;
+	d->changedInTransaction = false;
 	d->edited = false;
 	d->valid = false;
 }
@@ -31,6 +49,9 @@ ConfigFile::ConfigFile()
 ConfigFile::ConfigFile(QString file)
 	:	d(new ConfigFilePrivate)
 {
+	d->p = this;
+	d->transactionDepth = 0;
+	d->changedInTransaction = false;
 	// get the file
 	d->configFilePath = file;
 	d->configFileName = d->configFilePath.dirName();
@@ -40,23 +61,24 @@ ConfigFile::ConfigFile(QString file)
 	d->edited = false;
 	d->valid = true;
 
-	// read it in
-	QFile f(file);
-	if (f.open(QFile::ReadOnly))
+	// it may have been read on a worker thread already; if
+	// not, read it (or take it from the snapshot) now
+	PreloadedConfig config;
+	if (!ConfigPreloader::instance()->take(file, &config))
 	{
-		// put it in the data
-		JsonReader reader;
-		JsonReaderErrors errors;
-		d->data = reader.read(&f, &errors);
-		if (errors.numErrors())
+		config = ConfigPreloader::load(file);
+	}
+	d->data = config.data;
+	if (config.exists)
+	{
+		if (!config.valid)
 		{
 			qWarning() << "ConfigFile: File" << file << "had errors:";
 			d->valid = false;
-			for (auto err : errors)
+			for (auto err : config.errors)
 			{
-				qWarning() << "\t" << err.message();
+				qWarning() << "\t" << err;
 			}
-			return;
 		}
 	}
 	else
@@ -70,10 +92,12 @@ ConfigFile::ConfigFile(QString file)
 
 ConfigFile::~ConfigFile()
 {
-	// write to file if necessary
+	// write to file if necessary, without waiting for it
+	ConfigWriter::instance()->cancel(this);
 	if (hasBeenEdited())
 	{
-		writeToFile();
+		ConfigWriter::instance()->write(getPathToConfigFile()
+			.absoluteFilePath(getConfigFileName()), d->data);
 	}
 	delete d;
 }
@@ -104,9 +128,15 @@ void ConfigFile::markAsEdited()
 	if (!getConfigFileName().isNull())
 	{
 		d->edited = true;
+		ConfigWriter::instance()->schedule(this);
 	}
 }
 
+void ConfigFile::markAsWritten()
+{
+	d->edited = false;
+}
+
 void ConfigFile::writeToFile()
 {
 	if (getConfigFileName().isNull())
@@ -114,21 +144,43 @@ void ConfigFile::writeToFile()
 		// we don't want to write to nonexistant files
 		return;
 	}
-	JsonWriter writer(d->data);
+	ConfigWriter* writer = ConfigWriter::instance();
+	writer->cancel(this);
 	QString file = getPathToConfigFile()
 		.absoluteFilePath(getConfigFileName());
-	QFile outputFile(file);
-	if (outputFile.open(QFile::WriteOnly))
+	// through the writer, so an older queued write
+	// never lands on top of this one
+	if (writer->writeAndWait(file, d->data))
 	{
-		writer.writeTo(&outputFile);
+		markAsWritten();
 	}
-	else
+}
+
+void ConfigFile::beginTransaction()
+{
+	++ d->transactionDepth;
+}
+
+void ConfigFile::commitTransaction()
+{
+	if (d->transactionDepth <= 0)
 	{
-		qWarning() << "ConfigFile: Could not write to file"
-			<< file;
+		qWarning() << "ConfigFile: Tried to commit without a transaction";
+		return;
+	}
+	-- d->transactionDepth;
+	if (!d->transactionDepth && d->changedInTransaction)
+	{
+		d->changedInTransaction = false;
+		emit dataChanged();
 	}
 }
 
+bool ConfigFile::isInTransaction() const
+{
+	return d->transactionDepth > 0;
+}
+
 JsonValue ConfigFile::getData() const
 {
 	return d->data;
@@ -138,7 +190,7 @@ void ConfigFile::setData(JsonValue data)
 {
 	d->data = data;
 	markAsEdited();
-	emit dataChanged();
+	d->changed();
 }
 
 bool ConfigFile::hasMember(JsonPath path) const
@@ -161,7 +213,7 @@ bool ConfigFile::setMember(JsonPath path, JsonValue value)
 	{
 		toSet->operator= (value);
 		markAsEdited();
-		emit dataChanged();
+		d->changed();
 		return true;
 	}
 	return false;
@@ -181,7 +233,7 @@ bool ConfigFile::appendValueToMember(JsonPath path, JsonValue value)
 		{
 			toEdit->toArray().append(value);
 			markAsEdited();
-			emit dataChanged();
+			d->changed();
 			return true;
 		}
 	}
@@ -202,7 +254,7 @@ bool ConfigFile::appendValueToMember(JsonPath path, QString key, JsonValue value
 		{
 			toEdit->toObject()[key] = value;
 			markAsEdited();
-			emit dataChanged();
+			d->changed();
 			return true;
 		}
 	}
@@ -226,7 +278,7 @@ bool ConfigFile::removeMember(JsonPath path)
 			if (toEdit->toObject().remove(key.toObjectKey()))
 			{
 				markAsEdited();
-				emit dataChanged();
+				d->changed();
 				return true;
 			}
 		}
@@ -237,7 +289,7 @@ bool ConfigFile::removeMember(JsonPath path)
 			{
 				toEdit->toArray().removeAt(ind);
 				markAsEdited();
-				emit dataChanged();
+				d->changed();
 				return true;
 			}
 		}
@@ -260,4 +312,16 @@ bool ConfigFile::addMember(JsonPath path, JsonValue value)
 		markAsEdited();
 	}
 	return ok;
-}
\ No newline at end of file
+}
+
+void ConfigFilePrivate::changed()
+{
+	if (transactionDepth)
+	{
+		changedInTransaction = true;
+	}
+	else
+	{
+		emit p->dataChanged();
+	}
+}
@@ -68,6 +68,13 @@ namespace AWE {
 			/**
 			 * \brief Open the given config file.
 			 *
+			 * If the file has not changed since it was
+			 * last recorded in the `LibrarySnapshot`, its
+			 * contents come from there and the file itself
+			 * is not read. If the `ConfigPreloader` has
+			 * already read the file, its contents are
+			 * taken from there.
+			 *
 			 * \param[in] file The file to open. If
              *			  the file does not exist,
              *			  the config data will be
@@ -123,15 +130,45 @@ namespace AWE {
 			/**
 			 * \brief Mark this config file as edited,
              * 		  so that the data is written to
-             *		  file upon deletion.
+             *		  file by the `ConfigWriter`.
              */
 			virtual void markAsEdited();
 
 			/**
-			 * \brief Write the data to file.
+			 * \brief Write the data to file right away,
+             *		  on the calling thread.
+			 *
+			 * The file is replaced atomically.
              */
 			virtual void writeToFile();
 
+			/**
+			 * \brief Start a batch of edits.
+			 *
+			 * Until the matching `commitTransaction()`,
+			 * edits do not send `dataChanged()`. Transactions
+			 * can be nested; only the outermost one counts.
+             */
+			virtual void beginTransaction();
+
+			/**
+			 * \brief Finish a batch of edits.
+			 *
+			 * If this ends the outermost transaction and
+			 * anything was changed during it, `dataChanged()`
+			 * is sent once.
+             */
+			virtual void commitTransaction();
+
+			/**
+			 * \brief Determine if a batch of edits is
+             *		  in progress.
+			 *
+			 * \returns `true` if there is an open transaction,
+			 *			`false` otherwise.
+             */
+			virtual bool isInTransaction() const;
+
 			/**
 			 * \brief Get the data held in this config
              *		  file.
@@ -278,10 +315,22 @@ namespace AWE {
 		signals:
 			/**
 			 * \brief Sent when any data member is changed.
+			 *
+			 * During a transaction, this is sent once
+			 * when it is committed.
              */
 			void dataChanged();
 
 		private:
+			friend class ConfigWriter;
+
+			/**
+			 * \brief Mark this config file as written, so
+             *		  that it is not written again until it
+             *		  is edited.
+             */
+			void markAsWritten();
+
 			// implicitly deleted copy constructor
 			ConfigFile(const ConfigFile&) { }
 
@@ -0,0 +1,180 @@
+// header file
+#include "ConfigPreloader.h"
+
+// for skipping unchanged files
+#include "LibrarySnapshot.h"
+
+// for keys
+#include "FileInfoCache.h"
+
+// for reading
+#include <QFile>
+#include <QFileInfo>
+#include <QDateTime>
+
+// for threading
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+
+// for holding data
+#include <QHash>
+
+using namespace JSON;
+
+namespace AWE
+{
+	/** \brief A file that is being (or has been) read. **/
+	struct PreloaderEntry
+	{
+		bool done;
+		PreloadedConfig config;
+	};
+
+	class ConfigPreloaderPrivate
+	{
+		public:
+			QThreadPool pool;
+
+			mutable QMutex mutex;
+			QWaitCondition finished;
+			QHash<QString, PreloaderEntry> entries;
+	};
+
+	/** \brief Reads one file on a worker thread. **/
+	class ConfigPreloaderJob : public QRunnable
+	{
+		public:
+			ConfigPreloaderJob(ConfigPreloaderPrivate* d, QString file)
+				:	d(d),
+					file(file)
+				{ }
+
+			void run()
+			{
+				PreloadedConfig config = ConfigPreloader::load(file);
+				QMutexLocker lock(&d->mutex);
+				auto i = d->entries.find(file);
+				if (i != d->entries.end())
+				{
+					i->config = config;
+					i->done = true;
+				}
+				d->finished.wakeAll();
+			}
+
+		private:
+			ConfigPreloaderPrivate* d;
+			QString file;
+	};
+}
+
+using namespace AWE;
+
+ConfigPreloader* ConfigPreloader::instance()
+{
+	static ConfigPreloader preloader;
+	return &preloader;
+}
+
+ConfigPreloader::ConfigPreloader()
+	:	d(new ConfigPreloaderPrivate)
+	{ }
+
+ConfigPreloader::~ConfigPreloader()
+{
+	d->pool.waitForDone();
+	delete d;
+}
+
+void ConfigPreloader::preload(QList<QString> files)
+{
+	QMutexLocker lock(&d->mutex);
+	for (auto file : files)
+	{
+		QString key = FileInfoCache::resolve(file);
+		if (!d->entries.contains(key))
+		{
+			PreloaderEntry entry;
+			entry.done = false;
+			d->entries[key] = entry;
+			d->pool.start(new ConfigPreloaderJob(d, key));
+		}
+	}
+}
+
+bool ConfigPreloader::take(QString file, PreloadedConfig* config)
+{
+	QString key = FileInfoCache::resolve(file);
+	QMutexLocker lock(&d->mutex);
+	if (!d->entries.contains(key))
+	{
+		return false;
+	}
+	while (!d->entries[key].done)
+	{
+		d->finished.wait(&d->mutex);
+	}
+	*config = d->entries.take(key).config;
+	return true;
+}
+
+void ConfigPreloader::clear()
+{
+	d->pool.waitForDone();
+	QMutexLocker lock(&d->mutex);
+	d->entries.clear();
+}
+
+int ConfigPreloader::numPending() const
+{
+	QMutexLocker lock(&d->mutex);
+	return d->entries.count();
+}
+
+PreloadedConfig ConfigPreloader::load(QString file)
+{
+	PreloadedConfig config;
+	config.exists = true;
+	config.valid = true;
+	config.fromSnapshot = false;
+
+	// use what was read last time if the file has not changed
+	if (LibrarySnapshot::instance()->find(file, &config.data))
+	{
+		config.fromSnapshot = true;
+		return config;
+	}
+
+	// read it in
+	QFile f(file);
+	if (!f.open(QFile::ReadOnly))
+	{
+		config.exists = false;
+		return config;
+	}
+	// taken before reading, so that a change made while
+	// reading never matches the snapshot next time
+	QFileInfo info(f);
+	qint64 modified = info.lastModified().toMSecsSinceEpoch();
+	qint64 size = info.size();
+	JsonReader reader;
+	JsonReaderErrors errors;
+	config.data = reader.read(&f, &errors);
+	if (errors.numErrors())
+	{
+		config.valid = false;
+		for (auto err : errors)
+		{
+			config.errors << err.message();
+		}
+	}
+	else
+	{
+		// so that the next run does not have to parse it again
+		LibrarySnapshot::instance()->record(file, config.data, modified, size);
+	}
+	return config;
+}
@@ -0,0 +1,130 @@
+#ifndef CONFIG_PRELOADER_H
+#define CONFIG_PRELOADER_H
+
+// for the library
+#include "macros/BackendLibraryMacros.h"
+
+// for holding data
+#include <QString>
+#include <QList>
+#include <JsonDataTree/Json.h>
+
+namespace AWE
+{
+	// internal data
+	class ConfigPreloaderPrivate;
+
+	/**
+	 * \brief The contents of a configuration file, read
+	 *			by the `ConfigPreloader`.
+	 **/
+	struct PreloadedConfig
+	{
+		/** \brief Whether the file could be opened. **/
+		bool exists;
+		/** \brief Whether the file was parsed without errors. **/
+		bool valid;
+		/** \brief Whether the contents came from the `LibrarySnapshot`. **/
+		bool fromSnapshot;
+		/** \brief The contents of the file. **/
+		JSON::JsonValue data;
+		/** \brief The parse errors, if any. **/
+		QList<QString> errors;
+	};
+
+	/**
+	 * \brief Reads and parses configuration files ahead of
+	 *			time on a pool of worker threads.
+	 *
+	 * At startup, `GlobalSettings` hands every configuration
+	 * file it is about to need to `preload()`, and then makes
+	 * the objects for them one after another on the GUI thread.
+	 * When a `ConfigFile` is made for a preloaded file, it takes
+	 * the parsed contents from here (waiting for them if they are
+	 * not ready yet) instead of reading the file itself. So the
+	 * reading and parsing of every phase overlaps, and only the
+	 * `QObject`s are made on the GUI thread.
+	 *
+	 * There is only one preloader, obtained through
+	 * `ConfigPreloader::instance()`. It may be used from
+	 * any thread.
+	 **/
+	class AWEMC_BACKEND_LIBRARY ConfigPreloader
+	{
+		public:
+			/**
+			 * \brief Get the preloader.
+			 *
+			 * \returns The preloader.
+			 **/
+			static ConfigPreloader* instance();
+
+			/**
+			 * \brief Destroy this object, waiting for any
+			 *			files that are being read.
+			 **/
+			~ConfigPreloader();
+
+			/**
+			 * \brief Start reading the given files in the
+			 *			background.
+			 *
+			 * Files that are already being read are skipped.
+			 *
+			 * \param files The paths to the files.
+			 **/
+			void preload(QList<QString> files);
+
+			/**
+			 * \brief Take the contents of a preloaded file.
+			 *
+			 * If the file is still being read, this waits
+			 * for it. The contents are only handed out once.
+			 *
+			 * \param[in] file The path to the file.
+			 * \param[out] config Where to put the contents.
+			 *
+			 * \returns `true` if the file was preloaded,
+			 *			`false` otherwise.
+			 **/
+			bool take(QString file, PreloadedConfig* config);
+
+			/**
+			 * \brief Wait for every file to be read and drop
+			 *			the ones that were never taken.
+			 **/
+			void clear();
+
+			/**
+			 * \brief Get the number of files that have been
+			 *			preloaded but not taken.
+			 *
+			 * \returns The number of files.
+			 **/
+			int numPending() const;
+
+			/**
+			 * \brief Read a configuration file right away,
+			 *			on the calling thread.
+			 *
+			 * The `LibrarySnapshot` is asked first, and the
+			 * file is only read and parsed if it has changed.
+			 *
+			 * \param file The path to the file.
+			 *
+			 * \returns The contents of the file.
+			 **/
+			static PreloadedConfig load(QString file);
+
+		private:
+			/**
+			 * \brief Make the preloader.
+			 **/
+			ConfigPreloader();
+
+			/** \brief Internal data. **/
+			ConfigPreloaderPrivate* d;
+	};
+}
+
+#endif // CONFIG_PRELOADER_H
@@ -0,0 +1,248 @@
+// header file
+#include "ConfigWriter.h"
+
+// the files that are written
+#include "ConfigFile.h"
+
+// so that the new file is seen
+#include "FileInfoCache.h"
+
+// so that the next run does not have to parse it again
+#include "LibrarySnapshot.h"
+
+// for writing
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDateTime>
+
+// for threading
+#include <QThreadPool>
+#include <QRunnable>
+#include <QMutex>
+#include <QMutexLocker>
+
+// for holding data
+#include <QHash>
+#include <QSet>
+#include <QPointer>
+#include <QTimer>
+#include <QCoreApplication>
+
+// for debug output
+#include <QDebug>
+
+using namespace JSON;
+
+namespace AWE
+{
+	class ConfigWriterPrivate
+	{
+		public:
+			// the files waiting for the delay to pass
+			QSet<ConfigFile*> scheduled;
+			QTimer timer;
+			// the files handed to the background thread, which
+			// are only clean once the write went through
+			QHash<QString, QPointer<ConfigFile> > inFlight;
+
+			// writes happen one at a time, in order
+			QThreadPool pool;
+
+			// the newest data for each path waiting to be written
+			QMutex mutex;
+			QHash<QString, JsonValue> queued;
+
+			// held for the whole of every write, so that
+			// two writes never race on the same file
+			QMutex writing;
+	};
+
+	/** \brief Writes the newest data for one path. **/
+	class ConfigWriterJob : public QRunnable
+	{
+		public:
+			ConfigWriterJob(ConfigWriter* p, ConfigWriterPrivate* d, QString path)
+				:	p(p),
+					d(d),
+					path(path)
+				{ }
+
+			void run()
+			{
+				QMutexLocker writing(&d->writing);
+				JsonValue data;
+				{
+					QMutexLocker lock(&d->mutex);
+					// already written by writeAndWait()
+					if (!d->queued.contains(path))
+					{
+						return;
+					}
+					data = d->queued.take(path);
+				}
+				bool ok = ConfigWriter::writeNow(path, data);
+				// the file is marked as written on the GUI thread
+				QMetaObject::invokeMethod(p, "written", Qt::QueuedConnection,
+					Q_ARG(QString, path), Q_ARG(bool, ok));
+			}
+
+		private:
+			ConfigWriter* p;
+			ConfigWriterPrivate* d;
+			QString path;
+	};
+}
+
+using namespace AWE;
+
+ConfigWriter* ConfigWriter::instance()
+{
+	static ConfigWriter* writer = new ConfigWriter(QCoreApplication::instance());
+	return writer;
+}
+
+ConfigWriter::ConfigWriter(QObject* parent)
+	:	QObject(parent),
+		d(new ConfigWriterPrivate)
+{
+	d->pool.setMaxThreadCount(1);
+	d->timer.setSingleShot(true);
+	d->timer.setInterval(1000);
+	connect(&d->timer, &QTimer::timeout, this, &ConfigWriter::writeScheduled);
+}
+
+ConfigWriter::~ConfigWriter()
+{
+	flush();
+	delete d;
+}
+
+void ConfigWriter::schedule(ConfigFile* file)
+{
+	d->scheduled.insert(file);
+	// the delay starts at the first edit, so that a
+	// steady stream of edits still gets written
+	if (!d->timer.isActive())
+	{
+		d->timer.start();
+	}
+}
+
+void ConfigWriter::cancel(ConfigFile* file)
+{
+	d->scheduled.remove(file);
+	for (auto i = d->inFlight.begin(); i != d->inFlight.end(); )
+	{
+		if (i.value() == file)
+		{
+			i = d->inFlight.erase(i);
+		}
+		else
+		{
+			++ i;
+		}
+	}
+}
+
+void ConfigWriter::write(QString path, JsonValue data)
+{
+	QMutexLocker lock(&d->mutex);
+	bool alreadyQueued = d->queued.contains(path);
+	d->queued[path] = data;
+	if (!alreadyQueued)
+	{
+		d->pool.start(new ConfigWriterJob(this, d, path));
+	}
+}
+
+bool ConfigWriter::writeAndWait(QString path, JsonValue data)
+{
+	// the file is marked by the caller instead
+	d->inFlight.remove(path);
+	// waits for a background write that already started
+	QMutexLocker writing(&d->writing);
+	{
+		// anything still queued is older
+		QMutexLocker lock(&d->mutex);
+		d->queued.remove(path);
+	}
+	return writeNow(path, data);
+}
+
+void ConfigWriter::flush()
+{
+	d->timer.stop();
+	writeScheduled();
+	d->pool.waitForDone();
+}
+
+int ConfigWriter::numPending() const
+{
+	QMutexLocker lock(&d->mutex);
+	return d->scheduled.count() + d->queued.count();
+}
+
+void ConfigWriter::setDelay(int msec)
+{
+	d->timer.setInterval(msec);
+}
+
+int ConfigWriter::getDelay() const
+{
+	return d->timer.interval();
+}
+
+bool ConfigWriter::writeNow(QString path, JsonValue data)
+{
+	// QSaveFile writes to a temporary file, syncs it
+	// and then renames it over the real one
+	QSaveFile file(path);
+	if (file.open(QIODevice::WriteOnly))
+	{
+		JsonWriter writer(data);
+		writer.writeTo(&file);
+		if (file.commit())
+		{
+			FileInfoCache::instance()->invalidate(path);
+			QFileInfo info(path);
+			LibrarySnapshot::instance()->record(path, data,
+				info.lastModified().toMSecsSinceEpoch(), info.size());
+			return true;
+		}
+	}
+	qWarning() << "ConfigWriter: Could not write to file" << path;
+	return false;
+}
+
+void ConfigWriter::writeScheduled()
+{
+	QSet<ConfigFile*> files = d->scheduled;
+	d->scheduled.clear();
+	for (auto file : files)
+	{
+		// copied here, on the GUI thread
+		QString path = file->getPathToConfigFile().absoluteFilePath(
+			file->getConfigFileName());
+		d->inFlight[path] = file;
+		write(path, file->getData());
+	}
+}
+
+void ConfigWriter::written(QString path, bool ok)
+{
+	ConfigFile* file = d->inFlight.take(path);
+	if (!file)
+	{
+		return;
+	}
+	if (!ok)
+	{
+		// tried again after the delay
+		schedule(file);
+	}
+	else if (!d->scheduled.contains(file))
+	{
+		// edits made since then are still to be written
+		file->markAsWritten();
+	}
+}
@@ -0,0 +1,182 @@
+#ifndef CONFIG_WRITER_H
+#define CONFIG_WRITER_H
+
+// for the library
+#include "macros/BackendLibraryMacros.h"
+
+// superclass
+#include <QObject>
+
+// for holding data
+#include <QString>
+#include <JsonDataTree/Json.h>
+
+namespace AWE
+{
+	// internal data
+	class ConfigWriterPrivate;
+
+	// the files that are written
+	class ConfigFile;
+
+	/**
+	 * \brief Writes edited configuration files in the background.
+	 *
+	 * When a `ConfigFile` is edited, it is scheduled here
+	 * instead of being written right away. Edits are collected
+	 * for a short delay, after which the contents of every edited
+	 * file are copied on the GUI thread and written on a
+	 * background thread. So a burst of edits to the same file
+	 * (like a scraper filling in an item) is written once.
+	 * A file is only marked as written once the write went
+	 * through, and it is scheduled again if it failed.
+	 *
+	 * Every write goes to a temporary file that is synced
+	 * to disk and then renamed over the real file, so a crash
+	 * never leaves a half-written configuration file behind.
+	 *
+	 * There is only one writer, obtained through
+	 * `ConfigWriter::instance()`. It must be used from the
+	 * GUI thread.
+	 **/
+	class AWEMC_BACKEND_LIBRARY ConfigWriter : public QObject
+	{
+		Q_OBJECT
+
+		public:
+			/**
+			 * \brief Get the config writer.
+			 *
+			 * \returns The config writer.
+			 **/
+			static ConfigWriter* instance();
+
+			/**
+			 * \brief Destroy this object, waiting for any
+			 *			writes that are still running.
+			 **/
+			virtual ~ConfigWriter();
+
+			/**
+			 * \brief Write `file` once the delay has passed.
+			 *
+			 * Scheduling a file that is already scheduled
+			 * does nothing.
+			 *
+			 * \param file The edited file.
+			 **/
+			virtual void schedule(ConfigFile* file);
+
+			/**
+			 * \brief Forget about a scheduled file.
+			 *
+			 * \param file The file that should not be written.
+			 **/
+			virtual void cancel(ConfigFile* file);
+
+			/**
+			 * \brief Write the given data to the given path
+			 *			in the background.
+			 *
+			 * If the same path is waiting to be written, only
+			 * the newest data is written.
+			 *
+			 * \param path The path to write to.
+			 * \param data The data to write.
+			 **/
+			virtual void write(QString path, JSON::JsonValue data);
+
+			/**
+			 * \brief Write the given data to the given path
+			 *			right away, on the calling thread.
+			 * Older data that is waiting to be written to the
+			 * same path is dropped, and a background write of
+			 * the same path that already started is finished
+			 * first, so the file always ends up with `data`.
+			 * \param path The path to write to.
+			 * \param data The data to write.
+			 * \returns `true` if the file was written,
+			 *			`false` otherwise.
+			 **/
+			virtual bool writeAndWait(QString path, JSON::JsonValue data);
+
+			/**
+			 * \brief Write everything that is scheduled and wait
+			 *			until all writes are done.
+			 **/
+			virtual void flush();
+
+			/**
+			 * \brief Get the number of files that are scheduled
+			 *			or being written.
+			 *
+			 * \returns The number of pending files.
+			 **/
+			virtual int numPending() const;
+
+			/**
+			 * \brief Set how long edits are collected before
+			 *			being written.
+			 *
+			 * \param msec The delay, in milliseconds.
+			 **/
+			virtual void setDelay(int msec);
+
+			/**
+			 * \brief Get how long edits are collected before
+			 *			being written.
+			 *
+			 * By default, this is one second.
+			 *
+			 * \returns The delay, in milliseconds.
+			 **/
+			virtual int getDelay() const;
+
+			/**
+			 * \brief Write data to a file atomically, on the
+			 *			calling thread.
+			 * This does not wait for background writes, so
+			 * files that may also be queued should be written
+			 * with `writeAndWait()` instead.
+			 *
+			 * \param path The path to write to.
+			 * \param data The data to write.
+			 *
+			 * \returns `true` if the file was written,
+			 *			`false` otherwise.
+			 **/
+			static bool writeNow(QString path, JSON::JsonValue data);
+
+		private slots:
+			/**
+			 * \brief Hand every scheduled file to the
+			 *			background thread.
+			 **/
+			void writeScheduled();
+
+			/**
+			 * \brief Mark a file as written once its background
+			 *			write is done, or schedule it again if
+			 *			the write failed.
+			 *
+			 * \param path The path that was written.
+			 * \param ok Whether the write went through.
+			 **/
+			void written(QString path, bool ok);
+
+		private:
+			friend class ConfigWriterPrivate;
+
+			/**
+			 * \brief Make the writer.
+			 *
+			 * \param parent The parent object.
+			 **/
+			ConfigWriter(QObject* parent);
+
+			/** \brief Internal data. **/
+			ConfigWriterPrivate* d;
+	};
+}
+
+#endif // CONFIG_WRITER_H
@@ -0,0 +1,396 @@
+// header file
+#include "FileInfoCache.h"
+
+// for reading the disk
+#include <QDir>
+#include <QDirIterator>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QFileSystemWatcher>
+
+// for holding data
+#include <QHash>
+#include <QElapsedTimer>
+#include <QCoreApplication>
+
+// for thread safety
+#include <QMutex>
+#include <QMutexLocker>
+
+namespace AWE
+{
+	/** \brief How long an unwatched directory is trusted, in milliseconds. **/
+	static const qint64 unwatchedMaxAge = 2000;
+
+	/** \brief What is known about one name in a directory. **/
+	struct FileEntry
+	{
+		bool isDir;
+		// the size and time are only read when first asked for
+		bool statted;
+		qint64 size;
+		qint64 modified;
+	};
+
+	/** \brief What is known about one directory. **/
+	struct DirListing
+	{
+		bool exists;
+		qint64 modified;
+		qint64 checkedAt;
+		bool watched;
+		QHash<QString, FileEntry> entries;
+	};
+
+	class FileInfoCachePrivate
+	{
+		public:
+			FileInfoCache* p;
+
+			// find what is known about a path, scanning
+			// its directory if necessary
+			bool lookup(QString path, FileEntry* entry);
+			// get the size and time of a path, reading
+			// them from the disk the first time
+			bool stat(QString path, FileEntry* entry);
+			// list a directory
+			DirListing scan(QString dir) const;
+
+			// split a clean path into directory and name
+			static bool split(QString path, QString* dir, QString* name);
+			// the key for a name in a listing
+			static QString nameKey(QString name);
+			// find a name in a listing
+			static bool find(const DirListing& listing, QString name,
+				FileEntry* entry);
+
+			mutable QMutex mutex;
+			QHash<QString, DirListing> dirs;
+			int scans;
+			QElapsedTimer clock;
+			// how many times each directory is being watched
+			QHash<QString, int> watchCounts;
+
+			// only used on the GUI thread
+			QFileSystemWatcher watcher;
+	};
+}
+
+using namespace AWE;
+
+FileInfoCache* FileInfoCache::instance()
+{
+	static FileInfoCache* cache = new FileInfoCache(QCoreApplication::instance());
+	return cache;
+}
+
+FileInfoCache::FileInfoCache(QObject* parent)
+	:	QObject(parent),
+		d(new FileInfoCachePrivate)
+{
+	d->p = this;
+	d->scans = 0;
+	d->clock.start();
+	connect(&d->watcher, &QFileSystemWatcher::directoryChanged,
+		this, &FileInfoCache::directoryChanged);
+}
+
+FileInfoCache::~FileInfoCache()
+{
+	delete d;
+}
+
+bool FileInfoCache::exists(QString path)
+{
+	FileEntry entry;
+	return d->lookup(path, &entry);
+}
+
+bool FileInfoCache::isDir(QString path)
+{
+	FileEntry entry;
+	return d->lookup(path, &entry) && entry.isDir;
+}
+
+qint64 FileInfoCache::getSize(QString path)
+{
+	FileEntry entry;
+	if (d->stat(path, &entry))
+	{
+		return entry.size;
+	}
+	return -1;
+}
+
+qint64 FileInfoCache::getLastModified(QString path)
+{
+	FileEntry entry;
+	if (d->stat(path, &entry))
+	{
+		return entry.modified;
+	}
+	return -1;
+}
+
+void FileInfoCache::invalidate(QString path)
+{
+	QString dir, name;
+	if (FileInfoCachePrivate::split(resolve(path), &dir, &name))
+	{
+		QMutexLocker lock(&d->mutex);
+		d->dirs.remove(dir);
+	}
+}
+
+void FileInfoCache::clear()
+{
+	QMutexLocker lock(&d->mutex);
+	d->dirs.clear();
+}
+
+int FileInfoCache::numDirectories() const
+{
+	QMutexLocker lock(&d->mutex);
+	return d->dirs.count();
+}
+
+int FileInfoCache::numScans() const
+{
+	QMutexLocker lock(&d->mutex);
+	return d->scans;
+}
+
+QString FileInfoCache::resolve(QString path, QString base)
+{
+	if (QDir::isRelativePath(path))
+	{
+		if (base.isEmpty())
+		{
+			base = QDir::currentPath();
+		}
+		else if (QDir::isRelativePath(base))
+		{
+			base = QDir::currentPath() + '/' + base;
+		}
+		path = base + '/' + path;
+	}
+	return QDir::cleanPath(path);
+}
+
+void FileInfoCache::watch(QString dir)
+{
+	dir = resolve(dir);
+	{
+		QMutexLocker lock(&d->mutex);
+		if (d->watchCounts.contains(dir))
+		{
+			++ d->watchCounts[dir];
+			return;
+		}
+	}
+	if (!d->watcher.addPath(dir))
+	{
+		// checked against its modification time instead
+		return;
+	}
+	QMutexLocker lock(&d->mutex);
+	d->watchCounts[dir] = 1;
+	// it may have changed before the watch started
+	d->dirs.remove(dir);
+}
+
+void FileInfoCache::unwatch(QString dir)
+{
+	dir = resolve(dir);
+	{
+		QMutexLocker lock(&d->mutex);
+		auto i = d->watchCounts.find(dir);
+		if (i == d->watchCounts.end() || -- i.value() > 0)
+		{
+			return;
+		}
+		d->watchCounts.erase(i);
+		// from now on, checked like any other directory
+		auto j = d->dirs.find(dir);
+		if (j != d->dirs.end())
+		{
+			j->watched = false;
+			j->checkedAt = d->clock.elapsed();
+		}
+	}
+	d->watcher.removePath(dir);
+}
+
+void FileInfoCache::directoryChanged(QString dir)
+{
+	bool deleted = !QFileInfo(dir).exists();
+	QMutexLocker lock(&d->mutex);
+	// deleted directories are no longer watched
+	if (deleted)
+	{
+		d->watchCounts.remove(dir);
+	}
+	d->dirs.remove(dir);
+}
+
+bool FileInfoCachePrivate::lookup(QString path, FileEntry* entry)
+{
+	QString dir, name;
+	if (!split(FileInfoCache::resolve(path), &dir, &name))
+	{
+		// a root has no directory to scan
+		QFileInfo info(path);
+		entry->isDir = info.isDir();
+		entry->statted = true;
+		entry->size = info.size();
+		entry->modified = info.lastModified().toMSecsSinceEpoch();
+		return info.exists();
+	}
+	bool known = false;
+	qint64 knownModified = -1;
+	{
+		QMutexLocker lock(&mutex);
+		auto i = dirs.constFind(dir);
+		if (i != dirs.constEnd())
+		{
+			if (i->watched || clock.elapsed() - i->checkedAt < unwatchedMaxAge)
+			{
+				return find(*i, name, entry);
+			}
+			known = true;
+			knownModified = i->modified;
+		}
+	}
+	// an unwatched directory that has not changed is still good
+	if (known)
+	{
+		QFileInfo info(dir);
+		qint64 modified = info.exists()
+			? info.lastModified().toMSecsSinceEpoch() : -1;
+		if (modified == knownModified)
+		{
+			QMutexLocker lock(&mutex);
+			auto i = dirs.find(dir);
+			if (i != dirs.end())
+			{
+				i->checkedAt = clock.elapsed();
+				return find(*i, name, entry);
+			}
+		}
+	}
+	// scanned without the lock, since that is the slow part
+	DirListing listing = scan(dir);
+	{
+		QMutexLocker lock(&mutex);
+		++ scans;
+		listing.watched = watchCounts.contains(dir);
+		dirs[dir] = listing;
+	}
+	return find(listing, name, entry);
+}
+
+bool FileInfoCachePrivate::stat(QString path, FileEntry* entry)
+{
+	if (!lookup(path, entry))
+	{
+		return false;
+	}
+	if (entry->statted)
+	{
+		return true;
+	}
+	// read without the lock, then remember it in the listing
+	path = FileInfoCache::resolve(path);
+	QFileInfo info(path);
+	if (!info.exists())
+	{
+		return false;
+	}
+	entry->statted = true;
+	entry->size = info.size();
+	entry->modified = info.lastModified().toMSecsSinceEpoch();
+	QString dir, name;
+	if (split(path, &dir, &name))
+	{
+		QMutexLocker lock(&mutex);
+		auto i = dirs.find(dir);
+		if (i != dirs.end())
+		{
+			auto j = i->entries.find(nameKey(name));
+			if (j != i->entries.end())
+			{
+				*j = *entry;
+			}
+		}
+	}
+	return true;
+}
+
+DirListing FileInfoCachePrivate::scan(QString dir) const
+{
+	DirListing listing;
+	listing.watched = false;
+	listing.checkedAt = clock.elapsed();
+	QFileInfo info(dir);
+	listing.exists = info.isDir();
+	listing.modified = listing.exists
+		? info.lastModified().toMSecsSinceEpoch() : -1;
+	if (listing.exists)
+	{
+		QDirIterator it(dir, QDir::AllEntries | QDir::Hidden
+			| QDir::System | QDir::NoDotAndDotDot);
+		while (it.hasNext())
+		{
+			it.next();
+			// the type comes with the listing itself, but asking
+			// for sizes or times would stat every entry
+			QFileInfo info = it.fileInfo();
+			FileEntry entry = { info.isDir(), false, -1, -1 };
+			listing.entries[nameKey(info.fileName())] = entry;
+		}
+	}
+	return listing;
+}
+
+bool FileInfoCachePrivate::split(QString path, QString* dir, QString* name)
+{
+	int slash = path.lastIndexOf('/');
+	if (slash == -1 || slash == path.length() - 1)
+	{
+		return false;
+	}
+	*dir = path.left(slash);
+	// keep the slash for "/" and "C:/"
+	if (dir->isEmpty() || dir->endsWith(':'))
+	{
+		*dir += '/';
+	}
+	*name = path.mid(slash + 1);
+	return true;
+}
+
+QString FileInfoCachePrivate::nameKey(QString name)
+{
+#if defined(Q_OS_WIN) || defined(Q_OS_MAC)
+	// these file systems ignore case
+	return name.toCaseFolded();
+#else
+	return name;
+#endif
+}
+
+bool FileInfoCachePrivate::find(const DirListing& listing, QString name,
+	FileEntry* entry)
+{
+	if (!listing.exists)
+	{
+		return false;
+	}
+	auto i = listing.entries.constFind(nameKey(name));
+	if (i == listing.entries.constEnd())
+	{
+		return false;
+	}
+	*entry = i.value();
+	return true;
+}
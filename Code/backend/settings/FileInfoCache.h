@@ -0,0 +1,186 @@
+#ifndef FILE_INFO_CACHE_H
+#define FILE_INFO_CACHE_H
+
+// for the library
+#include "macros/BackendLibraryMacros.h"
+
+// superclass
+#include <QObject>
+
+// for holding data
+#include <QString>
+
+namespace AWE
+{
+	// internal data
+	class FileInfoCachePrivate;
+
+	/**
+	 * \brief Remembers what is on disk, one directory
+	 *			at a time.
+	 *
+	 * Asking about a file lists the names in its whole
+	 * directory once, and every later question about what
+	 * exists there is answered from memory. So reading a
+	 * library with thousands of items costs one scan per
+	 * directory instead of a few round trips per item, which
+	 * matters a lot on network mounts. Sizes and modification
+	 * times are read the first time they are asked for, and
+	 * then kept with the rest of the listing.
+	 *
+	 * Only the directories passed to `watch()`, such as the
+	 * folders being shown, are watched, and they are forgotten
+	 * as soon as they change. Every other directory is checked
+	 * against its modification time every couple of seconds.
+	 * A file rewritten in place does not change its directory,
+	 * so anything that writes a file itself should call
+	 * `invalidate()` so that the change is seen right away.
+	 *
+	 * There is only one cache, obtained through
+	 * `FileInfoCache::instance()`. It must first be obtained
+	 * from the GUI thread, since that is where the directories
+	 * are watched, but it may then be used from any thread.
+	 **/
+	class AWEMC_BACKEND_LIBRARY FileInfoCache : public QObject
+	{
+		Q_OBJECT
+
+		public:
+			/**
+			 * \brief Get the cache.
+			 *
+			 * \returns The cache.
+			 **/
+			static FileInfoCache* instance();
+
+			/**
+			 * \brief Destroy this object.
+			 **/
+			virtual ~FileInfoCache();
+
+			/**
+			 * \brief Determine if a file or directory exists.
+			 *
+			 * \param path The path to check.
+			 *
+			 * \returns `true` if it exists, `false` otherwise.
+			 **/
+			virtual bool exists(QString path);
+
+			/**
+			 * \brief Determine if a path is a directory.
+			 *
+			 * \param path The path to check.
+			 *
+			 * \returns `true` if it is a directory,
+			 *			`false` otherwise.
+			 **/
+			virtual bool isDir(QString path);
+
+			/**
+			 * \brief Get the size of a file.
+			 *
+			 * \param path The path to the file.
+			 *
+			 * \returns The size in bytes, or -1 if the
+			 *			file does not exist.
+			 **/
+			virtual qint64 getSize(QString path);
+
+			/**
+			 * \brief Get the last time a file was modified.
+			 *
+			 * \param path The path to the file.
+			 *
+			 * \returns The time in milliseconds since the epoch,
+			 *			or -1 if the file does not exist.
+			 **/
+			virtual qint64 getLastModified(QString path);
+
+			/**
+			 * \brief Forget what is known about the directory
+			 *			that holds `path`.
+			 *
+			 * \param path A file (or directory) whose parent
+			 *			directory changed.
+			 **/
+			virtual void invalidate(QString path);
+
+			/**
+			 * \brief Forget everything.
+			 **/
+			virtual void clear();
+
+			/**
+			 * \brief Start watching a directory, so that changes
+			 *			to it are seen right away.
+			 *
+			 * Each call must be matched by a call to `unwatch()`,
+			 * and both must be made from the GUI thread.
+			 *
+			 * \param dir The directory to watch.
+			 **/
+			virtual void watch(QString dir);
+
+			/**
+			 * \brief Stop watching a directory.
+			 *
+			 * \param dir The directory passed to `watch()`.
+			 **/
+			virtual void unwatch(QString dir);
+
+			/**
+			 * \brief Get the number of directories that
+			 *			are remembered.
+			 *
+			 * \returns The number of directories.
+			 **/
+			virtual int numDirectories() const;
+
+			/**
+			 * \brief Get the number of directory scans
+			 *			that have been done.
+			 *
+			 * \returns The number of scans.
+			 **/
+			virtual int numScans() const;
+
+			/**
+			 * \brief Turn a path into a clean, absolute path.
+			 *
+			 * This only works on the string, so it never
+			 * touches the disk.
+			 *
+			 * \param path The path, which may be relative.
+			 * \param base The directory `path` is relative
+			 *			to, or the current directory if empty.
+			 *
+			 * \returns The clean, absolute path.
+			 **/
+			static QString resolve(QString path,
+				QString base = QString());
+
+		private slots:
+			/**
+			 * \brief Forget a directory that changed.
+			 *
+			 * \param dir The directory that changed.
+			 **/
+			void directoryChanged(QString dir);
+
+		private:
+			friend class FileInfoCachePrivate;
+
+			/**
+			 * \brief Make the cache.
+			 *
+			 * \param parent The parent object.
+			 **/
+			FileInfoCache(QObject* parent);
+
+			/** \brief Internal data. **/
+			FileInfoCachePrivate* d;
+	};
+}
+
+#endif // FILE_INFO_CACHE_H
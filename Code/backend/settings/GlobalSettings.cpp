@@ -4,6 +4,34 @@
 // for the singleton
 #include "AWEMC.h"
 
+// for the caches
+#include "image/ThumbnailCache.h"
+#include "image/ImageCache.h"
+#include "LibrarySnapshot.h"
+#include "FileInfoCache.h"
+#include "PluginCache.h"
+#include "HttpCache.h"
+
+// for reading web pages
+#include "libs/internet_reader/http_client.h"
+#include "libs/internet_reader/web_fetcher.h"
+
+// for keeping plugins loaded
+#include "PluginPool.h"
+
+// for finding players for files
+#include "player/PlayableFileIndex.h"
+
+// for stopping scrape jobs
+#include "scraper/ScrapeJobManager.h"
+
+// for reading and writing config files
+#include "ConfigWriter.h"
+#include "ConfigPreloader.h"
+
+// for startup timings
+#include <QElapsedTimer>
+
 // debug
 #include <QDebug>
 
@@ -19,6 +47,7 @@ namespace AWE
 			GlobalSettings* p;
 
 			// functions for loading the settings at startup
+			void obtainCaches();
 			void obtainSkins();
 			void obtainTypes();
 			void obtainPlayers();
@@ -26,6 +55,19 @@ namespace AWE
 			void obtainServices();
 			void obtainItems();
 
+			// get a path from the "folders" member,
+			// adding it if it is not there
+			QString pathFor(QString name, QString defaultPath);
+			// get all of the config files in a folder
+			QList<QString> configFilesIn(QDir folder) const;
+			// start parsing every config file read at startup
+			void preloadConfigFiles();
+			// record how long a phase took
+			void finishPhase(QString name, QElapsedTimer& timer);
+
+			// how long each startup phase took
+			QList<QPair<QString, qint64>> timings;
+
 			// all of the maps for important data types
 			QHash<QString, Skin*> skins;
 			QHash<QString, JsonValue> typeMetadata;
@@ -33,6 +75,9 @@ namespace AWE
 			QHash<QString, MetadataScraperHandler*> scrapers;
 			QHash<QString, MediaServiceHandler*> services;
 
+			// the players for each kind of file
+			PlayableFileIndex playable;
+
 			// the root folder
 			Folder* rootFolder;
 
@@ -62,13 +107,28 @@ GlobalSettings::GlobalSettings(QString settingsFile)
 	// add pointer to this to the data
 	d->p = this;
 
-	// obtain all of the individual parts of AWEMC
+	// obtain all of the individual parts of AWEMC; the files
+	// are parsed on worker threads while the objects are made
+	QElapsedTimer timer;
+	timer.start();
+	d->obtainCaches();
+	d->finishPhase("caches", timer);
+	d->preloadConfigFiles();
+	d->finishPhase("preload", timer);
 	d->obtainSkins();
+	d->finishPhase("skins", timer);
 	d->obtainTypes();
+	d->finishPhase("types", timer);
 	d->obtainPlayers();
+	d->finishPhase("players", timer);
 	d->obtainScrapers();
+	d->finishPhase("scrapers", timer);
 	d->obtainServices();
+	d->finishPhase("services", timer);
 	d->obtainItems();
+	d->finishPhase("items", timer);
+	// anything that was never asked for
+	ConfigPreloader::instance()->clear();
 }
 
 GlobalSettings::~GlobalSettings()
@@ -76,12 +136,15 @@ GlobalSettings::~GlobalSettings()
 	// delete all of the media items
 	MediaItem::deleteAllItems();
 	// services deleted with other items
+	// nothing may still be scraping
+	ScrapeJobManager::instance()->cancelAll();
 	// delete scrapers
 	for (auto i : d->scrapers)
 	{
 		delete i;
 	}
 	// delete players
+	d->playable.clear();
 	for (auto i : d->players)
 	{
 		delete i;
@@ -91,6 +154,18 @@ GlobalSettings::~GlobalSettings()
 	{
 		delete i;
 	}
+	// nothing holds a plugin any more
+	PluginPool::instance()->clear();
+	// writes are recorded as they finish, so wait
+	// for them before the snapshot is saved
+	ConfigWriter::instance()->flush();
+	LibrarySnapshot::instance()->save();
+	PluginCache::instance()->save();
+	// stop reading pages and close open connections
+	// while libcurl is still there
+	WebFetcher::instance()->stop();
+	HttpCache::instance()->save();
+	HttpClient::instance()->clear();
 	// delete internal data
 	delete d;
 }
@@ -163,15 +238,7 @@ MediaPlayerHandler* GlobalSettings::getPlayerHandler(QString name)
 
 QList<MediaPlayerHandler*> GlobalSettings::getPlayersForFile(MediaFile* file)
 {
-	QList<MediaPlayerHandler*> ans;
-	for (auto i : d->players)
-	{
-		if (i->canPlay(file))
-		{
-			ans << i;
-		}
-	}
-	return ans;
+	return d->playable.find(file);
 }
 
 QList<QString> GlobalSettings::getTypeNames()
@@ -207,26 +274,151 @@ Folder* GlobalSettings::getRootFolder()
 	return d->rootFolder;
 }
 
-void GlobalSettingsPrivate::obtainSkins()
+QList<QPair<QString, qint64>> GlobalSettings::getStartupTimings() const
+{
+	return d->timings;
+}
+
+QDir GlobalSettings::getCacheFolder()
+{
+	QDir folder = getPathToConfigFile();
+	folder.mkpath(getMember({"folders", "cache"}).toString());
+	folder.cd(getMember({"folders", "cache"}).toString());
+	// it may have just been made
+	FileInfoCache::instance()->invalidate(folder.absolutePath());
+	return folder;
+}
+
+void GlobalSettingsPrivate::obtainCaches()
 {
 	// ensure that the necessary members are there
-	if (!p->getMember({"folders", "skins"}).isString())
+	if (!p->getMember({"folders", "cache"}).isString())
+	{
+		p->addMember({"folders", "cache"}, "cache/");
+	}
+	if (!p->getMember({"cache"}).isObject())
+	{
+		p->addMember({"cache"}, JsonValue::Object);
+	}
+	if (!p->getMember({"cache", "thumbnails"}).isNumber())
+	{
+		p->addMember({"cache", "thumbnails"}, 256);
+	}
+	if (!p->getMember({"cache", "images"}).isNumber())
+	{
+		p->addMember({"cache", "images"}, 128);
+	}
+	if (!p->getMember({"cache", "web"}).isNumber())
+	{
+		p->addMember({"cache", "web"}, 64);
+	}
+	if (!p->getMember({"cache", "web hours"}).isNumber())
+	{
+		p->addMember({"cache", "web hours"}, 24);
+	}
+	if (!p->getMember({"cache", "web hosts"}).isObject())
+	{
+		p->addMember({"cache", "web hosts"}, JsonValue::Object);
+	}
+
+	// made here so that directories are watched on the GUI thread
+	FileInfoCache::instance();
+
+	// every config file read last run, so they are not parsed again
+	QDir folder = p->getCacheFolder();
+	LibrarySnapshot::instance()->open(folder.absoluteFilePath("library"));
+
+	// which plugins worked last run, so they are not loaded to check
+	PluginCache::instance()->open(folder.absoluteFilePath("plugins"));
+
+	// open the thumbnails, limited to the given number of megabytes
+	ThumbnailCache::instance()->open(folder.absoluteFilePath("thumbnails"),
+		p->getMember({"cache", "thumbnails"}).toInteger() * 1024 * 1024);
+
+	// decoded images in memory, limited to the given number of megabytes
+	ImageCache::instance()->setMaxBytes(
+		p->getMember({"cache", "images"}).toInteger() * 1024 * 1024);
+
+	// downloaded pages, fresh for the given number of hours
+	HttpCache* web = HttpCache::instance();
+	web->open(folder.absoluteFilePath("web"),
+		p->getMember({"cache", "web"}).toInteger() * 1024 * 1024);
+	web->setTimeToLive(p->getMember({"cache", "web hours"}).toDouble() * 60 * 60);
+	const JsonObject hosts = p->getMember({"cache", "web hosts"}).toObject();
+	for (auto host : hosts)
+	{
+		web->setTimeToLive(host.key(), (*host).toDouble() * 60 * 60);
+	}
+
+	// how pages are read
+	if (!p->getMember({"web"}).isObject())
+	{
+		p->addMember({"web"}, JsonValue::Object);
+	}
+	if (!p->getMember({"web", "connect seconds"}).isNumber())
+	{
+		p->addMember({"web", "connect seconds"}, 10);
+	}
+	if (!p->getMember({"web", "timeout seconds"}).isNumber())
+	{
+		p->addMember({"web", "timeout seconds"}, 60);
+	}
+	if (!p->getMember({"web", "retries"}).isNumber())
+	{
+		p->addMember({"web", "retries"}, 2);
+	}
+	if (!p->getMember({"web", "connections per host"}).isNumber())
+	{
+		p->addMember({"web", "connections per host"}, 4);
+	}
+	if (!p->getMember({"web", "rate limits"}).isObject())
+	{
+		p->addMember({"web", "rate limits"}, JsonValue::Object);
+	}
+	// made here so that it belongs to the GUI thread
+	WebFetcher* fetcher = WebFetcher::instance();
+	fetcher->setTimeouts(
+		(int) (p->getMember({"web", "connect seconds"}).toDouble() * 1000),
+		(int) (p->getMember({"web", "timeout seconds"}).toDouble() * 1000));
+	fetcher->setRetries(p->getMember({"web", "retries"}).toInteger(), 1000);
+	fetcher->setMaxPerHost(p->getMember({"web", "connections per host"})
+		.toInteger());
+	const JsonObject limits = p->getMember({"web", "rate limits"}).toObject();
+	for (auto host : limits)
+	{
+		fetcher->setRateLimit(host.key(), (*host).toDouble());
+	}
+
+	// how long plugins stay loaded once nothing uses them
+	if (!p->getMember({"plugins"}).isObject())
 	{
-		p->addMember({"folders", "skins"}, "skins/");
+		p->addMember({"plugins"}, JsonValue::Object);
 	}
+	if (!p->getMember({"plugins", "idle seconds"}).isNumber())
+	{
+		p->addMember({"plugins", "idle seconds"}, 30);
+	}
+	if (!p->getMember({"plugins", "max idle"}).isNumber())
+	{
+		p->addMember({"plugins", "max idle"}, 8);
+	}
+	PluginPool* pool = PluginPool::instance();
+	pool->setIdleTimeout(p->getMember({"plugins", "idle seconds"}).toInteger() * 1000);
+	pool->setMaxIdle(p->getMember({"plugins", "max idle"}).toInteger());
+}
+
+void GlobalSettingsPrivate::obtainSkins()
+{
+	// ensure that the necessary members are there
 	if (!p->getMember({"default skin"}).isString())
 	{
 		p->addMember({"default skin"}, "Default");
 	}
 
-	// get the folder
-	QDir folder = p->getPathToConfigFile();
-	folder.cd(p->getMember({"folders", "skins"}).toString());
 	// look for all JSON files in the folder
-	QStringList files = folder.entryList({"*.json"}, QDir::Files);
-	for (auto f : files)
+	QList<QString> files = configFilesIn(pathFor("skins", "skins/"));
+	for (auto file : files)
 	{
-		QString file = folder.absoluteFilePath(f);
 		Skin* skin = new Skin(file);
         if (true)
 		{
@@ -249,20 +441,11 @@ void GlobalSettingsPrivate::obtainSkins()
 
 void GlobalSettingsPrivate::obtainTypes()
 {
-	// ensure that the necessary members are there
-	if (!p->getMember({"folders", "types"}).isString())
-	{
-		p->addMember({"folders", "types"}, "types/");
-	}
-
-	// get the folder
-	QDir folder = p->getPathToConfigFile();
-	folder.cd(p->getMember({"folders", "types"}).toString());
 	// look for all JSON files in the folder
-	QStringList files = folder.entryList({"*.json"}, QDir::Files);
+	QList<QString> files = configFilesIn(pathFor("types", "types/"));
 	for (auto f : files)
 	{
-		ConfigFile file(folder.absoluteFilePath(f));
+		ConfigFile file(f);
 		if (file.isValid())
 		{
 			typeMetadata[file.getMember({"metadata", "name"}).toString()]
@@ -273,77 +456,99 @@ void GlobalSettingsPrivate::obtainTypes()
 
 void GlobalSettingsPrivate::obtainPlayers()
 {
-	// ensure that the necessary members are there
-	if (!p->getMember({"folders", "players"}).isString())
-	{
-		p->addMember({"folders", "players"}, "players/");
-	}
-
-	// get the folder
-	QDir folder = p->getPathToConfigFile();
-	folder.cd(p->getMember({"folders", "players"}).toString());
 	// look for all JSON files in the folder
-	QStringList files = folder.entryList({"*.json"}, QDir::Files);
+	QList<QString> files = configFilesIn(pathFor("players", "players/"));
 	for (auto f : files)
 	{
-		MediaPlayerHandler* player = new MediaPlayerHandler(folder.absoluteFilePath(f));
+		MediaPlayerHandler* player = new MediaPlayerHandler(f);
 		players[player->getName()] = player;
 	}
+	// so that files are matched without asking every player
+	for (auto player : players)
+	{
+		if (!player->isValid())
+		{
+			continue;
+		}
+		if (player->declaresPlayable())
+		{
+			playable.addPlayer(player, player->getPlayablePatterns());
+		}
+		else
+		{
+			playable.addUndeclaredPlayer(player);
+		}
+	}
 }
 
 void GlobalSettingsPrivate::obtainScrapers()
 {
-	// ensure that the necessary members are there
-	if (!p->getMember({"folders", "scrapers"}).isString())
-	{
-		p->addMember({"folders", "scrapers"}, "scrapers/");
-	}
-
-	// get the folder
-	QDir folder = p->getPathToConfigFile();
-	folder.cd(p->getMember({"folders", "scrapers"}).toString());
 	// look for all JSON files in the folder
-	QStringList files = folder.entryList({"*.json"}, QDir::Files);
+	QList<QString> files = configFilesIn(pathFor("scrapers", "scrapers/"));
 	for (auto f : files)
 	{
 		MetadataScraperHandler* scraper 
-			= new MetadataScraperHandler(folder.absoluteFilePath(f));
+			= new MetadataScraperHandler(f);
 		scrapers[scraper->getName()] = scraper;
 	}
 }
 
 void GlobalSettingsPrivate::obtainServices()
 {
-	// ensure that the necessary members are there
-	if (!p->getMember({"folders", "services"}).isString())
-	{
-		p->addMember({"folders", "services"}, "services/");
-	}
-
-	// get the folder
-	QDir folder = p->getPathToConfigFile();
-	folder.cd(p->getMember({"folders", "services"}).toString());
 	// look for all JSON files in the folder
-	QStringList files = folder.entryList({"*.json"}, QDir::Files);
+	QList<QString> files = configFilesIn(pathFor("services", "services/"));
 	for (auto f : files)
 	{
 		MediaServiceHandler* service 
-			= new MediaServiceHandler(folder.absoluteFilePath(f));
+			= new MediaServiceHandler(f);
 		services[service->getName()] = service;
 	}
 }
 
 void GlobalSettingsPrivate::obtainItems()
 {
-	// ensure that the necessary members are there
-	if (!p->getMember({"folders", "root"}).isString())
+	// get the file
+	QString file = pathFor("root", "root/root.json");
+	rootFolder = new Folder(file);
+}
+
+QString GlobalSettingsPrivate::pathFor(QString name, QString defaultPath)
+{
+	// ensure that the necessary member is there
+	if (!p->getMember({"folders", name}).isString())
 	{
-		p->addMember({"folders", "root"}, "root/root.json");
+		p->addMember({"folders", name}, defaultPath);
 	}
+	return FileInfoCache::resolve(p->getMember({"folders", name}).toString(),
+		p->getPathToConfigFile().absolutePath());
+}
 
-	// get the file
-	QDir folder = p->getPathToConfigFile();
-	QString file = folder.absoluteFilePath(p->getMember(
-		{"folders", "root"}).toString());
-	rootFolder = new Folder(file);
+QList<QString> GlobalSettingsPrivate::configFilesIn(QDir folder) const
+{
+	QList<QString> ans;
+	QStringList files = folder.entryList({"*.json"}, QDir::Files);
+	for (auto f : files)
+	{
+		ans << folder.absoluteFilePath(f);
+	}
+	return ans;
+}
+
+void GlobalSettingsPrivate::preloadConfigFiles()
+{
+	// in the order they are needed
+	QList<QString> files;
+	files << configFilesIn(pathFor("skins", "skins/"));
+	files << configFilesIn(pathFor("types", "types/"));
+	files << configFilesIn(pathFor("players", "players/"));
+	files << configFilesIn(pathFor("scrapers", "scrapers/"));
+	files << configFilesIn(pathFor("services", "services/"));
+	files << pathFor("root", "root/root.json");
+	ConfigPreloader::instance()->preload(files);
+}
+
+void GlobalSettingsPrivate::finishPhase(QString name, QElapsedTimer& timer)
+{
+	qint64 elapsed = timer.restart();
+	timings << qMakePair(name, elapsed);
 }
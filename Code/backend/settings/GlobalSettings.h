@@ -3,6 +3,8 @@
 
 // for names and accessing data
 #include <QString>
+#include <QList>
+#include <QPair>
 
 // for settings file data
 #include <JsonDataTree/Json.h>
@@ -177,6 +179,32 @@ namespace AWE {
              */
 			virtual Folder* getRootFolder();
 
+			/**
+			 * \brief Get the folder that caches are kept in.
+			 *
+			 * This is the `"cache"` member of `"folders"`,
+			 * relative to the settings file, and it is made
+			 * if it does not exist.
+			 *
+			 * \returns The cache folder.
+			 **/
+			virtual QDir getCacheFolder();
+
+			/**
+			 * \brief Get how long each startup phase took.
+			 *
+			 * The phases are, in order, `"caches"`, `"preload"`,
+			 * `"skins"`, `"types"`, `"players"`, `"scrapers"`,
+			 * `"services"` and `"items"`. Configuration files are
+			 * parsed in the background during all of them, so a
+			 * phase only takes as long as making its objects plus
+			 * waiting for files that were not parsed yet.
+			 *
+			 * \returns Each phase name and its duration,
+			 *			in milliseconds.
+			 **/
+			virtual QList<QPair<QString, qint64>> getStartupTimings() const;
+
 		signals:
 			/**
 			 * \brief Sent when the current skin has been changed,
@@ -0,0 +1,423 @@
+// header file
+#include "HttpCache.h"
+
+// for the cache files
+#include <QFile>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDataStream>
+#include <QCryptographicHash>
+#include "FileInfoCache.h"
+
+// for holding data
+#include <QHash>
+#include <QSet>
+#include <QPair>
+#include <QUrl>
+#include <QDateTime>
+#include <cstring>
+#include <algorithm>
+
+// for thread safety
+#include <QMutex>
+#include <QMutexLocker>
+
+// for debug output
+#include <QDebug>
+
+namespace AWE
+{
+	/** \brief The start of every index file. **/
+	static const char httpCacheMagic[8] = { 'A', 'W', 'E', 'H', 'T', 'T', 'P', '2' };
+
+	/** \brief One page that is kept. **/
+	struct HttpCacheEntry
+	{
+		// the name of the file in the cache folder
+		QString file;
+		qint64 size;
+
+		// what the server sent
+		QString etag;
+		QString lastModified;
+		qint64 maxAge;
+		QString charset;
+
+		// milliseconds since the epoch
+		qint64 fetched;
+		qint64 lastUsed;
+	};
+
+	class HttpCachePrivate
+	{
+		public:
+			// get the name of the file for a page
+			static QString fileFor(QString url);
+			// remove pages until they fit, least recently used first
+			void trim();
+			// forget a page and delete its file
+			void drop(QString url);
+
+			mutable QMutex mutex;
+
+			QDir folder;
+			bool open;
+			qint64 maxBytes;
+			qint64 bytes;
+
+			qint64 timeToLive;
+			QHash<QString, qint64> hostTimeToLive;
+
+			QHash<QString, HttpCacheEntry> entries;
+	};
+}
+
+using namespace AWE;
+
+HttpCache* HttpCache::instance()
+{
+	static HttpCache cache;
+	return &cache;
+}
+
+HttpCache::HttpCache()
+	:	d(new HttpCachePrivate)
+{
+	d->open = false;
+	d->maxBytes = 0;
+	d->bytes = 0;
+	d->timeToLive = 24 * 60 * 60;
+}
+
+HttpCache::~HttpCache()
+{
+	delete d;
+}
+
+bool HttpCache::open(QString folder, qint64 maxBytes)
+{
+	QMutexLocker lock(&d->mutex);
+	QDir().mkpath(folder);
+	d->folder = QDir(folder);
+	d->open = true;
+	d->maxBytes = maxBytes;
+	d->bytes = 0;
+	d->entries.clear();
+
+	bool ans = false;
+	QFile in(d->folder.absoluteFilePath("index"));
+	char magic[sizeof(httpCacheMagic)];
+	if (in.open(QIODevice::ReadOnly)
+		&& in.read(magic, sizeof(magic)) == (qint64) sizeof(magic)
+		&& memcmp(magic, httpCacheMagic, sizeof(magic)) == 0)
+	{
+		QDataStream stream(&in);
+		stream.setVersion(QDataStream::Qt_5_0);
+		quint32 count;
+		stream >> count;
+		for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++ i)
+		{
+			QString url;
+			HttpCacheEntry entry;
+			stream >> url >> entry.file >> entry.size >> entry.etag
+				>> entry.lastModified >> entry.maxAge >> entry.charset
+				>> entry.fetched >> entry.lastUsed;
+			if (stream.status() == QDataStream::Ok)
+			{
+				d->entries[url] = entry;
+				d->bytes += entry.size;
+			}
+		}
+		ans = true;
+	}
+	else if (in.exists())
+	{
+		qWarning() << "HttpCache: Ignoring bad index" << in.fileName();
+	}
+
+	// pages written after the index was last saved are not
+	// known, and pages in the index may have been deleted
+	QSet<QString> known;
+	for (auto i = d->entries.begin(); i != d->entries.end(); )
+	{
+		if (d->folder.exists(i->file))
+		{
+			known.insert(i->file);
+			++ i;
+		}
+		else
+		{
+			d->bytes -= i->size;
+			i = d->entries.erase(i);
+		}
+	}
+	for (auto file : d->folder.entryList(QDir::Files))
+	{
+		if (file != "index" && !known.contains(file))
+		{
+			d->folder.remove(file);
+		}
+	}
+	d->trim();
+	return ans;
+}
+
+bool HttpCache::save()
+{
+	QMutexLocker lock(&d->mutex);
+	if (!d->open)
+	{
+		return false;
+	}
+	QSaveFile out(d->folder.absoluteFilePath("index"));
+	if (!out.open(QIODevice::WriteOnly))
+	{
+		qWarning() << "HttpCache: Could not write" << out.fileName();
+		return false;
+	}
+	out.write(httpCacheMagic, sizeof(httpCacheMagic));
+	QDataStream stream(&out);
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream << (quint32) d->entries.count();
+	for (auto i = d->entries.constBegin(); i != d->entries.constEnd(); ++ i)
+	{
+		stream << i.key() << i->file << i->size << i->etag
+			<< i->lastModified << i->maxAge << i->charset << i->fetched
+			<< i->lastUsed;
+	}
+	if (stream.status() != QDataStream::Ok || !out.commit())
+	{
+		qWarning() << "HttpCache: Could not write" << out.fileName();
+		return false;
+	}
+	FileInfoCache::instance()->invalidate(out.fileName());
+	return true;
+}
+
+bool HttpCache::isOpen() const
+{
+	QMutexLocker lock(&d->mutex);
+	return d->open;
+}
+
+void HttpCache::setMaxBytes(qint64 maxBytes)
+{
+	QMutexLocker lock(&d->mutex);
+	d->maxBytes = maxBytes;
+	d->trim();
+}
+
+void HttpCache::setTimeToLive(qint64 seconds)
+{
+	QMutexLocker lock(&d->mutex);
+	d->timeToLive = seconds;
+}
+
+void HttpCache::setTimeToLive(QString host, qint64 seconds)
+{
+	QMutexLocker lock(&d->mutex);
+	d->hostTimeToLive[host.toLower()] = seconds;
+}
+
+qint64 HttpCache::getTimeToLive(QString url) const
+{
+	QString host = QUrl(url).host().toLower();
+	QMutexLocker lock(&d->mutex);
+	return d->hostTimeToLive.value(host, d->timeToLive);
+}
+
+bool HttpCache::isCacheable(QString url)
+{
+	QString scheme = QUrl(url).scheme().toLower();
+	return scheme == "http" || scheme == "https";
+}
+
+bool HttpCache::findFresh(QString url, QByteArray* body, QString* charset)
+{
+	qint64 ttl = getTimeToLive(url);
+	QString file;
+	{
+		QMutexLocker lock(&d->mutex);
+		auto i = d->entries.find(url);
+		if (!d->open || i == d->entries.end())
+		{
+			return false;
+		}
+		qint64 maxAge = i->maxAge == -1 ? ttl : qMin(ttl, i->maxAge);
+		if (QDateTime::currentMSecsSinceEpoch() - i->fetched > maxAge * 1000)
+		{
+			return false;
+		}
+		i->lastUsed = QDateTime::currentMSecsSinceEpoch();
+		file = d->folder.absoluteFilePath(i->file);
+		if (charset)
+		{
+			*charset = i->charset;
+		}
+	}
+	// read without holding up other threads
+	QFile in(file);
+	if (!in.open(QIODevice::ReadOnly))
+	{
+		remove(url);
+		return false;
+	}
+	*body = in.readAll();
+	return true;
+}
+
+bool HttpCache::findValidators(QString url, QString* etag,
+	QString* lastModified)
+{
+	QMutexLocker lock(&d->mutex);
+	auto i = d->entries.constFind(url);
+	if (!d->open || i == d->entries.constEnd()
+		|| (i->etag.isEmpty() && i->lastModified.isEmpty()))
+	{
+		return false;
+	}
+	*etag = i->etag;
+	*lastModified = i->lastModified;
+	return true;
+}
+
+bool HttpCache::refresh(QString url, qint64 maxAge, QByteArray* body,
+	QString* charset)
+{
+	QString file;
+	{
+		QMutexLocker lock(&d->mutex);
+		auto i = d->entries.find(url);
+		if (!d->open || i == d->entries.end())
+		{
+			return false;
+		}
+		i->fetched = i->lastUsed = QDateTime::currentMSecsSinceEpoch();
+		if (maxAge != -1)
+		{
+			i->maxAge = maxAge;
+		}
+		file = d->folder.absoluteFilePath(i->file);
+		if (charset)
+		{
+			*charset = i->charset;
+		}
+	}
+	QFile in(file);
+	if (!in.open(QIODevice::ReadOnly))
+	{
+		remove(url);
+		return false;
+	}
+	*body = in.readAll();
+	return true;
+}
+
+void HttpCache::insert(QString url, QByteArray body, QString etag,
+	QString lastModified, qint64 maxAge, QString charset)
+{
+	QString name = HttpCachePrivate::fileFor(url);
+	QString file;
+	{
+		QMutexLocker lock(&d->mutex);
+		// pages bigger than the whole cache are never kept
+		if (!d->open || body.size() > d->maxBytes)
+		{
+			return;
+		}
+		file = d->folder.absoluteFilePath(name);
+	}
+	// written without holding up other threads
+	QSaveFile out(file);
+	if (!out.open(QIODevice::WriteOnly) || out.write(body) != body.size()
+		|| !out.commit())
+	{
+		qWarning() << "HttpCache: Could not write" << file;
+		return;
+	}
+	FileInfoCache::instance()->invalidate(file);
+	HttpCacheEntry entry;
+	entry.file = name;
+	entry.size = body.size();
+	entry.etag = etag;
+	entry.lastModified = lastModified;
+	entry.maxAge = maxAge;
+	entry.charset = charset;
+	entry.fetched = entry.lastUsed = QDateTime::currentMSecsSinceEpoch();
+
+	QMutexLocker lock(&d->mutex);
+	auto old = d->entries.constFind(url);
+	if (old != d->entries.constEnd())
+	{
+		d->bytes -= old->size;
+	}
+	d->entries[url] = entry;
+	d->bytes += entry.size;
+	d->trim();
+}
+
+void HttpCache::remove(QString url)
+{
+	QMutexLocker lock(&d->mutex);
+	d->drop(url);
+}
+
+void HttpCache::clear()
+{
+	QMutexLocker lock(&d->mutex);
+	for (auto url : d->entries.keys())
+	{
+		d->drop(url);
+	}
+}
+
+int HttpCache::count() const
+{
+	QMutexLocker lock(&d->mutex);
+	return d->entries.count();
+}
+
+qint64 HttpCache::getBytes() const
+{
+	QMutexLocker lock(&d->mutex);
+	return d->bytes;
+}
+
+QString HttpCachePrivate::fileFor(QString url)
+{
+	return QString::fromLatin1(QCryptographicHash::hash(url.toUtf8(),
+		QCryptographicHash::Sha1).toHex());
+}
+
+void HttpCachePrivate::trim()
+{
+	if (bytes <= maxBytes)
+	{
+		return;
+	}
+	// oldest first
+	QList<QPair<qint64, QString> > byUse;
+	for (auto i = entries.constBegin(); i != entries.constEnd(); ++ i)
+	{
+		byUse << qMakePair(i->lastUsed, i.key());
+	}
+	std::sort(byUse.begin(), byUse.end());
+	for (int i = 0; i < byUse.count() && bytes > maxBytes; ++ i)
+	{
+		drop(byUse[i].second);
+	}
+}
+
+void HttpCachePrivate::drop(QString url)
+{
+	auto i = entries.find(url);
+	if (i == entries.end())
+	{
+		return;
+	}
+	folder.remove(i->file);
+	FileInfoCache::instance()->invalidate(folder.absoluteFilePath(i->file));
+	bytes -= i->size;
+	entries.erase(i);
+}
@@ -0,0 +1,228 @@
+#ifndef HTTP_CACHE_H
+#define HTTP_CACHE_H
+
+// for the library
+#include "macros/BackendLibraryMacros.h"
+
+// for holding data
+#include <QString>
+#include <QByteArray>
+
+namespace AWE
+{
+	// internal data
+	class HttpCachePrivate;
+
+	/**
+	 * \brief A persistent store of web pages and files.
+	 *
+	 * Scrapers read the same search and series pages every
+	 * time they run. `readURLIntoStream()` and
+	 * `readURLIntoIODevice()` keep every page they download
+	 * here, one file per page in the cache folder, so a page
+	 * that was read recently is not downloaded again at all.
+	 *
+	 * A page stays fresh for its time to live (a default, or
+	 * one set for its host, unless the server sent a shorter
+	 * `max-age`). Once it is stale, the `ETag` and
+	 * `Last-Modified` values the server sent with it are
+	 * used to ask the server whether it changed, and if it
+	 * did not, the stored page is used and is fresh again.
+	 *
+	 * The pages are limited to a total size. When they grow
+	 * past it, the pages that were used least recently are
+	 * removed first.
+	 *
+	 * There is only one cache, obtained through
+	 * `HttpCache::instance()`. It may be used from
+	 * any thread.
+	 **/
+	class AWEMC_BACKEND_LIBRARY HttpCache
+	{
+		public:
+			/**
+			 * \brief Get the cache.
+			 *
+			 * \returns The cache.
+			 **/
+			static HttpCache* instance();
+
+			/**
+			 * \brief Destroy this object.
+			 **/
+			~HttpCache();
+
+			/**
+			 * \brief Open (or create) the cache folder.
+			 *
+			 * Until this is called, nothing is found and
+			 * nothing is stored.
+			 *
+			 * \param folder The folder to keep the pages in.
+			 * \param maxBytes The total size of the pages.
+			 *
+			 * \returns `true` if pages were read from the
+			 *			folder's index, `false` otherwise.
+			 **/
+			bool open(QString folder, qint64 maxBytes);
+
+			/**
+			 * \brief Write the index of the pages back to
+			 *			the cache folder.
+			 *
+			 * \returns `true` if the index was written,
+			 *			`false` otherwise.
+			 **/
+			bool save();
+
+			/**
+			 * \brief Determine if the cache folder is open.
+			 *
+			 * \returns `true` if it is open, `false` otherwise.
+			 **/
+			bool isOpen() const;
+
+			/**
+			 * \brief Set the total size of the pages.
+			 *
+			 * \param maxBytes The new limit, in bytes.
+			 **/
+			void setMaxBytes(qint64 maxBytes);
+
+			/**
+			 * \brief Set how long pages stay fresh.
+			 *
+			 * \param seconds The time to live, in seconds.
+			 **/
+			void setTimeToLive(qint64 seconds);
+
+			/**
+			 * \brief Set how long pages from one host stay fresh.
+			 *
+			 * \param host The host, like `"thetvdb.com"`.
+			 * \param seconds The time to live, in seconds.
+			 **/
+			void setTimeToLive(QString host, qint64 seconds);
+
+			/**
+			 * \brief Get how long a page stays fresh.
+			 *
+			 * \param url The address of the page.
+			 *
+			 * \returns The time to live, in seconds.
+			 **/
+			qint64 getTimeToLive(QString url) const;
+
+			/**
+			 * \brief Determine if a page should be kept here.
+			 *
+			 * Only HTTP and HTTPS pages are kept.
+			 *
+			 * \param url The address of the page.
+			 *
+			 * \returns `true` if the page can be kept,
+			 *			`false` otherwise.
+			 **/
+			static bool isCacheable(QString url);
+
+			/**
+			 * \brief Get a page if it is still fresh.
+			 *
+			 * \param[in] url The address of the page.
+			 * \param[out] body The contents of the page.
+			 * \param[out] charset The character set the server
+			 *			sent, if it is wanted.
+			 *
+			 * \returns `true` if the page was found and is
+			 *			fresh, `false` otherwise.
+			 **/
+			bool findFresh(QString url, QByteArray* body,
+				QString* charset = nullptr);
+
+			/**
+			 * \brief Get what the server needs to tell whether
+			 *			a stale page changed.
+			 *
+			 * \param[in] url The address of the page.
+			 * \param[out] etag The `ETag` the server sent, if any.
+			 * \param[out] lastModified The `Last-Modified` time
+			 *			the server sent, if any.
+			 *
+			 * \returns `true` if the page is here and has at least
+			 *			one of the two, `false` otherwise.
+			 **/
+			bool findValidators(QString url, QString* etag,
+				QString* lastModified);
+
+			/**
+			 * \brief Mark a page as fresh again after the server
+			 *			said that it did not change.
+			 *
+			 * \param[in] url The address of the page.
+			 * \param[in] maxAge The `max-age` the server sent,
+			 *			or -1 if it did not send one.
+			 * \param[out] body The contents of the page.
+			 * \param[out] charset The character set the server
+			 *			sent, if it is wanted.
+			 *
+			 * \returns `true` if the page was read,
+			 *			`false` otherwise.
+			 **/
+			bool refresh(QString url, qint64 maxAge, QByteArray* body,
+				QString* charset = nullptr);
+
+			/**
+			 * \brief Keep a page that was just downloaded.
+			 *
+			 * \param url The address of the page.
+			 * \param body The contents of the page.
+			 * \param etag The `ETag` the server sent, if any.
+			 * \param lastModified The `Last-Modified` time the
+			 *			server sent, if any.
+			 * \param maxAge The `max-age` the server sent,
+			 *			or -1 if it did not send one.
+			 * \param charset The character set of the page,
+			 *			from its `Content-Type`.
+			 **/
+			void insert(QString url, QByteArray body, QString etag,
+				QString lastModified, qint64 maxAge = -1,
+				QString charset = QString());
+
+			/**
+			 * \brief Forget a page.
+			 *
+			 * \param url The address of the page.
+			 **/
+			void remove(QString url);
+
+			/**
+			 * \brief Forget every page.
+			 **/
+			void clear();
+
+			/**
+			 * \brief Get the number of pages kept.
+			 *
+			 * \returns The number of pages.
+			 **/
+			int count() const;
+
+			/**
+			 * \brief Get the total size of the pages kept.
+			 *
+			 * \returns The size, in bytes.
+			 **/
+			qint64 getBytes() const;
+
+		private:
+			/**
+			 * \brief Make the cache.
+			 **/
+			HttpCache();
+
+			/** \brief Internal data. **/
+			HttpCachePrivate* d;
+	};
+}
+
+#endif // HTTP_CACHE_H
@@ -0,0 +1,416 @@
+// header file
+#include "LibrarySnapshot.h"
+
+// for the snapshot file
+#include <QFile>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDir>
+#include <QDataStream>
+
+// for holding data
+#include <QHash>
+#include <QPair>
+#include <QByteArray>
+#include <cstring>
+
+// for checking files
+#include "FileInfoCache.h"
+
+// for thread safety
+#include <QMutex>
+#include <QMutexLocker>
+
+// for debug output
+#include <QDebug>
+
+using namespace JSON;
+
+namespace AWE
+{
+	/** \brief The start of every snapshot file. **/
+	static const char snapshotMagic[8] = { 'A', 'W', 'E', 'S', 'N', 'A', 'P', '1' };
+
+	/** \brief The tag that comes before every encoded value. **/
+	enum SnapshotTag
+	{
+		NullTag = 0,
+		FalseTag,
+		TrueTag,
+		NumberTag,
+		StringTag,
+		ArrayTag,
+		ObjectTag
+	};
+
+	/** \brief A file from the old snapshot, still in the mapped file. **/
+	struct SnapshotEntry
+	{
+		const uchar* blob;
+		quint32 length;
+		qint64 modified;
+		qint64 size;
+	};
+
+	class LibrarySnapshotPrivate
+	{
+		public:
+			// get the key for a file
+			QString keyFor(QString file) const;
+			// close without locking
+			void closeFile();
+
+			// encode/decode a value
+			static void encode(QDataStream& out, const JsonValue& value);
+			static JsonValue decode(QDataStream& in);
+
+			mutable QMutex mutex;
+
+			QFile file;
+			bool open;
+
+			// what was read from the file
+			QHash<QString, SnapshotEntry> entries;
+			// what was recorded this run, already encoded, along
+			// with when it was read or written
+			QHash<QString, QByteArray> recorded;
+			QHash<QString, QPair<qint64, qint64> > recordedStamps;
+	};
+}
+
+using namespace AWE;
+
+LibrarySnapshot* LibrarySnapshot::instance()
+{
+	static LibrarySnapshot snapshot;
+	return &snapshot;
+}
+
+LibrarySnapshot::LibrarySnapshot()
+	:	d(new LibrarySnapshotPrivate)
+{
+	d->open = false;
+}
+
+LibrarySnapshot::~LibrarySnapshot()
+{
+	close();
+	delete d;
+}
+
+bool LibrarySnapshot::open(QString file)
+{
+	close();
+	QMutexLocker lock(&d->mutex);
+	d->open = true;
+	d->file.setFileName(file);
+	if (!d->file.open(QIODevice::ReadOnly))
+	{
+		// it will be made when saved
+		return false;
+	}
+	qint64 length = d->file.size();
+	uchar* base = d->file.map(0, length);
+	if (!base || length < (qint64) sizeof(snapshotMagic)
+		|| memcmp(base, snapshotMagic, sizeof(snapshotMagic)) != 0)
+	{
+		qWarning() << "LibrarySnapshot: Ignoring bad snapshot" << file;
+		d->file.close();
+		return false;
+	}
+	// read the index, skipping over the contents
+	QByteArray bytes = QByteArray::fromRawData((const char*) base, length);
+	QDataStream in(bytes);
+	in.setVersion(QDataStream::Qt_5_0);
+	in.skipRawData(sizeof(snapshotMagic));
+	quint32 count;
+	in >> count;
+	for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++ i)
+	{
+		QString path;
+		SnapshotEntry entry;
+		in >> path >> entry.modified >> entry.size >> entry.length;
+		entry.blob = base + in.device()->pos();
+		if (in.skipRawData(entry.length) != (int) entry.length)
+		{
+			break;
+		}
+		d->entries[path] = entry;
+	}
+	if (in.status() != QDataStream::Ok)
+	{
+		qWarning() << "LibrarySnapshot: Snapshot" << file << "was cut short";
+	}
+	return true;
+}
+
+void LibrarySnapshot::close()
+{
+	QMutexLocker lock(&d->mutex);
+	d->closeFile();
+	d->recorded.clear();
+	d->recordedStamps.clear();
+	d->open = false;
+}
+
+bool LibrarySnapshot::isOpen() const
+{
+	QMutexLocker lock(&d->mutex);
+	return d->open;
+}
+
+bool LibrarySnapshot::find(QString file, JsonValue* data)
+{
+	QString key = d->keyFor(file);
+	SnapshotEntry entry;
+	{
+		QMutexLocker lock(&d->mutex);
+		if (!d->entries.contains(key))
+		{
+			return false;
+		}
+		entry = d->entries[key];
+	}
+	// make sure the file has not changed since, which needs
+	// a real look at the file, since it may be edited in place
+	if (!FileInfoCache::instance()->exists(key))
+	{
+		return false;
+	}
+	QFileInfo info(key);
+	if (!info.exists() || info.size() != entry.size
+		|| info.lastModified().toMSecsSinceEpoch() != entry.modified)
+	{
+		return false;
+	}
+	// copied while the mapped file is sure to stay put, so
+	// that other threads can decode at the same time
+	QByteArray bytes;
+	{
+		QMutexLocker lock(&d->mutex);
+		if (!d->entries.contains(key) || d->entries[key].blob != entry.blob)
+		{
+			return false;
+		}
+		bytes = QByteArray((const char*) entry.blob, entry.length);
+	}
+	QDataStream in(bytes);
+	in.setVersion(QDataStream::Qt_5_0);
+	JsonValue ans = LibrarySnapshotPrivate::decode(in);
+	if (in.status() != QDataStream::Ok)
+	{
+		return false;
+	}
+	*data = ans;
+	return true;
+}
+
+void LibrarySnapshot::record(QString file, JsonValue data,
+	qint64 modified, qint64 size)
+{
+	if (modified < 0 || size < 0)
+	{
+		return;
+	}
+	QByteArray bytes;
+	QDataStream out(&bytes, QIODevice::WriteOnly);
+	out.setVersion(QDataStream::Qt_5_0);
+	LibrarySnapshotPrivate::encode(out, data);
+	QString key = d->keyFor(file);
+	QMutexLocker lock(&d->mutex);
+	if (d->open)
+	{
+		d->recorded[key] = bytes;
+		d->recordedStamps[key] = qMakePair(modified, size);
+	}
+}
+
+bool LibrarySnapshot::save()
+{
+	QMutexLocker lock(&d->mutex);
+	if (!d->open)
+	{
+		return false;
+	}
+	QString path = d->file.fileName();
+	// the old entries that were not replaced are copied out
+	// of the mapped file, since it is about to be replaced;
+	// files that were deleted are left out
+	FileInfoCache* files = FileInfoCache::instance();
+	QHash<QString, SnapshotEntry> entries;
+	QHash<QString, QByteArray> blobs;
+	for (auto i = d->entries.constBegin(); i != d->entries.constEnd(); ++ i)
+	{
+		if (!d->recorded.contains(i.key()) && files->exists(i.key()))
+		{
+			entries[i.key()] = i.value();
+			blobs[i.key()] = QByteArray((const char*) i.value().blob,
+				i.value().length);
+		}
+	}
+	// recorded files keep the time and size from when their
+	// contents were read or written, so a file changed since
+	// then does not match next time
+	for (auto i = d->recorded.constBegin(); i != d->recorded.constEnd(); ++ i)
+	{
+		if (files->exists(i.key()))
+		{
+			SnapshotEntry entry;
+			entry.blob = nullptr;
+			entry.length = i.value().size();
+			entry.modified = d->recordedStamps[i.key()].first;
+			entry.size = d->recordedStamps[i.key()].second;
+			entries[i.key()] = entry;
+			blobs[i.key()] = i.value();
+		}
+	}
+	d->closeFile();
+	d->recorded.clear();
+	d->recordedStamps.clear();
+	d->open = false;
+
+	// write everything to a temporary file and swap it in
+	QDir().mkpath(QFileInfo(path).absolutePath());
+	QSaveFile out(path);
+	if (!out.open(QIODevice::WriteOnly))
+	{
+		qWarning() << "LibrarySnapshot: Could not write" << path;
+		return false;
+	}
+	out.write(snapshotMagic, sizeof(snapshotMagic));
+	QDataStream stream(&out);
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream << (quint32) entries.count();
+	for (auto i = entries.constBegin(); i != entries.constEnd(); ++ i)
+	{
+		const QByteArray& blob = blobs[i.key()];
+		stream << i.key() << i.value().modified << i.value().size
+			<< (quint32) blob.size();
+		stream.writeRawData(blob.constData(), blob.size());
+	}
+	if (stream.status() != QDataStream::Ok || !out.commit())
+	{
+		qWarning() << "LibrarySnapshot: Could not write" << path;
+		return false;
+	}
+	FileInfoCache::instance()->invalidate(path);
+	return true;
+}
+
+int LibrarySnapshot::count() const
+{
+	QMutexLocker lock(&d->mutex);
+	return d->entries.count();
+}
+
+QString LibrarySnapshotPrivate::keyFor(QString file) const
+{
+	return FileInfoCache::resolve(file);
+}
+
+void LibrarySnapshotPrivate::closeFile()
+{
+	entries.clear();
+	if (file.isOpen())
+	{
+		// unmaps everything too
+		file.close();
+	}
+}
+
+void LibrarySnapshotPrivate::encode(QDataStream& out, const JsonValue& value)
+{
+	JsonValue copy = value;
+	switch (copy.getType())
+	{
+		case JsonValue::Boolean:
+			out << (quint8) (copy.toBoolean() ? TrueTag : FalseTag);
+			break;
+		case JsonValue::Number:
+			out << (quint8) NumberTag << copy.toDouble();
+			break;
+		case JsonValue::String:
+			out << (quint8) StringTag << copy.toString();
+			break;
+		case JsonValue::Array:
+		{
+			const JsonArray arr = copy.toArray();
+			out << (quint8) ArrayTag << (quint32) arr.count();
+			for (int i = 0; i < arr.count(); ++ i)
+			{
+				encode(out, arr.at(i));
+			}
+			break;
+		}
+		case JsonValue::Object:
+		{
+			const JsonObject obj = copy.toObject();
+			QList<QString> keys = obj.keys();
+			out << (quint8) ObjectTag << (quint32) keys.count();
+			for (auto key : keys)
+			{
+				out << key;
+				encode(out, obj.value(key));
+			}
+			break;
+		}
+		default:
+			out << (quint8) NullTag;
+			break;
+	}
+}
+
+JsonValue LibrarySnapshotPrivate::decode(QDataStream& in)
+{
+	quint8 tag;
+	in >> tag;
+	switch (tag)
+	{
+		case FalseTag:
+			return JsonValue(false);
+		case TrueTag:
+			return JsonValue(true);
+		case NumberTag:
+		{
+			double number;
+			in >> number;
+			return JsonValue(number);
+		}
+		case StringTag:
+		{
+			QString string;
+			in >> string;
+			return JsonValue(string);
+		}
+		case ArrayTag:
+		{
+			quint32 count;
+			in >> count;
+			JsonValue ans(JsonValue::Array);
+			for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++ i)
+			{
+				ans.toArray().append(decode(in));
+			}
+			return ans;
+		}
+		case ObjectTag:
+		{
+			quint32 count;
+			in >> count;
+			JsonValue ans(JsonValue::Object);
+			for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++ i)
+			{
+				QString key;
+				in >> key;
+				ans.toObject()[key] = decode(in);
+			}
+			return ans;
+		}
+		case NullTag:
+			return JsonValue(JsonValue::Null);
+		default:
+			in.setStatus(QDataStream::ReadCorruptData);
+			return JsonValue(JsonValue::Null);
+	}
+}
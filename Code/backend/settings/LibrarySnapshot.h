@@ -0,0 +1,138 @@
+#ifndef LIBRARY_SNAPSHOT_H
+#define LIBRARY_SNAPSHOT_H
+
+// for the library
+#include "macros/BackendLibraryMacros.h"
+
+// for holding data
+#include <QString>
+#include <JsonDataTree/Json.h>
+
+namespace AWE
+{
+	// internal data
+	class LibrarySnapshotPrivate;
+
+	/**
+	 * \brief A compiled copy of every configuration file
+	 *			that was read in the last run.
+	 *
+	 * The snapshot is a single binary file that is
+	 * memory-mapped at startup. Each entry holds the
+	 * already parsed contents of one `ConfigFile` (so
+	 * names, types, locations, images, details and folder
+	 * contents all come with it), along with the modification
+	 * time and size the file had when the entry was made.
+	 *
+	 * `ConfigFile` asks the snapshot first, and only reads
+	 * and parses the JSON file if there is no entry for it
+	 * or the file has changed since.
+	 *
+	 * There is only one snapshot, obtained through
+	 * `LibrarySnapshot::instance()`. It may be used from
+	 * any thread.
+	 **/
+	class AWEMC_BACKEND_LIBRARY LibrarySnapshot
+	{
+		public:
+			/**
+			 * \brief Get the snapshot.
+			 *
+			 * \returns The snapshot.
+			 **/
+			static LibrarySnapshot* instance();
+
+			/**
+			 * \brief Destroy this object, closing the file.
+			 **/
+			~LibrarySnapshot();
+
+			/**
+			 * \brief Open the snapshot file.
+			 *
+			 * If the file does not exist or is not a snapshot,
+			 * the snapshot starts out empty and `save()` will
+			 * make it.
+			 *
+			 * \param file The path to the snapshot file.
+			 *
+			 * \returns `true` if entries were read from the file,
+			 *			`false` otherwise.
+			 **/
+			bool open(QString file);
+
+			/**
+			 * \brief Close the snapshot file without saving.
+			 **/
+			void close();
+
+			/**
+			 * \brief Determine if the snapshot is open.
+			 *
+			 * \returns `true` if it is open, `false` otherwise.
+			 **/
+			bool isOpen() const;
+
+			/**
+			 * \brief Get the contents of a configuration file
+			 *			from the snapshot.
+			 *
+			 * \param[in] file The path to the configuration file.
+			 * \param[out] data Where to put the contents.
+			 *
+			 * \returns `true` if there was an entry for `file`
+			 *			and `file` has not changed since,
+			 *			`false` otherwise.
+			 **/
+			bool find(QString file, JSON::JsonValue* data);
+
+			/**
+			 * \brief Record the contents of a configuration file.
+			 *
+			 * This should be called whenever the file is read or
+			 * written, with the file's modification time and size
+			 * at that moment, so that the entry never matches a
+			 * file that was changed afterwards. The recorded
+			 * contents are written out by `save()`.
+			 *
+			 * \param file The path to the configuration file.
+			 * \param data The contents of the file.
+			 * \param modified The modification time of the file,
+			 *			in milliseconds since the epoch.
+			 * \param size The size of the file in bytes.
+			 **/
+			void record(QString file, JSON::JsonValue data,
+				qint64 modified, qint64 size);
+
+			/**
+			 * \brief Write the snapshot out and close it.
+			 *
+			 * Everything that was recorded is written, along with
+			 * the entries from the old snapshot that were not
+			 * replaced, leaving out files that no longer exist.
+			 * The file is replaced atomically.
+			 *
+			 * \returns `true` if the snapshot was written,
+			 *			`false` otherwise.
+			 **/
+			bool save();
+
+			/**
+			 * \brief Get the number of files in the snapshot.
+			 *
+			 * \returns The number of files.
+			 **/
+			int count() const;
+
+		private:
+			/**
+			 * \brief Make an empty, closed snapshot.
+			 **/
+			LibrarySnapshot();
+
+			/** \brief Internal data. **/
+			LibrarySnapshotPrivate* d;
+	};
+}
+
+#endif // LIBRARY_SNAPSHOT_H
@@ -0,0 +1,58 @@
+// header file
+#include "MetadataChanges.h"
+
+using namespace AWE;
+
+MetadataChanges::MetadataChanges()
+	:	fields(NoFields)
+{ }
+
+bool MetadataChanges::isEmpty() const
+{
+	return fields == NoFields;
+}
+
+MetadataChanges::Fields MetadataChanges::getFields() const
+{
+	return fields;
+}
+
+bool MetadataChanges::hasChanged(Field field) const
+{
+	return fields.testFlag(field);
+}
+
+QList<int> MetadataChanges::getAddedIcons() const
+{
+	return addedIcons;
+}
+
+QList<int> MetadataChanges::getRemovedIcons() const
+{
+	return removedIcons;
+}
+
+QList<int> MetadataChanges::getAddedFanarts() const
+{
+	return addedFanarts;
+}
+
+QList<int> MetadataChanges::getRemovedFanarts() const
+{
+	return removedFanarts;
+}
+
+QList<QString> MetadataChanges::getAddedDetails() const
+{
+	return addedDetails;
+}
+
+QList<QString> MetadataChanges::getChangedDetails() const
+{
+	return changedDetails;
+}
+
+QList<QString> MetadataChanges::getRemovedDetails() const
+{
+	return removedDetails;
+}
@@ -0,0 +1,146 @@
+#ifndef METADATA_CHANGES_H
+#define METADATA_CHANGES_H
+
+// for the library
+#include "macros/BackendLibraryMacros.h"
+
+// for holding data
+#include <QList>
+#include <QString>
+#include <QFlags>
+
+// for queued connections
+#include <QMetaType>
+
+namespace AWE
+{
+	/**
+	 * \brief Describes everything that changed in a
+	 *			`MetadataHolder` during one batch of edits.
+	 *
+	 * This is what `MetadataHolder::metadataChanged()` sends,
+	 * so that a widget can update itself once per batch
+	 * instead of once per edit.
+	 **/
+	class AWEMC_BACKEND_LIBRARY MetadataChanges
+	{
+		public:
+			/**
+			 * \brief The parts of the metadata that can change.
+			 **/
+			enum Field
+			{
+				NoFields = 0x0,
+				Name = 0x1,
+				Type = 0x2,
+				Description = 0x4,
+				Location = 0x8,
+				Icons = 0x10,
+				DefaultIcon = 0x20,
+				Fanarts = 0x40,
+				DefaultFanart = 0x80,
+				Details = 0x100
+			};
+			Q_DECLARE_FLAGS(Fields, Field)
+
+			/**
+			 * \brief Make an empty set of changes.
+			 **/
+			MetadataChanges();
+
+			/**
+			 * \brief Determine if nothing changed.
+			 *
+			 * \returns `true` if there are no changes,
+			 *			`false` otherwise.
+			 **/
+			bool isEmpty() const;
+
+			/**
+			 * \brief Get the parts of the metadata that changed.
+			 *
+			 * \returns The changed fields.
+			 **/
+			Fields getFields() const;
+
+			/**
+			 * \brief Determine if a part of the metadata changed.
+			 *
+			 * \param field The part to check.
+			 *
+			 * \returns `true` if `field` changed, `false` otherwise.
+			 **/
+			bool hasChanged(Field field) const;
+
+			/**
+			 * \brief Get the indices of the icons that were added,
+			 *			in the order they were added.
+			 *
+			 * \returns The added icon indices.
+			 **/
+			QList<int> getAddedIcons() const;
+
+			/**
+			 * \brief Get the indices of the icons that were removed,
+			 *			in the order they were removed.
+			 *
+			 * \returns The removed icon indices.
+			 **/
+			QList<int> getRemovedIcons() const;
+
+			/**
+			 * \brief Get the indices of the fanarts that were added,
+			 *			in the order they were added.
+			 *
+			 * \returns The added fanart indices.
+			 **/
+			QList<int> getAddedFanarts() const;
+
+			/**
+			 * \brief Get the indices of the fanarts that were removed,
+			 *			in the order they were removed.
+			 *
+			 * \returns The removed fanart indices.
+			 **/
+			QList<int> getRemovedFanarts() const;
+
+			/**
+			 * \brief Get the names of the details that were added.
+			 *
+			 * \returns The added detail names.
+			 **/
+			QList<QString> getAddedDetails() const;
+
+			/**
+			 * \brief Get the names of the details whose value
+			 *			changed.
+			 *
+			 * \returns The changed detail names.
+			 **/
+			QList<QString> getChangedDetails() const;
+
+			/**
+			 * \brief Get the names of the details that were removed.
+			 *
+			 * \returns The removed detail names.
+			 **/
+			QList<QString> getRemovedDetails() const;
+
+		private:
+			friend class MetadataHolderPrivate;
+
+			Fields fields;
+			QList<int> addedIcons;
+			QList<int> removedIcons;
+			QList<int> addedFanarts;
+			QList<int> removedFanarts;
+			QList<QString> addedDetails;
+			QList<QString> changedDetails;
+			QList<QString> removedDetails;
+	};
+}
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(AWE::MetadataChanges::Fields)
+Q_DECLARE_METATYPE(AWE::MetadataChanges)
+
+#endif // METADATA_CHANGES_H
@@ -4,10 +4,17 @@
 // for testing data
 #include <QDir>
 #include <QUrl>
+#include "FileInfoCache.h"
 
 // for reading files
 #include "libs/generic_file_reader/file_reader.h"
 
+// for decoding images
+#include "image/ImageLoader.h"
+
+// for sending signals later
+#include <functional>
+
 // for debug output
 #include <QDebug>
 
@@ -26,6 +33,27 @@ namespace AWE
 			// make a detail string for the given
 			// value
 			QString stringFor(JsonValue val) const;
+			// decode the given icon or fanart in the
+			// background and say so when it is ready
+			void requestIcon(ImageHandle image);
+			void requestFanart(ImageHandle image);
+
+			// record changes, to be announced when the
+			// transaction is committed
+			void changed(MetadataChanges::Field field);
+			void addedIcon(int index);
+			void removedIcon(int index);
+			void addedFanart(int index);
+			void removedFanart(int index);
+			void addedDetail(QString name);
+			void changedDetail(QString name, int index);
+			void removedDetail(QString name, int index);
+
+			int transactionDepth;
+			MetadataChanges changes;
+			// the signals for added and removed things,
+			// in the order they happened
+			QList<std::function<void ()>> pendingSignals;
 
 			ConfigFile* file;
 
@@ -34,12 +62,12 @@ namespace AWE
 			QString description;
 			QString location;
 
-			QList<QPixmap> iconImages;
+			QList<ImageHandle> iconImages;
 			QList<QString> iconFiles;
 			QList<bool> iconOwnership;
 			int defaultIconIndex;
 
-			QList<QPixmap> fanartImages;
+			QList<ImageHandle> fanartImages;
 			QList<QString> fanartFiles;
 			QList<bool> fanartOwnership;
 			int defaultFanartIndex;
@@ -53,6 +81,8 @@ using namespace AWE;
 
 void MetadataHolderPrivate::make(ConfigFile* f)
 {
+	// so metadataChanged() can be queued
+	qRegisterMetaType<MetadataChanges>("AWE::MetadataChanges");
 	// make the file
 	file = f;
 	if (!f)
@@ -66,6 +96,9 @@ void MetadataHolderPrivate::make(ConfigFile* f)
 		qWarning() << "MetadataHolder: Configuration file not valid";
 	}
 
+	// announce all of the repairs at once
+	p->beginTransaction();
+
 	// this is a flag to see if we should warn about the file
 	bool shouldWarnAboutFile = false;
 
@@ -184,12 +217,12 @@ void MetadataHolderPrivate::make(ConfigFile* f)
 	// get the description
 	description = file->getMember({"metadata", "description"}).toString();
 
+	// relative paths are relative to the config file
+	QString base = file->getPathToConfigFile().absolutePath();
+
 	// get the location
-	location = file->getMember({"metadata", "location"}).toString();
-	if (QDir(location).isRelative())
-	{
-		location = file->getPathToConfigFile().absoluteFilePath(location);
-	}
+	location = FileInfoCache::resolve(
+		file->getMember({"metadata", "location"}).toString(), base);
 
 	// get the icons
 	JsonObject icons = file->getMember({"metadata", "icons"}).toObject();
@@ -204,15 +237,13 @@ void MetadataHolderPrivate::make(ConfigFile* f)
 		// check for existence and add
 		if (files.at(index).isString())
 		{
-			QString str = files.at(index).toString();
-			if (QDir(str).isRelative())
-			{
-				str = file->getPathToConfigFile().absoluteFilePath(str);
-			}
-			if (QDir().exists(str))
+			QString str = FileInfoCache::resolve(files.at(index).toString(),
+				base);
+			if (FileInfoCache::instance()->exists(str))
 			{
-				QPixmap image(str);
-				if (!image.isNull())
+				// only the header is read here
+				ImageHandle image(str);
+				if (image.isValid())
 				{
 					iconFiles << str;
 					iconImages << image;
@@ -259,15 +290,13 @@ void MetadataHolderPrivate::make(ConfigFile* f)
 		// check for existence and add
 		if (files.at(index).isString())
 		{
-			QString str = files.at(index).toString();
-			if (QDir(str).isRelative())
-			{
-				str = file->getPathToConfigFile().absoluteFilePath(str);
-			}
-			if (QDir().exists(str))
+			QString str = FileInfoCache::resolve(files.at(index).toString(),
+				base);
+			if (FileInfoCache::instance()->exists(str))
 			{
-				QPixmap image(str);
-				if (!image.isNull())
+				// only the header is read here
+				ImageHandle image(str);
+				if (image.isValid())
 				{
 					fanartFiles << str;
 					fanartImages << image;
@@ -324,12 +353,15 @@ void MetadataHolderPrivate::make(ConfigFile* f)
 			<< "of config file" << file->getConfigFileName() << "."
 			<< "The file was edited to have all necessary members in the right format.";
 	}
+
+	p->commitTransaction();
 }
 
 MetadataHolder::MetadataHolder(QString file)
 	:	d(new MetadataHolderPrivate)
 {
 	d->p = this;
+	d->transactionDepth = 0;
 	d->make(new ConfigFile(file));
 }
 
@@ -337,6 +369,7 @@ MetadataHolder::MetadataHolder(ConfigFile* file)
 	:	d(new MetadataHolderPrivate)
 {
 	d->p = this;
+	d->transactionDepth = 0;
 	d->make(file);
 }
 
@@ -350,6 +383,73 @@ ConfigFile* MetadataHolder::getConfigFile()
 	return d->file;
 }
 
+void MetadataHolder::beginTransaction()
+{
+	++ d->transactionDepth;
+	if (d->file)
+	{
+		d->file->beginTransaction();
+	}
+}
+
+void MetadataHolder::commitTransaction()
+{
+	if (d->transactionDepth <= 0)
+	{
+		qWarning() << "MetadataHolder: Tried to commit without a transaction";
+		return;
+	}
+	if (d->file)
+	{
+		d->file->commitTransaction();
+	}
+	-- d->transactionDepth;
+	if (d->transactionDepth || d->changes.isEmpty())
+	{
+		return;
+	}
+	// take everything first, in case a slot starts another transaction
+	MetadataChanges changes = d->changes;
+	QList<std::function<void ()>> pendingSignals = d->pendingSignals;
+	d->changes = MetadataChanges();
+	d->pendingSignals.clear();
+	// each field is announced once, with its final value
+	if (changes.hasChanged(MetadataChanges::Name))
+	{
+		emit nameChanged(d->name);
+	}
+	if (changes.hasChanged(MetadataChanges::Type))
+	{
+		emit typeChanged(d->type);
+	}
+	if (changes.hasChanged(MetadataChanges::Description))
+	{
+		emit descriptionChanged(d->description);
+	}
+	if (changes.hasChanged(MetadataChanges::Location))
+	{
+		emit locationChanged(d->location);
+	}
+	if (changes.hasChanged(MetadataChanges::DefaultIcon))
+	{
+		emit defaultIconChanged(d->defaultIconIndex);
+	}
+	if (changes.hasChanged(MetadataChanges::DefaultFanart))
+	{
+		emit defaultFanartChanged(d->defaultFanartIndex);
+	}
+	for (auto sendSignal : pendingSignals)
+	{
+		sendSignal();
+	}
+	emit metadataChanged(changes);
+}
+
+bool MetadataHolder::isInTransaction() const
+{
+	return d->transactionDepth > 0;
+}
+
 QString MetadataHolder::getName() const
 {
 	return d->name;
@@ -370,6 +470,12 @@ QString MetadataHolder::getLocation() const
 	return d->location;
 }
 
+QString MetadataHolder::getImportPath() const
+{
+	return d->file->getPathToConfigFile()
+		.absoluteFilePath(d->file->getConfigFileName());
+}
+
 int MetadataHolder::numIcons() const
 {
 	return d->iconFiles.count();
@@ -381,6 +487,20 @@ QPixmap MetadataHolder::getIcon(int i) const
 	{
 		return QPixmap();
 	}
+	if (!d->iconImages[i].isLoaded())
+	{
+		d->requestIcon(d->iconImages[i]);
+		return QPixmap();
+	}
+	return d->iconImages[i].getPixmap();
+}
+
+ImageHandle MetadataHolder::getIconHandle(int i) const
+{
+	if (i < 0 || i >= numIcons())
+	{
+		return ImageHandle();
+	}
 	return d->iconImages[i];
 }
 
@@ -398,6 +518,11 @@ QPixmap MetadataHolder::getDefaultIcon() const
 	return getIcon(getDefaultIconIndex());
 }
 
+ImageHandle MetadataHolder::getDefaultIconHandle() const
+{
+	return getIconHandle(getDefaultIconIndex());
+}
+
 int MetadataHolder::getDefaultIconIndex() const
 {
 	return d->defaultIconIndex;
@@ -414,6 +539,20 @@ QPixmap MetadataHolder::getFanart(int i) const
 	{
 		return QPixmap();
 	}
+	if (!d->fanartImages[i].isLoaded())
+	{
+		d->requestFanart(d->fanartImages[i]);
+		return QPixmap();
+	}
+	return d->fanartImages[i].getPixmap();
+}
+
+ImageHandle MetadataHolder::getFanartHandle(int i) const
+{
+	if (i < 0 || i >= numFanarts())
+	{
+		return ImageHandle();
+	}
 	return d->fanartImages[i];
 }
 
@@ -431,6 +570,11 @@ QPixmap MetadataHolder::getDefaultFanart() const
 	return getFanart(getDefaultFanartIndex());
 }
 
+ImageHandle MetadataHolder::getDefaultFanartHandle() const
+{
+	return getFanartHandle(getDefaultFanartIndex());
+}
+
 int MetadataHolder::getDefaultFanartIndex() const
 {
 	return d->defaultFanartIndex;
@@ -487,9 +631,11 @@ void MetadataHolder::setName(QString name)
 {
 	if (name != d->name)
 	{
+		beginTransaction();
 		d->name = name;
 		d->file->setMember({"metadata", "name"}, name);
-		emit nameChanged(name);
+		d->changed(MetadataChanges::Name);
+		commitTransaction();
 	}
 }
 
@@ -497,9 +643,11 @@ void MetadataHolder::setType(QString type)
 {
 	if (type != d->type)
 	{
+		beginTransaction();
 		d->type = type;
 		d->file->setMember({"metadata", "type"}, type);
-		emit typeChanged(type);
+		d->changed(MetadataChanges::Type);
+		commitTransaction();
 	}
 }
 
@@ -507,9 +655,11 @@ void MetadataHolder::setDescription(QString description)
 {
 	if (description != d->description)
 	{
+		beginTransaction();
 		d->description = description;
 		d->file->setMember({"metadata", "description"}, description);
-		emit descriptionChanged(description);
+		d->changed(MetadataChanges::Description);
+		commitTransaction();
 	}
 }
 
@@ -517,9 +667,11 @@ void MetadataHolder::setLocation(QString location)
 {
 	if (location != d->location)
 	{
+		beginTransaction();
 		d->location = location;
 		d->file->setMember({"metadata", "location"}, location);
-		emit locationChanged(location);
+		d->changed(MetadataChanges::Location);
+		commitTransaction();
 	}
 }
 
@@ -532,9 +684,11 @@ bool MetadataHolder::setDefaultIconIndex(int i)
 	}
 	if (i != getDefaultIconIndex())
 	{
+		beginTransaction();
 		d->defaultIconIndex = i;
 		d->file->setMember({"metadata", "icons", "default"}, i);
-		emit defaultIconChanged(i);
+		d->changed(MetadataChanges::DefaultIcon);
+		commitTransaction();
 	}
 	return true;
 }
@@ -548,9 +702,10 @@ bool MetadataHolder::addIcon(QString file)
 		return importIcon(file);
 	}
 	// local file, so link to it
-	QPixmap image(file);
-	if (!image.isNull())
+	ImageHandle image(file);
+	if (image.isValid())
 	{
+		beginTransaction();
 		d->iconImages << image;
 		d->iconFiles << file;
 		d->iconOwnership << false;
@@ -558,7 +713,8 @@ bool MetadataHolder::addIcon(QString file)
 			d->file->getPathToConfigFile().relativeFilePath(file));
 		d->file->appendValueToMember({"metadata", "icons", "owned"},
 			false);
-		emit iconAdded(image);
+		d->addedIcon(numIcons() - 1);
+		commitTransaction();
 		return true;
 	}
 	qWarning() << "MetadataHolder: Tried to add bad icon file";
@@ -579,15 +735,19 @@ bool MetadataHolder::importIcon(QString file)
 		+ extension;
 	// copy the file
 	QFile writeToMe(d->file->getPathToConfigFile().absoluteFilePath(fileName));
-	if (writeToMe.open(QIODevice::ReadWrite)
-		&& copyFile(file, writeToMe))
-	{
-		writeToMe.close();
-		// succesfully copied, so try to open
-		QPixmap image(writeToMe.fileName());
-		if (!image.isNull())
+	bool copied = writeToMe.open(QIODevice::ReadWrite)
+		&& copyFile(file, writeToMe);
+	writeToMe.close();
+	// the file may have been rewritten in place
+	FileInfoCache::instance()->invalidate(writeToMe.fileName());
+	if (copied)
+	{
+		// succesfully copied, so check the header
+		ImageHandle image(writeToMe.fileName());
+		if (image.isValid())
 		{
 			// it is a legit image, so add it
+			beginTransaction();
 			d->iconImages << image;
 			d->iconFiles << writeToMe.fileName();
 			d->iconOwnership << true;
@@ -595,13 +755,15 @@ bool MetadataHolder::importIcon(QString file)
 				fileName);
 			d->file->appendValueToMember({"metadata", "icons", "owned"},
 				true);
-			emit iconAdded(image);
+			d->addedIcon(numIcons() - 1);
+			commitTransaction();
 			return true;
 		}
 		else
 		{
 			// not a real image, so delete the imported file
 			d->file->getPathToConfigFile().remove(fileName);
+			FileInfoCache::instance()->invalidate(writeToMe.fileName());
 		}
 	}
 	// it didn't work
@@ -609,6 +771,30 @@ bool MetadataHolder::importIcon(QString file)
 	return false;
 }
 
+bool MetadataHolder::adoptIcon(QString file)
+{
+	ImageHandle image(file);
+	if (image.isValid())
+	{
+		beginTransaction();
+		d->iconImages << image;
+		d->iconFiles << file;
+		d->iconOwnership << true;
+		d->file->appendValueToMember({"metadata", "icons", "files"},
+			d->file->getPathToConfigFile().relativeFilePath(file));
+		d->file->appendValueToMember({"metadata", "icons", "owned"},
+			true);
+		d->addedIcon(numIcons() - 1);
+		commitTransaction();
+		return true;
+	}
+	// not a real image, so delete it
+	QDir::root().remove(file);
+	FileInfoCache::instance()->invalidate(file);
+	qWarning() << "MetadataHolder: Tried to adopt bad icon";
+	return false;
+}
+
 bool MetadataHolder::addIcon(QPixmap icon)
 {
 	if (!icon.isNull())
@@ -618,14 +804,19 @@ bool MetadataHolder::addIcon(QPixmap icon)
 			+ ".png";
 		if (icon.save(d->file->getPathToConfigFile().absoluteFilePath(fileName)))
 		{
-			d->iconImages << icon;
-			d->iconFiles << d->file->getPathToConfigFile().absoluteFilePath(fileName);
+			QString path = d->file->getPathToConfigFile().absoluteFilePath(fileName);
+			FileInfoCache::instance()->invalidate(path);
+			// already decoded, so keep it
+			beginTransaction();
+			d->iconImages << ImageHandle(path, icon.toImage());
+			d->iconFiles << path;
 			d->iconOwnership << true;
 			d->file->appendValueToMember({"metadata", "icons", "files"},
 				fileName);
 			d->file->appendValueToMember({"metadata", "icons", "owned"},
 				true);
-			emit iconAdded(icon);
+			d->addedIcon(numIcons() - 1);
+			commitTransaction();
 			return true;
 		}
 	}
@@ -646,10 +837,12 @@ bool MetadataHolder::removeIcon(int i)
 		qWarning() << "MetadataHolder: Tried to remove icon that did not exist";
 		return false;
 	}
+	beginTransaction();
 	// delete the file if necessary
 	if (d->iconOwnership[i])
 	{
 		QDir::root().remove(d->iconFiles[i]);
+		FileInfoCache::instance()->invalidate(d->iconFiles[i]);
 	}
 	// remove the icon
 	d->iconImages.removeAt(i);
@@ -667,8 +860,8 @@ bool MetadataHolder::removeIcon(int i)
 	{
 		setDefaultIconIndex(getDefaultIconIndex() - 1);
 	}
-	// emit signals
-	emit iconRemoved(i);
+	d->removedIcon(i);
+	commitTransaction();
 	return true;
 }
 
@@ -681,9 +874,11 @@ bool MetadataHolder::setDefaultFanartIndex(int i)
 	}
 	if (i != getDefaultFanartIndex())
 	{
+		beginTransaction();
 		d->defaultFanartIndex = i;
 		d->file->setMember({"metadata", "fanarts", "default"}, i);
-		emit defaultFanartChanged(i);
+		d->changed(MetadataChanges::DefaultFanart);
+		commitTransaction();
 	}
 	return true;
 }
@@ -697,9 +892,10 @@ bool MetadataHolder::addFanart(QString file)
 		return importFanart(file);
 	}
 	// local file, so link to it
-	QPixmap image(file);
-	if (!image.isNull())
+	ImageHandle image(file);
+	if (image.isValid())
 	{
+		beginTransaction();
 		d->fanartImages << image;
 		d->fanartFiles << file;
 		d->fanartOwnership << false;
@@ -707,7 +903,8 @@ bool MetadataHolder::addFanart(QString file)
 			d->file->getPathToConfigFile().relativeFilePath(file));
 		d->file->appendValueToMember({"metadata", "fanarts", "owned"},
 			false);
-		emit fanartAdded(image);
+		d->addedFanart(numFanarts() - 1);
+		commitTransaction();
 		return true;
 	}
 	qWarning() << "MetadataHolder: Tried to add bad fanart";
@@ -728,15 +925,19 @@ bool MetadataHolder::importFanart(QString file)
 		+ extension;
 	// copy the file
 	QFile writeToMe(d->file->getPathToConfigFile().absoluteFilePath(fileName));
-	if (writeToMe.open(QIODevice::ReadWrite)
-		&& copyFile(file, writeToMe))
-	{
-		writeToMe.close();
-		// succesfully copied, so try to open
-		QPixmap image(writeToMe.fileName());
-		if (!image.isNull())
+	bool copied = writeToMe.open(QIODevice::ReadWrite)
+		&& copyFile(file, writeToMe);
+	writeToMe.close();
+	// the file may have been rewritten in place
+	FileInfoCache::instance()->invalidate(writeToMe.fileName());
+	if (copied)
+	{
+		// succesfully copied, so check the header
+		ImageHandle image(writeToMe.fileName());
+		if (image.isValid())
 		{
 			// it is a legit image, so add it
+			beginTransaction();
 			d->fanartImages << image;
 			d->fanartFiles << writeToMe.fileName();
 			d->fanartOwnership << true;
@@ -744,13 +945,15 @@ bool MetadataHolder::importFanart(QString file)
 				fileName);
 			d->file->appendValueToMember({"metadata", "fanarts", "owned"},
 				true);
-			emit fanartAdded(image);
+			d->addedFanart(numFanarts() - 1);
+			commitTransaction();
 			return true;
 		}
 		else
 		{
 			// not a real image, so delete the imported file
 			d->file->getPathToConfigFile().remove(fileName);
+			FileInfoCache::instance()->invalidate(writeToMe.fileName());
 		}
 	}
 	// it didn't work
@@ -758,6 +961,30 @@ bool MetadataHolder::importFanart(QString file)
 	return false;
 }
 
+bool MetadataHolder::adoptFanart(QString file)
+{
+	ImageHandle image(file);
+	if (image.isValid())
+	{
+		beginTransaction();
+		d->fanartImages << image;
+		d->fanartFiles << file;
+		d->fanartOwnership << true;
+		d->file->appendValueToMember({"metadata", "fanarts", "files"},
+			d->file->getPathToConfigFile().relativeFilePath(file));
+		d->file->appendValueToMember({"metadata", "fanarts", "owned"},
+			true);
+		d->addedFanart(numFanarts() - 1);
+		commitTransaction();
+		return true;
+	}
+	// not a real image, so delete it
+	QDir::root().remove(file);
+	FileInfoCache::instance()->invalidate(file);
+	qWarning() << "MetadataHolder: Tried to adopt bad fanart";
+	return false;
+}
+
 bool MetadataHolder::addFanart(QPixmap fanart)
 {
 	if (!fanart.isNull())
@@ -767,14 +994,19 @@ bool MetadataHolder::addFanart(QPixmap fanart)
 			+ ".png";
 		if (fanart.save(d->file->getPathToConfigFile().absoluteFilePath(fileName)))
 		{
-			d->fanartImages << fanart;
-			d->fanartFiles << d->file->getPathToConfigFile().absoluteFilePath(fileName);
+			QString path = d->file->getPathToConfigFile().absoluteFilePath(fileName);
+			FileInfoCache::instance()->invalidate(path);
+			// already decoded, so keep it
+			beginTransaction();
+			d->fanartImages << ImageHandle(path, fanart.toImage());
+			d->fanartFiles << path;
 			d->fanartOwnership << true;
 			d->file->appendValueToMember({"metadata", "fanarts", "files"},
 				fileName);
 			d->file->appendValueToMember({"metadata", "fanarts", "owned"},
 				true);
-			emit fanartAdded(fanart);
+			d->addedFanart(numFanarts() - 1);
+			commitTransaction();
 			return true;
 		}
 	}
@@ -795,10 +1027,12 @@ bool MetadataHolder::removeFanart(int i)
 		qWarning() << "MetadataHolder: Tried to remove fanart that did not exist";
 		return false;
 	}
+	beginTransaction();
 	// delete the file if necessary
 	if (d->fanartOwnership[i])
 	{
 		QDir::root().remove(d->fanartFiles[i]);
+		FileInfoCache::instance()->invalidate(d->fanartFiles[i]);
 	}
 	// remove the icon
 	d->fanartImages.removeAt(i);
@@ -816,13 +1050,14 @@ bool MetadataHolder::removeFanart(int i)
 	{
 		setDefaultFanartIndex(getDefaultFanartIndex() - 1);
 	}
-	// emit signals
-	emit fanartRemoved(i);
+	d->removedFanart(i);
+	commitTransaction();
 	return true;
 }
 
 void MetadataHolder::addDetail(QString name, JsonValue value)
 {
+	beginTransaction();
 	if (hasDetail(name))
 	{
 		d->detailValues[name] = value;
@@ -834,8 +1069,7 @@ void MetadataHolder::addDetail(QString name, JsonValue value)
 		{
 			d->file->setMember({"metadata", "details", name}, value);	
 		}
-		emit detailChanged(name);
-		emit detailChanged(d->detailNames.indexOf(name));
+		d->changedDetail(name, d->detailNames.indexOf(name));
 	}
 	else
 	{
@@ -843,8 +1077,9 @@ void MetadataHolder::addDetail(QString name, JsonValue value)
 		d->file->appendValueToMember({"metadata", "details", "_order"}, name);
 		d->detailValues[name] = value;
 		d->file->appendValueToMember({"metadata", "details"}, name, value);
-		emit detailAdded(name);
+		d->addedDetail(name);
 	}
+	commitTransaction();
 }
 
 bool MetadataHolder::removeDetail(int i)
@@ -854,6 +1089,7 @@ bool MetadataHolder::removeDetail(int i)
 		qWarning() << "MetadataHolder: Tried to remove detail that did not exist";
 		return false;
 	}
+	beginTransaction();
 	// remove the detail value
 	QString name = d->detailNames[i];
 	d->detailValues.remove(name);
@@ -861,8 +1097,8 @@ bool MetadataHolder::removeDetail(int i)
 	// remove the detail name
 	d->detailNames.removeAt(i);
 	d->file->removeMember({"metadata", "details", "_order", i});
-	detailRemoved(i);
-	detailRemoved(name);
+	d->removedDetail(name, i);
+	commitTransaction();
 	return true;
 }
 
@@ -873,6 +1109,7 @@ bool MetadataHolder::removeDetail(QString name)
 		qWarning() << "MetadataHolder: Tried to remove detail that did not exist";
 		return false;
 	}
+	beginTransaction();
 	// remove the detail value
 	d->detailValues.remove(name);
 	d->file->removeMember({"metadata", "details", name});
@@ -880,11 +1117,122 @@ bool MetadataHolder::removeDetail(QString name)
 	int i = d->detailNames.indexOf(name);
 	d->detailNames.removeAt(i);
 	d->file->removeMember({"metadata", "details", "_order", i});
-	detailRemoved(i);
-	detailRemoved(name);
+	d->removedDetail(name, i);
+	commitTransaction();
 	return true;
 }
 
+void MetadataHolderPrivate::requestIcon(ImageHandle image)
+{
+	// someone already asked for it
+	if (image.isLoading())
+	{
+		return;
+	}
+	image.load(p, [this, image] ()
+		{
+			// the icon may have moved while it was loading
+			int index = iconImages.indexOf(image);
+			if (index != -1)
+			{
+				emit p->iconLoaded(index);
+			}
+		});
+}
+
+void MetadataHolderPrivate::requestFanart(ImageHandle image)
+{
+	// someone already asked for it
+	if (image.isLoading())
+	{
+		return;
+	}
+	image.load(p, [this, image] ()
+		{
+			// the fanart may have moved while it was loading
+			int index = fanartImages.indexOf(image);
+			if (index != -1)
+			{
+				emit p->fanartLoaded(index);
+			}
+		});
+}
+
+void MetadataHolderPrivate::changed(MetadataChanges::Field field)
+{
+	changes.fields |= field;
+}
+
+void MetadataHolderPrivate::addedIcon(int index)
+{
+	changes.fields |= MetadataChanges::Icons;
+	changes.addedIcons << index;
+	pendingSignals << [this, index] () { emit p->iconAdded(index); };
+}
+
+void MetadataHolderPrivate::removedIcon(int index)
+{
+	changes.fields |= MetadataChanges::Icons;
+	changes.removedIcons << index;
+	pendingSignals << [this, index] () { emit p->iconRemoved(index); };
+}
+
+void MetadataHolderPrivate::addedFanart(int index)
+{
+	changes.fields |= MetadataChanges::Fanarts;
+	changes.addedFanarts << index;
+	pendingSignals << [this, index] () { emit p->fanartAdded(index); };
+}
+
+void MetadataHolderPrivate::removedFanart(int index)
+{
+	changes.fields |= MetadataChanges::Fanarts;
+	changes.removedFanarts << index;
+	pendingSignals << [this, index] () { emit p->fanartRemoved(index); };
+}
+
+void MetadataHolderPrivate::addedDetail(QString name)
+{
+	changes.fields |= MetadataChanges::Details;
+	if (!changes.addedDetails.contains(name))
+	{
+		changes.addedDetails << name;
+	}
+	pendingSignals << [this, name] () { emit p->detailAdded(name); };
+}
+
+void MetadataHolderPrivate::changedDetail(QString name, int index)
+{
+	changes.fields |= MetadataChanges::Details;
+	// a detail added in the same batch is just added
+	if (!changes.addedDetails.contains(name)
+		&& !changes.changedDetails.contains(name))
+	{
+		changes.changedDetails << name;
+	}
+	pendingSignals << [this, name, index] ()
+		{
+			emit p->detailChanged(name);
+			emit p->detailChanged(index);
+		};
+}
+
+void MetadataHolderPrivate::removedDetail(QString name, int index)
+{
+	changes.fields |= MetadataChanges::Details;
+	changes.addedDetails.removeAll(name);
+	changes.changedDetails.removeAll(name);
+	if (!changes.removedDetails.contains(name))
+	{
+		changes.removedDetails << name;
+	}
+	pendingSignals << [this, name, index] ()
+		{
+			emit p->detailRemoved(index);
+			emit p->detailRemoved(name);
+		};
+}
+
 QString MetadataHolderPrivate::stringFor(JsonValue value) const
 {
 	QString ans;
@@ -8,6 +8,8 @@
 #include <QString>
 #include <QPixmap>
 #include "ConfigFile.h"
+#include "MetadataChanges.h"
+#include "image/ImageHandle.h"
 
 // for holding settings data
 #include <JsonDataTree/Json.h>
@@ -28,6 +30,12 @@ namespace AWE
 	 * standalone infos like name and description. In the
 	 * future, this could be expanded to include any number
 	 * of things, which makes this class extremely useful.
+	 *
+	 * Every change sends its own signal (like `nameChanged()`)
+	 * followed by `metadataChanged()`. When many changes are
+	 * made at once, they should be wrapped in `beginTransaction()`
+	 * and `commitTransaction()`, so that the signals are sent
+	 * once, when the transaction is committed.
 	 **/
 	class AWEMC_BACKEND_LIBRARY MetadataHolder : public QObject
 	{
@@ -140,6 +148,18 @@ namespace AWE
 			 **/
 			virtual QString getLocation() const;
 
+			/**
+			 * \brief Get where imported images are kept.
+			 *
+			 * Imported images are stored next to the
+			 * configuration file, named after it, like
+			 * `<returned path>.icon.0.png`.
+			 *
+			 * \returns The absolute path to the configuration
+			 *			file, which imported images start with.
+			 **/
+			virtual QString getImportPath() const;
+
 			/**
 			 * \brief Get the number of icons.
 			 *
@@ -150,12 +170,29 @@ namespace AWE
 			/**
 			 * \brief Get the `i`th icon.
 			 *
+			 * Images are decoded on demand. If the icon
+			 * has not been decoded yet, this starts decoding
+			 * it in the background, returns a null pixmap,
+			 * and `iconLoaded()` is sent once it is ready.
+			 *
 			 * \param i The icon to get.
 			 *
-			 * \returns The `i`th icon.
+			 * \returns The `i`th icon, or a null pixmap
+			 *			if it is not decoded yet.
 			 **/
 			virtual QPixmap getIcon(int i) const;
 
+			/**
+			 * \brief Get a handle to the `i`th icon.
+			 *
+			 * Getting the handle does not decode the image.
+			 *
+			 * \param i The icon to get.
+			 *
+			 * \returns A handle to the `i`th icon.
+			 **/
+			virtual ImageHandle getIconHandle(int i) const;
+
 			/**
 			 * \brief Get the `i`th icon file.
 			 *
@@ -172,6 +209,14 @@ namespace AWE
 			 **/
 			virtual QPixmap getDefaultIcon() const;
 
+			/**
+			 * \brief Get a handle to the default icon for
+			 *			this item.
+			 *
+			 * \returns A handle to the default icon.
+			 **/
+			virtual ImageHandle getDefaultIconHandle() const;
+
 			/**
 			 * \brief Get the default icon image's index.
 			 *
@@ -189,12 +234,29 @@ namespace AWE
 			/**
 			 * \brief Get the `i`th fanart.
 			 *
+			 * Images are decoded on demand. If the fanart
+			 * has not been decoded yet, this starts decoding
+			 * it in the background, returns a null pixmap,
+			 * and `fanartLoaded()` is sent once it is ready.
+			 *
 			 * \param i The fanart to get.
 			 *
-			 * \returns The `i`th fanart.
+			 * \returns The `i`th fanart, or a null pixmap
+			 *			if it is not decoded yet.
 			 **/
 			virtual QPixmap getFanart(int i) const;
 
+			/**
+			 * \brief Get a handle to the `i`th fanart.
+			 *
+			 * Getting the handle does not decode the image.
+			 *
+			 * \param i The fanart to get.
+			 *
+			 * \returns A handle to the `i`th fanart.
+			 **/
+			virtual ImageHandle getFanartHandle(int i) const;
+
 			/**
 			 * \brief Get the `i`th fanart file.
 			 *
@@ -211,6 +273,14 @@ namespace AWE
 			 **/
 			virtual QPixmap getDefaultFanart() const;
 
+			/**
+			 * \brief Get a handle to the default fanart for
+			 *			this item.
+			 *
+			 * \returns A handle to the default fanart.
+			 **/
+			virtual ImageHandle getDefaultFanartHandle() const;
+
 			/**
 			 * \brief Get the default fanart image's index.
 			 *
@@ -296,6 +366,39 @@ namespace AWE
 			 **/
 			virtual QString getDetailValueAsString(QString name) const;
 
+			/**
+			 * \brief Start a batch of changes.
+			 *
+			 * Until the matching `commitTransaction()`, no
+			 * signals are sent, including the configuration
+			 * file's `ConfigFile::dataChanged()`. Transactions
+			 * can be nested; only the outermost one counts.
+			 **/
+			virtual void beginTransaction();
+
+			/**
+			 * \brief Finish a batch of changes.
+			 *
+			 * If this ends the outermost transaction and
+			 * anything was changed during it, the signals
+			 * are sent: the name, type, description, location
+			 * and default image signals once each with their
+			 * final values, then the signals for added and
+			 * removed icons, fanarts and details in the order
+			 * they happened, and finally `metadataChanged()`
+			 * with everything that changed.
+			 **/
+			virtual void commitTransaction();
+
+			/**
+			 * \brief Determine if a batch of changes is
+			 *			in progress.
+			 *
+			 * \returns `true` if there is an open transaction,
+			 *			`false` otherwise.
+			 **/
+			virtual bool isInTransaction() const;
+
 		public slots:
 			/**
 			 * \brief Set the name of the item.
@@ -365,6 +468,22 @@ namespace AWE
 			 **/
 			virtual bool importIcon(QString file);
 
+			/**
+			 * \brief Add an icon that was already imported.
+			 *
+			 * This takes ownership of a local file that was
+			 * copied next to the configuration file ahead of
+			 * time (see `getImportPath()`), which lets the
+			 * slow copy happen away from the GUI thread.
+			 * If `file` is not a valid image, it is deleted.
+			 *
+			 * \param file The absolute path to the new icon file.
+			 *
+			 * \returns `true` if `file` is valid, and thus
+			 *			the icon was added, `false` if not.
+			 **/
+			virtual bool adoptIcon(QString file);
+
 			/**
 			 * \brief Add an icon for this item.
 			 *
@@ -442,6 +561,22 @@ namespace AWE
 			 **/
 			virtual bool importFanart(QString file);
 
+			/**
+			 * \brief Add an fanart that was already imported.
+			 *
+			 * This takes ownership of a local file that was
+			 * copied next to the configuration file ahead of
+			 * time (see `getImportPath()`), which lets the
+			 * slow copy happen away from the GUI thread.
+			 * If `file` is not a valid image, it is deleted.
+			 *
+			 * \param file The absolute path to the new fanart file.
+			 *
+			 * \returns `true` if `file` is valid, and thus
+			 *			the fanart was added, `false` if not.
+			 **/
+			virtual bool adoptFanart(QString file);
+
 			/**
 			 * \brief Add an fanart for this item.
 			 *
@@ -521,6 +656,14 @@ namespace AWE
 			virtual bool removeDetail(QString name);
 
 		signals:
+			/**
+			 * \brief Sent once per batch of changes, after
+			 *			all of the other signals.
+			 *
+			 * \param changes Everything that changed.
+			 **/
+			void metadataChanged(AWE::MetadataChanges changes);
+
 			/**
 			 * \brief Sent when the name is changed.
 			 *
@@ -552,9 +695,16 @@ namespace AWE
 			/**
 			 * \brief Sent when an icon is added.
 			 *
-			 * \param icon The added icon.
+			 * \param index The index of the added icon.
 			 **/
-			void iconAdded(QPixmap icon);
+			void iconAdded(int index);
+
+			/**
+			 * \brief Sent when an icon has been decoded.
+			 *
+			 * \param index The index of the decoded icon.
+			 **/
+			void iconLoaded(int index);
 
 			/**
 			 * \brief Sent when an icon is removed.
@@ -573,9 +723,16 @@ namespace AWE
 			/**
 			 * \brief Sent when a fanart image is added.
 			 *
-			 * \param fanart The added fanart image.
+			 * \param index The index of the added fanart.
+			 **/
+			void fanartAdded(int index);
+
+			/**
+			 * \brief Sent when a fanart image has been decoded.
+			 *
+			 * \param index The index of the decoded fanart.
 			 **/
-			void fanartAdded(QPixmap fanart);
+			void fanartLoaded(int index);
 
 			/**
 			 * \brief Sent when a fanart image is removed.
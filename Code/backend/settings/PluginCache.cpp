@@ -0,0 +1,294 @@
+// header file
+#include "PluginCache.h"
+
+// for the cache file
+#include <QFile>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QDir>
+#include <QDataStream>
+
+// for reading plugin metadata
+#include <QPluginLoader>
+#include <QJsonDocument>
+
+// for holding data
+#include <QHash>
+#include <QPair>
+#include <QByteArray>
+#include <cstring>
+
+// for checking files
+#include "FileInfoCache.h"
+
+// for thread safety
+#include <QMutex>
+#include <QMutexLocker>
+
+// for debug output
+#include <QDebug>
+
+namespace AWE
+{
+	/** \brief The start of every plugin cache file. **/
+	static const char pluginCacheMagic[8] = { 'A', 'W', 'E', 'P', 'L', 'U', 'G', '1' };
+
+	/** \brief The size and modification time of a file. **/
+	struct PluginFileStat
+	{
+		qint64 size;
+		qint64 modified;
+
+		bool operator==(const PluginFileStat& other) const
+		{
+			return size == other.size && modified == other.modified;
+		}
+	};
+
+	/** \brief The metadata declared by one plugin. **/
+	struct PluginMetaDataEntry
+	{
+		PluginFileStat plugin;
+		QJsonObject metaData;
+	};
+
+	/** \brief Whether one plugin worked with one config file. **/
+	struct PluginValidityEntry
+	{
+		PluginFileStat plugin;
+		PluginFileStat config;
+		bool valid;
+	};
+
+	class PluginCachePrivate
+	{
+		public:
+			// get the key for a plugin/config pair
+			static QString keyFor(QString plugin, QString config);
+			// get the size and modification time of a file
+			static PluginFileStat statOf(QString file);
+
+			mutable QMutex mutex;
+
+			QString file;
+			bool open;
+
+			QHash<QString, PluginMetaDataEntry> metaData;
+			QHash<QString, PluginValidityEntry> validity;
+			// the pairs checked this run, keyed like `validity`,
+			// holding the files they were checked with
+			QHash<QString, QPair<QString, QString> > recorded;
+	};
+}
+
+using namespace AWE;
+
+PluginCache* PluginCache::instance()
+{
+	static PluginCache cache;
+	return &cache;
+}
+
+PluginCache::PluginCache()
+	:	d(new PluginCachePrivate)
+{
+	d->open = false;
+}
+
+PluginCache::~PluginCache()
+{
+	delete d;
+}
+
+bool PluginCache::open(QString file)
+{
+	QMutexLocker lock(&d->mutex);
+	d->file = file;
+	d->open = true;
+	d->metaData.clear();
+	d->validity.clear();
+	d->recorded.clear();
+	QFile in(file);
+	if (!in.open(QIODevice::ReadOnly))
+	{
+		// it will be made when saved
+		return false;
+	}
+	char magic[sizeof(pluginCacheMagic)];
+	if (in.read(magic, sizeof(magic)) != (qint64) sizeof(magic)
+		|| memcmp(magic, pluginCacheMagic, sizeof(magic)) != 0)
+	{
+		qWarning() << "PluginCache: Ignoring bad plugin cache" << file;
+		return false;
+	}
+	QDataStream stream(&in);
+	stream.setVersion(QDataStream::Qt_5_0);
+	quint32 count;
+	stream >> count;
+	for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++ i)
+	{
+		QString plugin;
+		QByteArray json;
+		PluginMetaDataEntry entry;
+		stream >> plugin >> entry.plugin.size >> entry.plugin.modified >> json;
+		entry.metaData = QJsonDocument::fromJson(json).object();
+		d->metaData[plugin] = entry;
+	}
+	stream >> count;
+	for (quint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++ i)
+	{
+		QString key;
+		PluginValidityEntry entry;
+		stream >> key >> entry.plugin.size >> entry.plugin.modified
+			>> entry.config.size >> entry.config.modified >> entry.valid;
+		d->validity[key] = entry;
+	}
+	if (stream.status() != QDataStream::Ok)
+	{
+		qWarning() << "PluginCache: Plugin cache" << file << "was cut short";
+	}
+	return true;
+}
+
+bool PluginCache::save()
+{
+	QMutexLocker lock(&d->mutex);
+	if (!d->open)
+	{
+		return false;
+	}
+	// config files may have been written since they were
+	// checked, so they are looked at again now
+	for (auto i = d->recorded.constBegin(); i != d->recorded.constEnd(); ++ i)
+	{
+		auto entry = d->validity.find(i.key());
+		if (entry != d->validity.end())
+		{
+			QFileInfo plugin(i.value().first);
+			QFileInfo config(i.value().second);
+			entry->plugin.size = plugin.exists() ? plugin.size() : -1;
+			entry->plugin.modified = plugin.exists()
+				? plugin.lastModified().toMSecsSinceEpoch() : -1;
+			entry->config.size = config.exists() ? config.size() : -1;
+			entry->config.modified = config.exists()
+				? config.lastModified().toMSecsSinceEpoch() : -1;
+		}
+	}
+	d->recorded.clear();
+
+	// write everything to a temporary file and swap it in
+	QDir().mkpath(QFileInfo(d->file).absolutePath());
+	QSaveFile out(d->file);
+	if (!out.open(QIODevice::WriteOnly))
+	{
+		qWarning() << "PluginCache: Could not write" << d->file;
+		return false;
+	}
+	out.write(pluginCacheMagic, sizeof(pluginCacheMagic));
+	QDataStream stream(&out);
+	stream.setVersion(QDataStream::Qt_5_0);
+	stream << (quint32) d->metaData.count();
+	for (auto i = d->metaData.constBegin(); i != d->metaData.constEnd(); ++ i)
+	{
+		stream << i.key() << i.value().plugin.size << i.value().plugin.modified
+			<< QJsonDocument(i.value().metaData).toJson(QJsonDocument::Compact);
+	}
+	stream << (quint32) d->validity.count();
+	for (auto i = d->validity.constBegin(); i != d->validity.constEnd(); ++ i)
+	{
+		stream << i.key() << i.value().plugin.size << i.value().plugin.modified
+			<< i.value().config.size << i.value().config.modified
+			<< i.value().valid;
+	}
+	if (stream.status() != QDataStream::Ok || !out.commit())
+	{
+		qWarning() << "PluginCache: Could not write" << d->file;
+		return false;
+	}
+	FileInfoCache::instance()->invalidate(d->file);
+	return true;
+}
+
+bool PluginCache::findValidity(QString plugin, QString config, bool* valid)
+{
+	plugin = FileInfoCache::resolve(plugin);
+	config = FileInfoCache::resolve(config);
+	PluginValidityEntry entry;
+	{
+		QMutexLocker lock(&d->mutex);
+		auto i = d->validity.constFind(PluginCachePrivate::keyFor(plugin, config));
+		if (i == d->validity.constEnd())
+		{
+			return false;
+		}
+		entry = i.value();
+	}
+	// make sure neither file has changed since
+	if (!(PluginCachePrivate::statOf(plugin) == entry.plugin)
+		|| !(PluginCachePrivate::statOf(config) == entry.config))
+	{
+		return false;
+	}
+	*valid = entry.valid;
+	return true;
+}
+
+void PluginCache::recordValidity(QString plugin, QString config, bool valid)
+{
+	plugin = FileInfoCache::resolve(plugin);
+	config = FileInfoCache::resolve(config);
+	PluginValidityEntry entry;
+	entry.plugin = PluginCachePrivate::statOf(plugin);
+	entry.config = PluginCachePrivate::statOf(config);
+	entry.valid = valid;
+	QString key = PluginCachePrivate::keyFor(plugin, config);
+	QMutexLocker lock(&d->mutex);
+	d->validity[key] = entry;
+	d->recorded[key] = qMakePair(plugin, config);
+}
+
+QJsonObject PluginCache::getMetaData(QString plugin)
+{
+	plugin = FileInfoCache::resolve(plugin);
+	PluginFileStat stat = PluginCachePrivate::statOf(plugin);
+	{
+		QMutexLocker lock(&d->mutex);
+		auto i = d->metaData.constFind(plugin);
+		if (i != d->metaData.constEnd() && i->plugin == stat)
+		{
+			return i->metaData;
+		}
+	}
+	// only reads the file, the plugin is not loaded
+	PluginMetaDataEntry entry;
+	entry.plugin = stat;
+	if (stat.size != -1)
+	{
+		entry.metaData = QPluginLoader(plugin).metaData()
+			.value("MetaData").toObject();
+	}
+	QMutexLocker lock(&d->mutex);
+	d->metaData[plugin] = entry;
+	return entry.metaData;
+}
+
+int PluginCache::count() const
+{
+	QMutexLocker lock(&d->mutex);
+	return d->metaData.count() + d->validity.count();
+}
+
+QString PluginCachePrivate::keyFor(QString plugin, QString config)
+{
+	return plugin + '\n' + config;
+}
+
+PluginFileStat PluginCachePrivate::statOf(QString file)
+{
+	FileInfoCache* files = FileInfoCache::instance();
+	PluginFileStat stat;
+	stat.size = files->getSize(file);
+	stat.modified = files->getLastModified(file);
+	return stat;
+}
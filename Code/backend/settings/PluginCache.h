@@ -0,0 +1,132 @@
+#ifndef PLUGIN_CACHE_H
+#define PLUGIN_CACHE_H
+
+// for the library
+#include "macros/BackendLibraryMacros.h"
+
+// for holding data
+#include <QString>
+#include <QJsonObject>
+
+namespace AWE
+{
+	// internal data
+	class PluginCachePrivate;
+
+	/**
+	 * \brief Remembers what was learned about each plugin
+	 *			in earlier runs.
+	 *
+	 * Checking that a player or service plugin works means
+	 * loading the library, making the factory, making the
+	 * player or service, and unloading it all again. That is
+	 * slow, and it is the same answer every time unless the
+	 * plugin or its configuration file changes. So the answer
+	 * is kept here, along with the size and modification time
+	 * of both files, and is only worked out again when one
+	 * of them changes.
+	 *
+	 * The metadata a plugin declares with `Q_PLUGIN_METADATA`
+	 * is kept here too. Qt reads it without loading the plugin,
+	 * but it still opens the library to find it.
+	 *
+	 * There is only one cache, obtained through
+	 * `PluginCache::instance()`. It may be used from
+	 * any thread.
+	 **/
+	class AWEMC_BACKEND_LIBRARY PluginCache
+	{
+		public:
+			/**
+			 * \brief Get the cache.
+			 *
+			 * \returns The cache.
+			 **/
+			static PluginCache* instance();
+
+			/**
+			 * \brief Destroy this object.
+			 **/
+			~PluginCache();
+
+			/**
+			 * \brief Open the cache file.
+			 *
+			 * If the file does not exist or is not a plugin
+			 * cache, the cache starts out empty and `save()`
+			 * will make it.
+			 *
+			 * \param file The path to the cache file.
+			 *
+			 * \returns `true` if entries were read from the file,
+			 *			`false` otherwise.
+			 **/
+			bool open(QString file);
+
+			/**
+			 * \brief Write the cache back to its file.
+			 *
+			 * \returns `true` if the file was written,
+			 *			`false` otherwise.
+			 **/
+			bool save();
+
+			/**
+			 * \brief Find out if a plugin was valid the last
+			 *			time it was checked.
+			 *
+			 * \param[in] plugin The path to the plugin.
+			 * \param[in] config The path to the configuration
+			 *			file the plugin was checked with.
+			 * \param[out] valid Whether the plugin was valid.
+			 *
+			 * \returns `true` if the answer is known and neither
+			 *			file has changed since, `false` otherwise.
+			 **/
+			bool findValidity(QString plugin, QString config, bool* valid);
+
+			/**
+			 * \brief Remember whether a plugin is valid.
+			 *
+			 * \param plugin The path to the plugin.
+			 * \param config The path to the configuration
+			 *			file the plugin was checked with.
+			 * \param valid Whether the plugin is valid.
+			 **/
+			void recordValidity(QString plugin, QString config, bool valid);
+
+			/**
+			 * \brief Get the metadata that a plugin declares.
+			 *
+			 * This is the `"MetaData"` object of
+			 * `QPluginLoader::metaData()`, that is, the contents
+			 * of the JSON file named in `Q_PLUGIN_METADATA`.
+			 * The plugin is never loaded to get it.
+			 *
+			 * \param plugin The path to the plugin.
+			 *
+			 * \returns The metadata, which is empty if the plugin
+			 *			does not declare any or does not exist.
+			 **/
+			QJsonObject getMetaData(QString plugin);
+
+			/**
+			 * \brief Get the number of plugins and plugin/config
+			 *			pairs that are remembered.
+			 *
+			 * \returns The number of entries.
+			 **/
+			int count() const;
+
+		private:
+			/**
+			 * \brief Make the cache.
+			 **/
+			PluginCache();
+
+			/** \brief Internal data. **/
+			PluginCachePrivate* d;
+	};
+}
+
+#endif // PLUGIN_CACHE_H
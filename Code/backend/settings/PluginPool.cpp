@@ -0,0 +1,257 @@
+// header file
+#include "PluginPool.h"
+
+// for loading plugins
+#include <QPluginLoader>
+
+// for the keys
+#include "FileInfoCache.h"
+
+// for holding data
+#include <QHash>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QCoreApplication>
+
+// for debug output
+#include <QDebug>
+
+namespace AWE
+{
+	/** \brief A loaded plugin. **/
+	struct PoolEntry
+	{
+		QPluginLoader* loader;
+		int holds;
+		qint64 releasedAt;
+	};
+
+	class PluginPoolPrivate
+	{
+		public:
+			// unload one plugin
+			void unload(QString key);
+			// unload the least recently used idle plugins
+			// until there are few enough of them
+			void trim();
+			// start the timer for the next plugin to go idle
+			void scheduleUnload();
+
+			QHash<QString, PoolEntry> plugins;
+			QElapsedTimer clock;
+			QTimer timer;
+			int idleTimeout;
+			int maxIdle;
+
+			// statistics
+			int loads;
+			int hits;
+			qint64 loadTime;
+	};
+}
+
+using namespace AWE;
+
+PluginPool* PluginPool::instance()
+{
+	static PluginPool* pool = new PluginPool(QCoreApplication::instance());
+	return pool;
+}
+
+PluginPool::PluginPool(QObject* parent)
+	:	QObject(parent),
+		d(new PluginPoolPrivate)
+{
+	d->clock.start();
+	d->timer.setSingleShot(true);
+	d->idleTimeout = 30000;
+	d->maxIdle = 8;
+	d->loads = 0;
+	d->hits = 0;
+	d->loadTime = 0;
+	connect(&d->timer, &QTimer::timeout, this, &PluginPool::unloadIdle);
+}
+
+PluginPool::~PluginPool()
+{
+	clear();
+	delete d;
+}
+
+QObject* PluginPool::acquire(QString file)
+{
+	QString key = FileInfoCache::resolve(file);
+	auto i = d->plugins.find(key);
+	if (i != d->plugins.end())
+	{
+		++ d->hits;
+		++ i->holds;
+		return i->loader->instance();
+	}
+	// not loaded yet
+	QElapsedTimer timer;
+	timer.start();
+	QPluginLoader* loader = new QPluginLoader(key);
+	if (!loader->load())
+	{
+		delete loader;
+		return nullptr;
+	}
+	QObject* inst = loader->instance();
+	if (!inst)
+	{
+		loader->unload();
+		delete loader;
+		return nullptr;
+	}
+	qint64 elapsed = timer.elapsed();
+	++ d->loads;
+	d->loadTime += elapsed;
+	PoolEntry entry;
+	entry.loader = loader;
+	entry.holds = 1;
+	entry.releasedAt = 0;
+	d->plugins[key] = entry;
+	return inst;
+}
+
+void PluginPool::release(QString file)
+{
+	auto i = d->plugins.find(FileInfoCache::resolve(file));
+	if (i == d->plugins.end() || i->holds == 0)
+	{
+		qWarning() << "PluginPool: Released" << file << "without holding it";
+		return;
+	}
+	if (-- i->holds == 0)
+	{
+		i->releasedAt = d->clock.elapsed();
+		d->trim();
+		d->scheduleUnload();
+	}
+}
+
+void PluginPool::clear()
+{
+	for (auto key : d->plugins.keys())
+	{
+		if (d->plugins[key].holds == 0)
+		{
+			d->unload(key);
+		}
+	}
+	d->timer.stop();
+}
+
+void PluginPool::setIdleTimeout(int msec)
+{
+	d->idleTimeout = msec;
+	unloadIdle();
+}
+
+int PluginPool::getIdleTimeout() const
+{
+	return d->idleTimeout;
+}
+
+void PluginPool::setMaxIdle(int count)
+{
+	d->maxIdle = count;
+	d->trim();
+	d->scheduleUnload();
+}
+
+int PluginPool::getMaxIdle() const
+{
+	return d->maxIdle;
+}
+
+int PluginPool::numResident() const
+{
+	return d->plugins.count();
+}
+
+int PluginPool::numLoads() const
+{
+	return d->loads;
+}
+
+int PluginPool::numHits() const
+{
+	return d->hits;
+}
+
+qint64 PluginPool::getLoadTime() const
+{
+	return d->loadTime;
+}
+
+void PluginPool::unloadIdle()
+{
+	qint64 now = d->clock.elapsed();
+	for (auto key : d->plugins.keys())
+	{
+		const PoolEntry& entry = d->plugins[key];
+		if (entry.holds == 0 && now - entry.releasedAt >= d->idleTimeout)
+		{
+			d->unload(key);
+		}
+	}
+	d->scheduleUnload();
+}
+
+void PluginPoolPrivate::unload(QString key)
+{
+	QPluginLoader* loader = plugins.take(key).loader;
+	loader->unload();
+	delete loader;
+}
+
+void PluginPoolPrivate::trim()
+{
+	while (true)
+	{
+		// find the idle plugin that was released first
+		int numIdle = 0;
+		QString oldest;
+		qint64 oldestTime = 0;
+		for (auto i = plugins.constBegin(); i != plugins.constEnd(); ++ i)
+		{
+			if (i->holds == 0)
+			{
+				if (numIdle == 0 || i->releasedAt < oldestTime)
+				{
+					oldest = i.key();
+					oldestTime = i->releasedAt;
+				}
+				++ numIdle;
+			}
+		}
+		if (numIdle <= maxIdle)
+		{
+			return;
+		}
+		unload(oldest);
+	}
+}
+
+void PluginPoolPrivate::scheduleUnload()
+{
+	bool any = false;
+	qint64 oldestTime = 0;
+	for (auto i = plugins.constBegin(); i != plugins.constEnd(); ++ i)
+	{
+		if (i->holds == 0 && (!any || i->releasedAt < oldestTime))
+		{
+			any = true;
+			oldestTime = i->releasedAt;
+		}
+	}
+	if (!any)
+	{
+		timer.stop();
+		return;
+	}
+	qint64 wait = oldestTime + idleTimeout - clock.elapsed();
+	timer.start((int) qMax((qint64) 0, wait));
+}
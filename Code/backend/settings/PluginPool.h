@@ -0,0 +1,172 @@
+#ifndef PLUGIN_POOL_H
+#define PLUGIN_POOL_H
+
+// for the library
+#include "macros/BackendLibraryMacros.h"
+
+// superclass
+#include <QObject>
+
+// for holding data
+#include <QString>
+
+namespace AWE
+{
+	// internal data
+	class PluginPoolPrivate;
+
+	/**
+	 * \brief Keeps recently used plugins loaded.
+	 *
+	 * Players, scrapers and services get their plugin from
+	 * the pool with `acquire()` and hand it back with
+	 * `release()` once everything they made from it is
+	 * gone. A plugin that nobody holds stays loaded for
+	 * a while, so asking a player whether it can play
+	 * something (or opening a service again) does not
+	 * load and unload the library every time.
+	 *
+	 * A plugin is unloaded once it has not been held for
+	 * the idle timeout, or sooner if more plugins than the
+	 * limit are loaded, least recently used first. Plugins
+	 * that are held are never unloaded.
+	 *
+	 * There is only one pool, obtained through
+	 * `PluginPool::instance()`. It must be used from the
+	 * GUI thread.
+	 **/
+	class AWEMC_BACKEND_LIBRARY PluginPool : public QObject
+	{
+		Q_OBJECT
+
+		public:
+			/**
+			 * \brief Get the pool.
+			 *
+			 * \returns The pool.
+			 **/
+			static PluginPool* instance();
+
+			/**
+			 * \brief Destroy this object, unloading every
+			 *			plugin that is not held.
+			 **/
+			virtual ~PluginPool();
+
+			/**
+			 * \brief Get a plugin, loading it if necessary.
+			 *
+			 * Every successful call must be matched
+			 * by a call to `release()`.
+			 *
+			 * \param file The path to the plugin.
+			 *
+			 * \returns The plugin's root object, or `nullptr`
+			 *			if it could not be loaded.
+			 **/
+			virtual QObject* acquire(QString file);
+
+			/**
+			 * \brief Hand a plugin back.
+			 *
+			 * Anything made by the plugin must already
+			 * be deleted.
+			 *
+			 * \param file The path to the plugin.
+			 **/
+			virtual void release(QString file);
+
+			/**
+			 * \brief Unload every plugin that is not held.
+			 **/
+			virtual void clear();
+
+			/**
+			 * \brief Set how long a plugin stays loaded
+			 *			after it was last released.
+			 *
+			 * \param msec The timeout, in milliseconds.
+			 **/
+			virtual void setIdleTimeout(int msec);
+
+			/**
+			 * \brief Get how long a plugin stays loaded
+			 *			after it was last released.
+			 *
+			 * By default, this is thirty seconds.
+			 *
+			 * \returns The timeout, in milliseconds.
+			 **/
+			virtual int getIdleTimeout() const;
+
+			/**
+			 * \brief Set how many plugins may stay loaded
+			 *			without being held.
+			 *
+			 * \param count The number of plugins.
+			 **/
+			virtual void setMaxIdle(int count);
+
+			/**
+			 * \brief Get how many plugins may stay loaded
+			 *			without being held.
+			 *
+			 * By default, this is eight.
+			 *
+			 * \returns The number of plugins.
+			 **/
+			virtual int getMaxIdle() const;
+
+			/**
+			 * \brief Get the number of plugins that are loaded.
+			 *
+			 * \returns The number of plugins.
+			 **/
+			virtual int numResident() const;
+
+			/**
+			 * \brief Get the number of times a plugin
+			 *			was actually loaded.
+			 *
+			 * \returns The number of loads.
+			 **/
+			virtual int numLoads() const;
+
+			/**
+			 * \brief Get the number of times a plugin
+			 *			was already loaded when asked for.
+			 *
+			 * \returns The number of hits.
+			 **/
+			virtual int numHits() const;
+
+			/**
+			 * \brief Get the total time spent loading plugins.
+			 *
+			 * \returns The time, in milliseconds.
+			 **/
+			virtual qint64 getLoadTime() const;
+
+		private slots:
+			/**
+			 * \brief Unload the plugins that have been
+			 *			idle for too long.
+			 **/
+			void unloadIdle();
+
+		private:
+			friend class PluginPoolPrivate;
+
+			/**
+			 * \brief Make the pool.
+			 *
+			 * \param parent The parent object.
+			 **/
+			PluginPool(QObject* parent);
+
+			/** \brief Internal data. **/
+			PluginPoolPrivate* d;
+	};
+}
+
+#endif // PLUGIN_POOL_H
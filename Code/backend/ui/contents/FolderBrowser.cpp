@@ -10,14 +10,23 @@
 // media service class
 #include "items/MediaServiceHandler.h"
 
+// for scraping in the background
+#include "scraper/ScrapeJobManager.h"
+
 // settings
 #include "settings/AWEMC.h"
 
+// for watching the open folders
+#include "settings/FileInfoCache.h"
+#include <QFileInfo>
+
 // debug
 #include <QDebug>
 
 // internal data stuff
 #include <QStack>
+#include <QHash>
+#include <QPointer>
 
 // the layouts used
 #include <QStackedLayout>
@@ -52,6 +61,18 @@ namespace UI
 			/** \brief The folder browsing history. **/
 			QStack<AWE::Folder*> browserHistory;
 
+			/**
+			 * \brief Get the directory that holds a folder's
+			 *			files, which is watched while it is open.
+			 **/
+			static QString directoryOf(AWE::Folder* folder);
+
+			/** \brief The scrape jobs queued here, and their items. **/
+			QHash<int, QPointer<AWE::MetadataHolder> > scrapeJobs;
+
+			/** \brief Show how far the scrape jobs are in the title bar. **/
+			void showScrapeProgress();
+
 			// this is all UI stuff
 
 			/** \brief The stacked layout with everything on it. **/
@@ -135,11 +156,39 @@ FolderBrowser::FolderBrowser()
 	d->connect(d->folderPane, &FolderPane::goUpOne,
 							this, &FolderBrowser::moveUpOneFolder);
 	// changing the background image
-	d->connect(d->imagePane, &ImagePane::fanartChanged,
-							this, &FolderBrowser::setBackgroundImage);
+	d->connect(d->imagePane, &ImagePane::fanartChanged, this,
+		static_cast<void (FolderBrowser::*)(ImageHandle)>(
+			&FolderBrowser::setBackgroundImage));
 	// scrape for metadata
 	d->connect(d->infoPane, &InfoPane::wantsToScrapeForMetadata,
 							this, &FolderBrowser::scrapeForMetadata);
+	// follow the scrape jobs instead of waiting for them
+	ScrapeJobManager* jobs = ScrapeJobManager::instance();
+	d->connect(jobs, &ScrapeJobManager::progress,
+			d,		[this] (int job)
+					{
+						if (d->scrapeJobs.contains(job))
+						{
+							d->showScrapeProgress();
+						}
+					} );
+	d->connect(jobs, &ScrapeJobManager::finished,
+			d,		[this] (int job)
+					{
+						// the image pane follows its item's new images
+						if (d->scrapeJobs.remove(job))
+						{
+							d->showScrapeProgress();
+						}
+					} );
+	d->connect(jobs, &ScrapeJobManager::canceled,
+			d,		[this] (int job)
+					{
+						if (d->scrapeJobs.remove(job))
+						{
+							d->showScrapeProgress();
+						}
+					} );
 
 	// updating the background configuration
 	auto updateBackgroundBrush = [this] ()
@@ -159,6 +208,10 @@ FolderBrowser::FolderBrowser()
 
 FolderBrowser::~FolderBrowser()
 {
+	for (Folder* folder : d->browserHistory)
+	{
+		FileInfoCache::instance()->unwatch(FolderBrowserPrivate::directoryOf(folder));
+	}
 	delete d->imagePane;
 	delete d->folderPane;
 	delete d->infoPane;
@@ -215,11 +268,14 @@ void FolderBrowser::openItem(MediaItem* item)
 		d->folderPane->setFolder((Folder*) item);
 		// push it onto the stack
 		d->browserHistory.push((Folder*) item);
+		FileInfoCache::instance()->watch(
+			FolderBrowserPrivate::directoryOf((Folder*) item));
 		// change the title bar
 		setTitleBarText(item->getName());
 		// set the other two panes
 		d->imagePane->setItem(item);
 		d->infoPane->setItem(item);
+		d->showScrapeProgress();
 	}
 	else
 	{
@@ -242,14 +298,16 @@ void FolderBrowser::moveUpOneFolder()
 {
 	if (d->browserHistory.count() > 1)
 	{
-		d->browserHistory.pop();
+		FileInfoCache::instance()->unwatch(
+			FolderBrowserPrivate::directoryOf(d->browserHistory.pop()));
 		d->folderPane->setFolder(getCurrentFolder());
 		setTitleBarText(getCurrentFolder()->getName());
 		// get the background image
-		setBackgroundImage(getCurrentFolder()->getDefaultFanart());
+		setBackgroundImage(getCurrentFolder()->getDefaultFanartHandle());
 		// change the item for the other two panes
 		d->imagePane->setItem(getCurrentFolder());
 		d->infoPane->setItem(getCurrentFolder());
+		d->showScrapeProgress();
 	}
 }
 
@@ -263,27 +321,26 @@ void FolderBrowser::setBackgroundImage(QPixmap image)
 	d->backgroundImage->setImage(image);
 }
 
+void FolderBrowser::setBackgroundImage(ImageHandle image)
+{
+	d->backgroundImage->setImage(image);
+}
+
 void FolderBrowser::scrapeForMetadata(MetadataHolder* item,
     MetadataScraperHandler* scraper, MetadataScraper::ScraperSettings flags)
 {
-	// scrape
-	if (scraper->prepare())
+	// the user is waiting on this one
+	int job = ScrapeJobManager::instance()->enqueue(
+		QList<MetadataHolder*>() << item, scraper, flags,
+		ScrapeJobManager::High);
+	if (job == -1)
 	{
-		if (!scraper->addMetadata(item, flags))
-		{
-			// didn't work in its entirety
-			qWarning() << "FolderBrowser: Scraping failed for item"
-				<< item->getName();
-		}
-	}
-	else
-	{
-		// the scraper just flat out isn't valid
-		qWarning() << "FolderBrowser: Scraper" << scraper->getName()
-			<< "not valid.";
+		qWarning() << "FolderBrowser: Could not scrape item"
+			<< item->getName() << "with" << scraper->getName();
 		return;
 	}
-	scraper->deactivate();
+	d->scrapeJobs[job] = item;
+	d->showScrapeProgress();
 }
 
 void FolderBrowser::useConfig(JsonValue config)
@@ -299,9 +356,37 @@ void FolderBrowser::useDefaultConfig()
 		->getWidgetConfig("Foldser Browser"));
 }
 
+void FolderBrowserPrivate::showScrapeProgress()
+{
+	if (browserHistory.isEmpty())
+	{
+		return;
+	}
+	QString text = browserHistory.top()->getName();
+	if (!scrapeJobs.isEmpty())
+	{
+		ScrapeJobManager* jobs = ScrapeJobManager::instance();
+		int done = 0;
+		int total = 0;
+		for (auto job : scrapeJobs.keys())
+		{
+			done += qMax(jobs->getDone(job), 0);
+			total += qMax(jobs->getTotal(job), 0);
+		}
+		text = FolderBrowser::tr("%1 (getting metadata %2/%3)")
+			.arg(text).arg(done).arg(total);
+	}
+	titleBar->setText(text);
+}
+
+QString FolderBrowserPrivate::directoryOf(Folder* folder)
+{
+	return QFileInfo(folder->getImportPath()).absolutePath();
+}
+
 void FolderBrowserPrivate::paintEvent(QPaintEvent*)
 {
-	if (backgroundImage->getImage().isNull())
+	if (!backgroundImage->hasImage())
 	{
 		QPainter p(this);
 		p.setBrush(brush);
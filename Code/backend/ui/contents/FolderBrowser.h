@@ -115,9 +115,24 @@ namespace UI
 			 **/
 			virtual void setBackgroundImage(QPixmap image);
 
+			/**
+			 * \brief Set the background image.
+			 *
+			 * The image is decoded in the background, and
+			 * the skin's background is shown until it is ready.
+			 *
+			 * \param[in] image The new background image.
+			 **/
+			virtual void setBackgroundImage(AWE::ImageHandle image);
+
 			/**
 			 * \brief Scrape for metadata.
 			 *
+			 * This queues a job with the `ScrapeJobManager`
+			 * and returns right away. How far it is gets shown
+			 * in the title bar, and the images of the item are
+			 * refreshed once it is done.
+			 *
 			 * \param[inout] item The item to get metadata for.
 			 * \param[in] scraper The scraper to use.
 			 * \param[in] flags The scraping configuration.
@@ -3,14 +3,13 @@
 
 // widgets and layouts
 #include <QWidget>
-#include <QStackedLayout>
 #include "ui/widgets/items/MediaItemWidget.h"
 #include "ui/widgets/collection/ItemListWidget.h"
 #include "ui/widgets/collection/ItemGridWidget.h"
+#include "ui/widgets/collection/ItemMultiViewWidget.h"
+#include "ui/widgets/collection/MediaItemModel.h"
 #include <QVBoxLayout>
 #include <QPushButton>
-#include <QComboBox>
-#include <QLabel>
 
 using namespace AWE;
 
@@ -23,6 +22,9 @@ namespace UI
 			// The folder whose contents are displayed.
 			Folder* folder;
 
+			// The folder's items, shown by every view.
+			MediaItemModel* model;
+
 			/* this is UI stuff */
 			// The main layout for this widget.
 			QVBoxLayout* mainLayout;
@@ -30,17 +32,8 @@ namespace UI
 			// The back button.
 			QPushButton* backButton;
 
-			// View selection menu.
-			QComboBox* viewSelectionMenu;
-
-			// The layout to switch between item view modes.
-			QStackedLayout* mediaItemLayout;
-
-			// The list of contained media items.
-			ItemListWidget* mediaItemList;
-
-			// The grid of contained media items.
-			ItemGridWidget* mediaItemGrid;
+			// The grid and list of contained media items.
+			ItemMultiViewWidget* mediaItemViews;
 	};
 }
 
@@ -52,56 +45,63 @@ FolderPane::FolderPane(QWidget* parent)
 {
 	/* Create everything */
 	d->folder = nullptr;
+	d->model = new MediaItemModel(this);
 	d->mainLayout = new QVBoxLayout(this);
 	d->backButton = new QPushButton(tr("Back"), this);
-	d->viewSelectionMenu = new QComboBox(this);
-	d->mediaItemLayout = new QStackedLayout;
-	d->mediaItemList = new ItemListWidget(this, false, false);
-	d->mediaItemGrid = new ItemGridWidget(this, false, false, 3);
+	d->mediaItemViews = new ItemMultiViewWidget(this, d->model, false);
 
 	/* set up layouts/widgets */
 	d->mainLayout->addWidget(d->backButton);
-	d->viewSelectionMenu->addItem("Grid");
-	d->viewSelectionMenu->addItem("List");
-	d->viewSelectionMenu->setCurrentIndex(0);
-	d->mainLayout->addWidget(d->viewSelectionMenu);
-	d->mainLayout->addLayout(d->mediaItemLayout);
-	d->mediaItemLayout->setContentsMargins(0, 0, 0, 0);
-	d->mediaItemLayout->addWidget(d->mediaItemGrid);
-	d->mediaItemLayout->addWidget(d->mediaItemList);
+	d->mainLayout->addWidget(d->mediaItemViews);
 
-	/* connections */
-	// item highlight and selection
-	auto respondToItemHighlight = [this] (ItemWidget* item)
+	// only the items that can be seen get widgets
+	auto makeWidget = [this] (QWidget* parent, int index,
+			MediaItemWidget::DisplayMode mode) -> ItemWidget*
 		{
-			emit itemHighlighted(((MediaItemWidget*) item)->getMediaItem());
+			MediaItemWidget* ans = new MediaItemWidget(parent,
+				d->model->getItem(index), true);
+			ans->setDisplayMode(mode);
+			return ans;
 		};
 
-	auto respondToItemSelected = [this] (ItemWidget* item)
+	auto bindWidget = [this] (ItemWidget* item, int index)
 		{
-			emit itemSelected(((MediaItemWidget*) item)->getMediaItem());
+			MediaItemWidget* widget = (MediaItemWidget*) item;
+			widget->setMediaItem(d->model->getItem(index));
+			// the icon may have come or gone
+			widget->setDisplayMode(widget->getDisplayMode());
 		};
 
-	connect(d->mediaItemGrid, &ItemGridWidget::itemHighlighted,
-			this, respondToItemHighlight);
-	connect(d->mediaItemGrid, &ItemGridWidget::itemSelected,
-			this, respondToItemSelected);
-
-	// switching view layout
-	connect(d->viewSelectionMenu, static_cast<void (QComboBox::*)(int)>
-			(&QComboBox::activated), this,
-		[this, respondToItemHighlight, respondToItemSelected] (int mode)
+	d->mediaItemViews->addView("Grid", new ItemGridWidget(nullptr, false, false, 3),
+		[makeWidget] (QWidget* parent, int index)
 		{
-			disconnect(d->mediaItemLayout->currentWidget(), 0,
-				this, 0);
-			d->mediaItemLayout->setCurrentIndex(mode);
-			ItemCollectionWidget* coll = (ItemCollectionWidget*)
-				d->mediaItemLayout->currentWidget();
-			connect(coll, &ItemCollectionWidget::itemHighlighted,
-					this, respondToItemHighlight);
-			connect(coll, &ItemCollectionWidget::itemSelected,
-					this, respondToItemSelected);
-		} );
+			return makeWidget(parent, index, MediaItemWidget::IconOnly);
+		}, bindWidget);
+	d->mediaItemViews->addView("List", new ItemListWidget(nullptr, false, false),
+		[makeWidget] (QWidget* parent, int index)
+		{
+			return makeWidget(parent, index, MediaItemWidget::NameOnly);
+		}, bindWidget);
+	d->mediaItemViews->switchToView(0);
+
+	/* connections */
+	// item highlight and selection, from whichever view is shown
+	connect(d->mediaItemViews->getSelectionModel(),
+			&ItemSelectionModel::highlightingChanged, this,
+			[this] (bool newState, int index)
+			{
+				if (newState)
+				{
+					emit itemHighlighted(d->model->getItem(index));
+				}
+			} );
+
+	connect(d->mediaItemViews->getSelectionModel(),
+			&ItemSelectionModel::selected, this,
+			[this] (int index)
+			{
+				emit itemSelected(d->model->getItem(index));
+			} );
 
 	// back button
 	connect(d->backButton, &QPushButton::clicked,
@@ -113,12 +113,10 @@ FolderPane::FolderPane(QWidget* parent)
 
 FolderPane::~FolderPane()
 {
-	delete d->mediaItemGrid;
-	delete d->mediaItemList;
-	delete d->mediaItemLayout;
-	delete d->viewSelectionMenu;
+	delete d->mediaItemViews;
 	delete d->backButton;
 	delete d->mainLayout;
+	delete d->model;
 	delete d;
 }
 
@@ -132,29 +130,7 @@ void FolderPane::setFolder(Folder* folder)
 	// set the folder variable
 	d->folder = folder;
 
-	/* change the contents of the item list */
-	d->mediaItemList->clear();
-	d->mediaItemGrid->clear();
-	for (int i = 0; i < d->folder->getItems().count(); ++ i)
-	{
-		// add to the list
-		MediaItemWidget* toAdd = new MediaItemWidget(d->mediaItemList,
-			d->folder->getItems().at(i), true);
-		toAdd->setDisplayMode(MediaItemWidget::NameOnly);
-		d->mediaItemList->addItem(toAdd);
-
-		// add to the grid
-		MediaItemWidget* toAdd2 = new MediaItemWidget(d->mediaItemGrid,
-			d->folder->getItems().at(i), true);
-		toAdd2->setDisplayMode(MediaItemWidget::IconOnly);
-		d->mediaItemGrid->addItem(toAdd2);
-
-		// connect highlighting/unhighlighting
-		toAdd->connect(toAdd, static_cast<void (ItemWidget::*)(bool)>
-			(&ItemWidget::highlightingChanged), toAdd2,
-			&ItemWidget::setHighlighting);
-		toAdd2->connect(toAdd2, static_cast<void (ItemWidget::*)(bool)>
-			(&ItemWidget::highlightingChanged), toAdd,
-			&ItemWidget::setHighlighting);
-	}
+	/* change the contents of the item views */
+	// the folder's items are made here, when it is opened
+	d->model->setItems(d->folder->getItems());
 }
\ No newline at end of file
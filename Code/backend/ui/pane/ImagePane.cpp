@@ -18,6 +18,9 @@ namespace UI
 			// The item to display images for.
 			MediaItem* mediaItem;
 
+			// Rebuilds the lists when the item's images change.
+			QMetaObject::Connection imagesChanged;
+
 			// The main layout of this widget.
 			QVBoxLayout* mainLayout;
 
@@ -63,7 +66,7 @@ ImagePane::ImagePane(QWidget* parent)
 		{
 			ImageItemWidget* image = (ImageItemWidget*) item;
 			d->mediaItem->setDefaultIconIndex(image->getIndex());
-			emit iconChanged(image->getImage());
+			emit iconChanged(image->getImageHandle());
 		} );
 
 	connect(d->fanartList, &ItemListWidget::itemSelected,
@@ -71,14 +74,14 @@ ImagePane::ImagePane(QWidget* parent)
 		{
 			ImageItemWidget* image = (ImageItemWidget*) item;
 			d->mediaItem->setDefaultFanartIndex(image->getIndex());
-			emit fanartChanged(image->getImage());
+			emit fanartChanged(image->getImageHandle());
 		} );
 
 	connect(d->iconList, &ItemListWidget::itemHighlighted,
 		[this] (ItemWidget* item)
 		{
 			ImageItemWidget* image = (ImageItemWidget*) item;
-			d->currentIcon->setImage(image->getImage());
+			d->currentIcon->setImage(image->getImageHandle());
 			d->currentIcon->setIndex(image->getIndex());
 		} );
 
@@ -86,7 +89,7 @@ ImagePane::ImagePane(QWidget* parent)
 		[this] (ItemWidget* item)
 		{
 			ImageItemWidget* image = (ImageItemWidget*) item;
-			d->currentFanart->setImage(image->getImage());
+			d->currentFanart->setImage(image->getImageHandle());
 			d->currentFanart->setIndex(image->getIndex());
 		} );
 }
@@ -107,25 +110,39 @@ void ImagePane::setItem(MediaItem* item)
 	d->iconList->clear();
 	d->fanartList->clear();
 	// set the item
+	if (d->mediaItem != item)
+	{
+		disconnect(d->imagesChanged);
+		d->imagesChanged = connect(item, &MediaItem::metadataChanged, this,
+			[this] (MetadataChanges changes)
+			{
+				// the default alone is handled by the lists themselves
+				if (changes.hasChanged(MetadataChanges::Icons)
+					|| changes.hasChanged(MetadataChanges::Fanarts))
+				{
+					setItem(d->mediaItem);
+				}
+			} );
+	}
 	d->mediaItem = item;
 	// icon images
 	for (int i = 0; i < item->numIcons(); ++ i)
 	{
 		ImageItemWidget* item = new ImageItemWidget(d->iconList, i,
-			d->mediaItem->getIcon(i), true, QSize(d->iconList->height(), 0));
+			d->mediaItem->getIconHandle(i), true, QSize(d->iconList->height(), 0));
 		d->iconList->addItem(item);
 	}
-	d->currentIcon->setImage(d->mediaItem->getDefaultIcon());
+	d->currentIcon->setImage(d->mediaItem->getDefaultIconHandle());
 	d->currentIcon->setIndex(d->mediaItem->getDefaultIconIndex());
-	emit iconChanged(d->mediaItem->getDefaultIcon());
+	emit iconChanged(d->mediaItem->getDefaultIconHandle());
 	// fanart images
 	for (int i = 0; i < item->numFanarts(); ++ i)
 	{
 		ImageItemWidget* item = new ImageItemWidget(d->fanartList, i,
-			d->mediaItem->getFanart(i), true, QSize(d->fanartList->height(), 0));
+			d->mediaItem->getFanartHandle(i), true, QSize(d->fanartList->height(), 0));
 		d->fanartList->addItem(item);
 	}
-	d->currentFanart->setImage(d->mediaItem->getDefaultFanart());
+	d->currentFanart->setImage(d->mediaItem->getDefaultFanartHandle());
 	d->currentFanart->setIndex(d->mediaItem->getDefaultFanartIndex());
-	emit fanartChanged(d->mediaItem->getDefaultFanart());
+	emit fanartChanged(d->mediaItem->getDefaultFanartHandle());
 }
\ No newline at end of file
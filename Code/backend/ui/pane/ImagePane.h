@@ -14,7 +14,7 @@
 #include "items/MediaItem.h"
 
 // images
-#include <QPixmap>
+#include "image/ImageHandle.h"
 
 // for slots
 #include "ui/widgets/items/ItemWidget.h"
@@ -56,16 +56,20 @@ namespace UI
 			/**
 			 * \brief Sent when the fanart image is changed.
 			 *
+			 * The image may not be decoded yet.
+			 *
 			 * \param[in] image The new fanart image.
 			 **/
-			void fanartChanged(QPixmap image);
+			void fanartChanged(AWE::ImageHandle image);
 
 			/**
 			 * \brief Sent when the icon image is changed.
 			 *
+			 * The image may not be decoded yet.
+			 *
 			 * \param[in] image The new icon image.
 			 **/
-			void iconChanged(QPixmap image);
+			void iconChanged(AWE::ImageHandle image);
 
 		private:
 			friend class ImagePanePrivate;
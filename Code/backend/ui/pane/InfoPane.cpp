@@ -94,6 +94,14 @@ namespace UI
 			/** \brief Drop down for selecting the scraper to use. **/
 			QComboBox* scraperSelections;
 
+			/** \brief The scrape job for the item, or -1. **/
+			int scrapeJob;
+
+			/**
+			 * \brief Show the state of the scrape job on the button.
+			 **/
+			void updateScrapeButton();
+
 			// depending on the displayed type, there can be different buttons
 			/** \brief Switchable layout for different kinds of items. **/
 			QStackedLayout* buttonArea;
@@ -131,6 +139,7 @@ InfoPane::InfoPane(QWidget* parent)
 	
 	/* Create everything */
 	d->mediaItem = AWEMC::settings()->getRootFolder();
+	d->scrapeJob = -1;
 	d->mainLayout = new QVBoxLayout(this);
 	d->name = new TextItemWidget(this, d->mediaItem->getName(), "big");
 	d->mediaType = new TextItemWidget(this, d->mediaItem->getType(), "normal");
@@ -217,9 +226,48 @@ InfoPane::InfoPane(QWidget* parent)
 	connect(d->scrapeButton, &QPushButton::clicked,
 			this,	[this] ()
 					{
+						// a second click cancels
+						if (d->scrapeJob != -1)
+						{
+							ScrapeJobManager::instance()->cancel(d->scrapeJob);
+							return;
+						}
 						emit wantsToScrapeForMetadata(d->mediaItem,
 							AWEMC::settings()->getScraperHandler(
 							d->scraperSelections->currentText()), 0);
+						d->scrapeJob = ScrapeJobManager::instance()
+							->findJob(d->mediaItem);
+						d->updateScrapeButton();
+					} );
+
+	// follow the scrape job instead of waiting for it
+	ScrapeJobManager* jobs = ScrapeJobManager::instance();
+	connect(jobs, &ScrapeJobManager::progress,
+			this,	[this] (int job)
+					{
+						if (job == d->scrapeJob)
+						{
+							d->updateScrapeButton();
+						}
+					} );
+	connect(jobs, &ScrapeJobManager::finished,
+			this,	[this] (int job)
+					{
+						if (job == d->scrapeJob)
+						{
+							d->scrapeJob = -1;
+							// show what was found
+							setItem(d->mediaItem);
+						}
+					} );
+	connect(jobs, &ScrapeJobManager::canceled,
+			this,	[this] (int job)
+					{
+						if (job == d->scrapeJob)
+						{
+							d->scrapeJob = -1;
+							d->updateScrapeButton();
+						}
 					} );
 }
 
@@ -259,6 +307,7 @@ InfoPane::~InfoPane()
 void InfoPane::setItem(MediaItem* item)
 {
 	d->mediaItem = item;
+	d->scrapeJob = ScrapeJobManager::instance()->findJob(item);
 	// reset the name, type, and description
 	d->name->setText(item->getName());
 	d->mediaType->setText(item->getType());
@@ -334,6 +383,26 @@ void InfoPanePrivate::makeDetailUIElements()
 	}
 }
 
+void InfoPanePrivate::updateScrapeButton()
+{
+	ScrapeJobManager* jobs = ScrapeJobManager::instance();
+	if (scrapeJob == -1 || !jobs->isActive(scrapeJob))
+	{
+		scrapeJob = -1;
+		scrapeButton->setText(InfoPane::tr("Get Metadata"));
+		return;
+	}
+	// clicking it now cancels the job
+	QString text = InfoPane::tr("Cancel (%1/%2)")
+		.arg(jobs->getDone(scrapeJob)).arg(jobs->getTotal(scrapeJob));
+	qint64 left = jobs->getTimeLeft(scrapeJob);
+	if (left >= 0)
+	{
+		text += InfoPane::tr(", %1 s left").arg((left + 999) / 1000);
+	}
+	scrapeButton->setText(text);
+}
+
 void InfoPanePrivate::makeDropdownMenus()
 {
 	// get the scrapers
@@ -365,6 +434,7 @@ void InfoPanePrivate::makeDropdownMenus()
 		scrapeButton->setEnabled(true);
 		scraperSelections->setEnabled(true);
 	}
+	updateScrapeButton();
 
 	// get the players
 	playerSelections->clear();
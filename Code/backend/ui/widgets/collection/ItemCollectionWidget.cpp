@@ -1,9 +1,18 @@
 // header file
 #include "ItemCollectionWidget.h"
 
+// for shared items
+#include "ItemModel.h"
+#include "ItemSelectionModel.h"
+
 // for holding items
 #include <QLayout>
 #include <QBoxLayout>
+#include <QHash>
+#include <QList>
+
+// for following the scroll position
+#include <QScrollBar>
 
 namespace UI
 {
@@ -31,6 +40,66 @@ namespace UI
 			// The layout holding all of the items.
 			QLayout* itemLayout;
 
+			/* used by setModel() */
+			// Is this only making widgets for the items that can be seen?
+			bool virtualMode;
+
+			// The widget holding the virtual items, which has no layout.
+			QWidget* virtualWidget;
+
+			// The items shown, and the one used by setVirtualItems().
+			ItemModel* model;
+			ItemModel* ownModel;
+
+			// The highlighted items, and the one used if none is given.
+			ItemSelectionModel* selection;
+			ItemSelectionModel* ownSelection;
+
+			// Makes and changes widgets.
+			ItemCollectionWidget::ItemMaker make;
+			ItemCollectionWidget::ItemBinder bind;
+
+			// The items on each line and the space between them.
+			int perLine;
+			int spacing;
+
+			// The space each item takes, set or measured, and the
+			// space across the items when it was measured.
+			int extent;
+			int measuredExtent;
+			int measuredCross;
+
+			// Lines past each edge of the view that get widgets.
+			int overscan;
+
+			// The widgets showing items, by index and the other way.
+			QHash<int, ItemWidget*> shown;
+			QHash<ItemWidget*, int> indexOf;
+
+			// Widgets that are not showing anything right now.
+			QList<ItemWidget*> spare;
+
+			// get the space across the direction of expansion
+			int crossSize() const;
+
+			// get the space an item takes, measuring it if needed
+			int itemExtent(int cellCross);
+
+			// make, move and recycle widgets to fit the view
+			void updateVirtualItems();
+
+			// get a widget for an item, recycling one if possible
+			ItemWidget* takeWidget(int index);
+
+			// show an item with a widget
+			void bindWidget(ItemWidget* item, int index);
+
+			// stop showing every item, but keep the widgets
+			void recycleWidgets();
+
+			// delete every widget
+			void deleteWidgets();
+
 			// ensures that only one item is highlighted if multiselection
 			// is disabled
 			inline void respondToItemHighlighted(ItemWidget* item);
@@ -50,6 +119,18 @@ ItemCollectionWidget::ItemCollectionWidget(QWidget* parent, bool direction,
 	d->multiselection = multiselection;
 	d->containerWidget = new QWidget(nullptr);
 	d->itemAlignment = ItemCollectionWidget::StartAlign;
+	d->virtualMode = false;
+	d->virtualWidget = new QWidget(nullptr);
+	d->model = nullptr;
+	d->ownModel = new ItemModel(this);
+	d->selection = nullptr;
+	d->ownSelection = new ItemSelectionModel(this, nullptr, multiselection);
+	d->perLine = 1;
+	d->spacing = 0;
+	d->extent = 0;
+	d->measuredExtent = 0;
+	d->measuredCross = 0;
+	d->overscan = 2;
 
 	// set up the widgets and layouts
 	d->containerWidget->setContentsMargins(0, 0, 0, 0);
@@ -80,12 +161,38 @@ ItemCollectionWidget::ItemCollectionWidget(QWidget* parent, bool direction,
 		d->containerWidget->setMinimumWidth(width());
 		d->containerWidget->setMaximumWidth(width());
 	}
+
+	// virtual items follow the scroll position
+	auto respondToScroll = [this] (int)
+		{
+			if (d->virtualMode)
+			{
+				d->updateVirtualItems();
+			}
+		};
+
+	connect(verticalScrollBar(), &QScrollBar::valueChanged,
+			this, respondToScroll);
+	connect(horizontalScrollBar(), &QScrollBar::valueChanged,
+			this, respondToScroll);
+
+	setSelectionModel(nullptr);
 }
 
 ItemCollectionWidget::~ItemCollectionWidget()
 {
+	// the model may outlive this
+	if (d->model)
+	{
+		disconnect(d->model, 0, this, 0);
+	}
+	disconnect(d->selection, 0, this, 0);
+	// whichever one is not in the scroll area is ours to delete
+	takeWidget();
 	delete d->spacingLayout;
 	delete d->containerWidget;
+	delete d->virtualWidget;
+	delete d;
 }
 
 bool ItemCollectionWidget::expandsLeftToRight() const
@@ -144,9 +251,170 @@ bool ItemCollectionWidget::acceptsMultiselection() const
 
 int ItemCollectionWidget::count() const
 {
+	if (d->virtualMode)
+	{
+		return d->model->count();
+	}
 	return d->itemLayout->count();
 }
 
+void ItemCollectionWidget::setModel(ItemModel* model, ItemMaker make,
+	ItemBinder bind)
+{
+	// get rid of whatever was here
+	clear();
+	clearVirtualItems();
+	if (!model)
+	{
+		return;
+	}
+	d->virtualMode = true;
+	d->model = model;
+	d->make = make;
+	d->bind = bind;
+	if (d->selection == d->ownSelection)
+	{
+		d->ownSelection->setModel(model);
+	}
+
+	// every widget shows another item now
+	connect(d->model, &ItemModel::reset, this,
+			[this] ()
+			{
+				d->recycleWidgets();
+				d->measuredExtent = 0;
+				d->updateVirtualItems();
+			} );
+
+	connect(d->model, &ItemModel::itemsChanged, this,
+			[this] (int first, int last)
+			{
+				for (auto i = d->shown.constBegin(); i != d->shown.constEnd(); ++ i)
+				{
+					if (i.key() >= first && i.key() <= last)
+					{
+						d->bindWidget(*i, i.key());
+					}
+				}
+			} );
+
+	connect(d->model, &QObject::destroyed, this,
+			[this] ()
+			{
+				d->model = d->ownModel;
+				clearVirtualItems();
+			} );
+
+	// the items are placed by hand instead of by a layout
+	takeWidget();
+	setWidgetResizable(false);
+	setWidget(d->virtualWidget);
+	d->updateVirtualItems();
+}
+
+ItemModel* ItemCollectionWidget::getModel() const
+{
+	return d->model;
+}
+
+void ItemCollectionWidget::setSelectionModel(ItemSelectionModel* selection)
+{
+	if (d->selection)
+	{
+		disconnect(d->selection, 0, this, 0);
+	}
+	d->selection = selection ? selection : d->ownSelection;
+	// widgets follow the highlighting, whichever view changed it
+	connect(d->selection, &ItemSelectionModel::highlightingChanged, this,
+			[this] (bool newState, int index)
+			{
+				ItemWidget* item = d->shown.value(index, nullptr);
+				if (item)
+				{
+					item->blockSignals(true);
+					item->setHighlighting(newState);
+					item->blockSignals(false);
+				}
+				emit indexHighlightingChanged(newState, index);
+			} );
+
+	for (auto i = d->shown.constBegin(); i != d->shown.constEnd(); ++ i)
+	{
+		(*i)->blockSignals(true);
+		(*i)->setHighlighting(d->selection->isHighlighted(i.key()));
+		(*i)->blockSignals(false);
+	}
+}
+
+ItemSelectionModel* ItemCollectionWidget::getSelectionModel() const
+{
+	return d->selection;
+}
+
+void ItemCollectionWidget::setVirtualItems(int count, ItemMaker make,
+	ItemBinder bind)
+{
+	if (count <= 0)
+	{
+		setModel(nullptr, nullptr, nullptr);
+		return;
+	}
+	setModel(d->ownModel, make, bind);
+	d->ownModel->setCount(count);
+}
+
+bool ItemCollectionWidget::isVirtual() const
+{
+	return d->virtualMode;
+}
+
+void ItemCollectionWidget::setVirtualItemExtent(int extent)
+{
+	d->extent = extent;
+	d->measuredExtent = 0;
+	if (d->virtualMode)
+	{
+		d->updateVirtualItems();
+	}
+}
+
+void ItemCollectionWidget::setOverscan(int lines)
+{
+	d->overscan = qMax(0, lines);
+	if (d->virtualMode)
+	{
+		d->updateVirtualItems();
+	}
+}
+
+ItemWidget* ItemCollectionWidget::getVirtualItem(int index) const
+{
+	return d->shown.value(index, nullptr);
+}
+
+int ItemCollectionWidget::getVirtualIndex(ItemWidget* item) const
+{
+	return d->indexOf.value(item, -1);
+}
+
+bool ItemCollectionWidget::isIndexHighlighted(int index) const
+{
+	return d->selection->isHighlighted(index);
+}
+
+int ItemCollectionWidget::numVirtualWidgets() const
+{
+	return d->shown.count() + d->spare.count();
+}
+
+void ItemCollectionWidget::setIndexHighlighting(int index, bool newState)
+{
+	if (d->virtualMode)
+	{
+		d->selection->setHighlighting(index, newState);
+	}
+}
+
 void ItemCollectionWidget::resizeEvent(QResizeEvent*)
 {
 	if (expandsLeftToRight())
@@ -159,6 +427,31 @@ void ItemCollectionWidget::resizeEvent(QResizeEvent*)
 		d->containerWidget->setMinimumWidth(width());
 		d->containerWidget->setMaximumWidth(width());
 	}
+	if (d->virtualMode)
+	{
+		// items are measured again if they are a different width
+		d->updateVirtualItems();
+	}
+}
+
+void ItemCollectionWidget::showEvent(QShowEvent* event)
+{
+	TransparentScrollArea::showEvent(event);
+	if (d->virtualMode)
+	{
+		d->updateVirtualItems();
+	}
+}
+
+void ItemCollectionWidget::hideEvent(QHideEvent* event)
+{
+	TransparentScrollArea::hideEvent(event);
+	// only the views that are shown keep widgets
+	if (d->virtualMode)
+	{
+		d->deleteWidgets();
+		d->measuredExtent = 0;
+	}
 }
 
 void ItemCollectionWidget::registerItem(ItemWidget* item)
@@ -210,9 +503,243 @@ void ItemCollectionWidget::setContainerLayout(QLayout* layout)
 	setItemAlignment(getItemAlignment());
 }
 
+void ItemCollectionWidget::setVirtualLayout(int perLine, int spacing)
+{
+	d->perLine = qMax(1, perLine);
+	d->spacing = qMax(0, spacing);
+	if (d->virtualMode)
+	{
+		d->updateVirtualItems();
+	}
+}
+
+void ItemCollectionWidget::clearVirtualItems()
+{
+	if (!d->virtualMode)
+	{
+		return;
+	}
+	d->deleteWidgets();
+	disconnect(d->model, 0, this, 0);
+	if (d->selection == d->ownSelection)
+	{
+		d->ownSelection->setModel(nullptr);
+	}
+	d->virtualMode = false;
+	d->model = nullptr;
+	d->measuredExtent = 0;
+	d->make = nullptr;
+	d->bind = nullptr;
+	// back to the layout
+	takeWidget();
+	setWidgetResizable(true);
+	setWidget(d->containerWidget);
+}
+
+int ItemCollectionWidgetPrivate::crossSize() const
+{
+	int cross = direction ? p->viewport()->height() : p->viewport()->width();
+	return qMax(1, (cross - spacing * (perLine - 1)) / perLine);
+}
+
+int ItemCollectionWidgetPrivate::itemExtent(int cellCross)
+{
+	if (extent > 0)
+	{
+		return extent;
+	}
+	if (measuredExtent > 0 && measuredCross == cellCross)
+	{
+		return measuredExtent;
+	}
+	measuredCross = cellCross;
+	// measure the first item the way it will be shown
+	ItemWidget* item = takeWidget(0);
+	if (direction)
+	{
+		item->fixSizeToFitIn(QSize(16777215, cellCross));
+		int w = item->sizeHint().width();
+		measuredExtent = qMax(w, item->minimumWidth());
+	}
+	else
+	{
+		item->fixSizeToFitIn(QSize(cellCross, 16777215));
+		int h = item->hasHeightForWidth() ? item->heightForWidth(cellCross)
+			: item->sizeHint().height();
+		measuredExtent = qMax(h, item->minimumHeight());
+	}
+	measuredExtent = qMax(1, measuredExtent);
+	// the widget will be given an item again below
+	indexOf.remove(item);
+	item->hide();
+	spare << item;
+	return measuredExtent;
+}
+
+void ItemCollectionWidgetPrivate::updateVirtualItems()
+{
+	// the view that is not shown does not need widgets,
+	// and is measured again once it is
+	int virtualCount = model->count();
+	if (!p->isVisible() || virtualCount == 0)
+	{
+		recycleWidgets();
+		virtualWidget->resize(0, 0);
+		return;
+	}
+	int cellCross = crossSize();
+	int cellExtent = itemExtent(cellCross);
+	int step = cellExtent + spacing;
+	int lines = (virtualCount + perLine - 1) / perLine;
+	int total = qMax(0, lines * step - spacing);
+
+	// the widget is as long as every item together
+	if (direction)
+	{
+		virtualWidget->resize(total, p->viewport()->height());
+	}
+	else
+	{
+		virtualWidget->resize(p->viewport()->width(), total);
+	}
+
+	// find the lines that can be seen, plus the overscan
+	int pos = direction ? p->horizontalScrollBar()->value()
+		: p->verticalScrollBar()->value();
+	int length = direction ? p->viewport()->width()
+		: p->viewport()->height();
+	int firstLine = qMax(0, pos / step - overscan);
+	int lastLine = qMin(lines - 1, (pos + length) / step + overscan);
+	int first = firstLine * perLine;
+	int last = qMin(virtualCount - 1, (lastLine + 1) * perLine - 1);
+
+	// recycle the widgets that went out of sight
+	for (auto i = shown.begin(); i != shown.end(); )
+	{
+		if (i.key() < first || i.key() > last)
+		{
+			indexOf.remove(*i);
+			(*i)->hide();
+			spare << *i;
+			i = shown.erase(i);
+		}
+		else
+		{
+			++ i;
+		}
+	}
+
+	// place the widgets that can be seen
+	for (int index = first; index <= last; ++ index)
+	{
+		ItemWidget* item = shown.value(index, nullptr);
+		if (!item)
+		{
+			item = takeWidget(index);
+			shown[index] = item;
+		}
+		int line = index / perLine;
+		int across = index % perLine;
+		QRect cell;
+		if (direction)
+		{
+			cell = QRect(line * step, across * (cellCross + spacing),
+				cellExtent, cellCross);
+		}
+		else
+		{
+			cell = QRect(across * (cellCross + spacing), line * step,
+				cellCross, cellExtent);
+		}
+		if (item->getSizeToFitIn() != cell.size())
+		{
+			item->fixSizeToFitIn(cell.size());
+		}
+		item->setGeometry(cell);
+		item->show();
+	}
+}
+
+ItemWidget* ItemCollectionWidgetPrivate::takeWidget(int index)
+{
+	ItemWidget* item;
+	if (!spare.isEmpty())
+	{
+		item = spare.takeLast();
+		bindWidget(item, index);
+	}
+	else
+	{
+		item = make(virtualWidget, index);
+		p->registerItem(item);
+		item->setParent(virtualWidget);
+		// the highlighting is kept by the selection model, so that
+		// it outlives the widget and is seen by the other views
+		QObject::connect(item, static_cast<void (ItemWidget::*)(bool, ItemWidget*)>
+			(&ItemWidget::highlightingChanged), p,
+			[this] (bool newState, ItemWidget* item)
+			{
+				int index = indexOf.value(item, -1);
+				if (index != -1)
+				{
+					selection->setHighlighting(index, newState);
+				}
+			} );
+
+		QObject::connect(item, static_cast<void (ItemWidget::*)(ItemWidget*)>
+			(&ItemWidget::selected), p,
+			[this] (ItemWidget* item)
+			{
+				int index = indexOf.value(item, -1);
+				if (index != -1)
+				{
+					selection->select(index);
+				}
+			} );
+		indexOf[item] = index;
+		item->blockSignals(true);
+		item->setHighlighting(selection->isHighlighted(index));
+		item->blockSignals(false);
+	}
+	return item;
+}
+
+void ItemCollectionWidgetPrivate::bindWidget(ItemWidget* item, int index)
+{
+	bind(item, index);
+	indexOf[item] = index;
+	// a recycled widget shows the highlighting of its new item
+	item->blockSignals(true);
+	item->setHighlighting(selection->isHighlighted(index));
+	item->blockSignals(false);
+}
+
+void ItemCollectionWidgetPrivate::recycleWidgets()
+{
+	for (auto item : shown)
+	{
+		item->hide();
+		spare << item;
+	}
+	shown.clear();
+	indexOf.clear();
+}
+
+void ItemCollectionWidgetPrivate::deleteWidgets()
+{
+	recycleWidgets();
+	for (auto item : spare)
+	{
+		p->unregisterItem(item);
+		item->deleteLater();
+	}
+	spare.clear();
+}
+
 void ItemCollectionWidgetPrivate::respondToItemHighlighted(ItemWidget* item)
 {
-	if (!multiselection)
+	// the selection model unhighlights the others itself
+	if (!virtualMode && !multiselection)
 	{
 		for (int i = 0; i < itemLayout->count(); ++ i)
 		{
@@ -13,11 +13,18 @@
 // items to be held
 #include "ui/widgets/items/ItemWidget.h"
 
+// for making items on demand
+#include <functional>
+
 namespace UI
 {
 	// internal data class
 	class ItemCollectionWidgetPrivate;
 
+	// shared items
+	class ItemModel;
+	class ItemSelectionModel;
+
 	/**
 	 * \brief An abstract, scrollable collection
 	 * 			of item widgets.
@@ -29,6 +36,19 @@ namespace UI
 	 * When using this class (or a sub-class),
 	 * you should never need to call any of
 	 * `QScrollArea`'s functions.
+	 *
+	 * Large collections should be shown with
+	 * `setModel()` instead of `addItem()`.
+	 * The collection is then described only by
+	 * an `ItemModel`, and widgets are made
+	 * for the items that can be seen (plus a few
+	 * lines past either edge). When the view
+	 * scrolls, widgets that went out of sight are
+	 * given to the items that came into it, so the
+	 * number of widgets does not depend on the
+	 * number of items. Views that are hidden
+	 * delete their widgets. Several views can show
+	 * the same model and `ItemSelectionModel`.
 	 **/
 	class AWEMC_BACKEND_LIBRARY ItemCollectionWidget : public TransparentScrollArea
 	{
@@ -42,6 +62,22 @@ namespace UI
 				MiddleAlign = 3
 			};
 
+			/**
+			 * \brief Makes a widget for the item at an index.
+			 *
+			 * Takes the parent of the widget and the index
+			 * of the item.
+			 **/
+			typedef std::function<ItemWidget* (QWidget*, int)> ItemMaker;
+
+			/**
+			 * \brief Changes a widget to show the item at an index.
+			 *
+			 * Takes a widget from the `ItemMaker` and the index
+			 * of the item it should now show.
+			 **/
+			typedef std::function<void (ItemWidget*, int)> ItemBinder;
+
 			/**
 			 * \brief Make for the given parent
 			 *			in the given direction.
@@ -120,7 +156,147 @@ namespace UI
 			 **/
 			virtual int count() const;
 
+			/**
+			 * \brief Show the items of a model, only making
+			 *			widgets for the ones that can be seen.
+			 *
+			 * Removes every item that is in this collection.
+			 * Every widget is assumed to take the same space
+			 * (see `setVirtualItemExtent()`). The model is not
+			 * owned by this widget. Calling this with `nullptr`
+			 * goes back to holding normal items.
+			 *
+			 * \param model The items to show.
+			 * \param make Makes a new widget for an item.
+			 * \param bind Changes a widget that is no longer
+			 *			seen to show another item.
+			 **/
+			virtual void setModel(ItemModel* model, ItemMaker make,
+				ItemBinder bind);
+
+			/**
+			 * \brief Get the model whose items are shown.
+			 *
+			 * \returns The model, or `nullptr` if this holds
+			 *			normal items.
+			 **/
+			virtual ItemModel* getModel() const;
+
+			/**
+			 * \brief Share which items are highlighted with
+			 *			other views of the same model.
+			 *
+			 * The selection model is not owned by this widget.
+			 *
+			 * \param selection The selection model, or `nullptr`
+			 *			to use one only this widget has.
+			 **/
+			virtual void setSelectionModel(ItemSelectionModel* selection);
+
+			/**
+			 * \brief Get which items are highlighted.
+			 *
+			 * \returns The selection model.
+			 **/
+			virtual ItemSelectionModel* getSelectionModel() const;
+
+			/**
+			 * \brief Show a number of items that no other
+			 *			view shows.
+			 *
+			 * This is `setModel()` with a model that only
+			 * this widget has. Calling this with a count
+			 * of 0 goes back to holding normal items.
+			 *
+			 * \param count The number of items.
+			 * \param make Makes a new widget for an item.
+			 * \param bind Changes a widget that is no longer
+			 *			seen to show another item.
+			 **/
+			virtual void setVirtualItems(int count, ItemMaker make,
+				ItemBinder bind);
+
+			/**
+			 * \brief Determine if this collection only makes
+			 *			widgets for the items that can be seen.
+			 *
+			 * \returns `true` if `setModel()` was used,
+			 *			`false` otherwise.
+			 **/
+			virtual bool isVirtual() const;
+
+			/**
+			 * \brief Set the space that every item takes in
+			 *			the direction of expansion.
+			 *
+			 * By default, this is measured from the first
+			 * widget made.
+			 *
+			 * \param extent The height (or width, if
+			 *			`expandsLeftToRight()`) of an item
+			 *			in pixels, or 0 to measure it.
+			 **/
+			virtual void setVirtualItemExtent(int extent);
+
+			/**
+			 * \brief Set how many lines of items past the edges
+			 *			of the view have widgets.
+			 *
+			 * \param lines The number of lines on each side,
+			 *			2 by default.
+			 **/
+			virtual void setOverscan(int lines);
+
+			/**
+			 * \brief Get the widget showing an item.
+			 *
+			 * \param index The index of the item.
+			 *
+			 * \returns The widget, or `nullptr` if the item
+			 *			cannot be seen.
+			 **/
+			virtual ItemWidget* getVirtualItem(int index) const;
+
+			/**
+			 * \brief Get the index of the item a widget shows.
+			 *
+			 * \param item The widget.
+			 *
+			 * \returns The index, or -1 if the widget is not
+			 *			showing an item.
+			 **/
+			virtual int getVirtualIndex(ItemWidget* item) const;
+
+			/**
+			 * \brief Determine if an item is highlighted,
+			 *			even if it cannot be seen.
+			 *
+			 * \param index The index of the item.
+			 *
+			 * \returns `true` if the item is highlighted,
+			 *			`false` otherwise.
+			 **/
+			virtual bool isIndexHighlighted(int index) const;
+
+			/**
+			 * \brief Get the number of widgets made for the
+			 *			items that can be seen.
+			 *
+			 * \returns The number of widgets.
+			 **/
+			virtual int numVirtualWidgets() const;
+
 		public slots:
+			/**
+			 * \brief Change the highlighting of an item,
+			 *			even if it cannot be seen.
+			 *
+			 * \param index The index of the item.
+			 * \param newState `true` to highlight the item,
+			 *			`false` to unhighlight it.
+			 **/
+			virtual void setIndexHighlighting(int index, bool newState);
+
 			/**
 			 * \brief Add an item to this collection.
 			 *
@@ -187,6 +363,17 @@ namespace UI
 			 **/
 			void itemSelected(ItemWidget* item);
 
+			/**
+			 * \brief Sent when the highlighting of an item
+			 *			shown by `setModel()` has changed.
+			 *
+			 * \param[in] newState `true` if the item is now
+			 *						highlighted, `false` if
+			 *						unhighlighted.
+			 * \param[in] index The index of the item.
+			 **/
+			void indexHighlightingChanged(bool newState, int index);
+
 		protected:
 			/**
 			 * \brief Responds to resize events.
@@ -194,7 +381,23 @@ namespace UI
 			 * \param event The (unused) resize event.
 			 **/
 			virtual void resizeEvent(QResizeEvent* event);
-			
+
+			/**
+			 * \brief Makes widgets for the items that can be
+			 *			seen once this is shown.
+			 *
+			 * \param event The (unused) show event.
+			 **/
+			virtual void showEvent(QShowEvent* event);
+
+			/**
+			 * \brief Deletes the widgets of the items once
+			 *			this is hidden.
+			 *
+			 * \param event The (unused) hide event.
+			 **/
+			virtual void hideEvent(QHideEvent* event);
+
 			/**
 			 * \brief Registers the item for signal monitoring.
 			 *
@@ -216,6 +419,23 @@ namespace UI
 			 **/
 			virtual void setContainerLayout(QLayout* layout);
 
+			/**
+			 * \brief Set how items from `setModel()`
+			 *			are placed.
+			 *
+			 * \param[in] perLine The number of items in each row
+			 *			(or column, if `expandsLeftToRight()`).
+			 * \param[in] spacing The space between items in pixels.
+			 **/
+			virtual void setVirtualLayout(int perLine, int spacing);
+
+			/**
+			 * \brief Remove (and delete) every widget made by
+			 *			`setModel()` and go back to holding
+			 *			normal items.
+			 **/
+			virtual void clearVirtualItems();
+
 		private:
 			ItemCollectionWidgetPrivate* d;
 	};
@@ -5,6 +5,13 @@
 #include <QGridLayout>
 #include <QPoint>
 
+// for resizing
+#include <QResizeEvent>
+
+// for finding items
+#include <QHash>
+#include <QSet>
+
 namespace UI
 {
 	class ItemGridWidgetPrivate
@@ -12,23 +19,34 @@ namespace UI
 		public:
 			ItemGridWidget* p;
 
-			// Increment the position.
-			void incrementPos(QPoint& pos);
+			// Get the cell (row, column) of the item at an index.
+			QPoint posOf(int index) const;
+
+			// Get the size the items should fit in.
+			QSize cellSize() const;
 
-			// Decrement pos.
-			void decrementPos(QPoint& pos);
+			// Take the items from an index on out of the layout.
+			// The layout holds the items in the order of their
+			// indices, so these are always the last ones.
+			void takeFrom(int index);
 
-			// Replace the item at pos.
-			void replaceItem(QWidget* item, QPoint pos);
+			// Put the items from an index on back into the layout.
+			void placeFrom(int index);
 
 			// The grid layout.
 			QGridLayout* layout;
 
 			// The number of rows or columns (depending on the direction).
 			int num;
-			
-			// The current position.
-			QPoint currPos;
+
+			// The items, in order.
+			QList<ItemWidget*> items;
+
+			// The index of each item.
+			QHash<ItemWidget*, int> indices;
+
+			// The number of rows or columns that are stretched.
+			int lines;
 	};
 }
 
@@ -43,7 +61,7 @@ ItemGridWidget::ItemGridWidget(QWidget* parent, bool direction,
 	d->p = this;
 	d->layout = new QGridLayout;
 	d->num = num;
-	d->currPos = QPoint(0, 0);
+	d->lines = 0;
 
 	// set up column/row spacing and stretching
 	d->layout->setVerticalSpacing(5);
@@ -64,12 +82,14 @@ ItemGridWidget::ItemGridWidget(QWidget* parent, bool direction,
 		}
 	}
 	setContainerLayout(d->layout);
+	setVirtualLayout(d->num, 5);
 }
 
 ItemGridWidget::~ItemGridWidget()
 {
 	clear();
 	delete d->layout;
+	delete d;
 }
 
 QString ItemGridWidget::getLayoutType() const
@@ -79,38 +99,69 @@ QString ItemGridWidget::getLayoutType() const
 
 int ItemGridWidget::count() const
 {
-	if (!expandsLeftToRight())
+	if (isVirtual())
 	{
-		return d->num * d->currPos.x() + d->currPos.y();
+		return ItemCollectionWidget::count();
 	}
-	else
+	return d->items.count();
+}
+
+ItemWidget* ItemGridWidget::at(int index) const
+{
+	if (isVirtual())
+	{
+		return getVirtualItem(index);
+	}
+	return d->items.value(index, nullptr);
+}
+
+int ItemGridWidget::indexOf(ItemWidget* item) const
+{
+	if (isVirtual())
 	{
-		return d->num * d->currPos.y() + d->currPos.x();
+		return getVirtualIndex(item);
 	}
+	return d->indices.value(item, -1);
 }
 
 void ItemGridWidget::addItem(ItemWidget* item)
 {
-	// tell the item its size (and change stretch factors)
-	// add the item
-	registerItem(item);
-	d->replaceItem(item, d->currPos);
-	if (!expandsLeftToRight())
+	insertItems(d->items.count(), QList<ItemWidget*>() << item);
+}
+
+void ItemGridWidget::addItems(QList<ItemWidget*> items)
+{
+	insertItems(d->items.count(), items);
+}
+
+void ItemGridWidget::insertItem(int index, ItemWidget* item)
+{
+	insertItems(index, QList<ItemWidget*>() << item);
+}
+
+void ItemGridWidget::insertItems(int index, QList<ItemWidget*> items)
+{
+	if (items.isEmpty())
 	{
-		int w = (width() - d->layout->horizontalSpacing() * (d->num - 1))
-					/ d->num;
-		item->fixSizeToFitIn(QSize(QSize(w, 16777215)));
-		d->layout->setRowStretch(d->currPos.y(), 1);
+		return;
 	}
-	else
+	index = qBound(0, index, d->items.count());
+	// tell the items their size
+	QSize size = d->cellSize();
+	for (auto item : items)
 	{
-		int h = (height() - d->layout->verticalSpacing() * (d->num - 1))
-					/ d->num;
-		item->fixSizeToFitIn(QSize(16777215, h));
-		d->layout->setColumnStretch(d->currPos.x(), 1);
+		registerItem(item);
+		item->fixSizeToFitIn(size);
 	}
-	// increment
-	d->incrementPos(d->currPos);
+	// only the items after these move, and only once
+	setUpdatesEnabled(false);
+	d->takeFrom(index);
+	for (int i = 0; i < items.count(); ++ i)
+	{
+		d->items.insert(index + i, items[i]);
+	}
+	d->placeFrom(index);
+	setUpdatesEnabled(true);
 }
 
 void ItemGridWidget::removeItem(ItemWidget* item)
@@ -119,128 +170,146 @@ void ItemGridWidget::removeItem(ItemWidget* item)
 	{
 		return;
 	}
-	// get the location
-	QPoint pos(0, 0);
-	while (pos != d->currPos 
-			&& d->layout->itemAtPosition(pos.x(), pos.y())->widget() != item)
+	removeItems(QList<ItemWidget*>() << item);
+}
+
+void ItemGridWidget::removeItem(int index)
+{
+	if (index < 0 || index >= d->items.count())
 	{
-		d->incrementPos(pos);
+		return;
 	}
-	if (pos == d->currPos)
+	removeItems(QList<ItemWidget*>() << d->items[index]);
+}
+
+void ItemGridWidget::removeItems(QList<ItemWidget*> items)
+{
+	// find the first item that moves
+	QSet<ItemWidget*> removed;
+	int first = d->items.count();
+	for (auto item : items)
+	{
+		int index = d->indices.value(item, -1);
+		if (index != -1)
+		{
+			removed.insert(item);
+			first = qMin(first, index);
+		}
+	}
+	if (removed.isEmpty())
 	{
 		return;
 	}
-	// remove item
-	d->layout->removeWidget(item);
-	item->deleteLater();
-	d->decrementPos(d->currPos);
-	// shift everything down one
-	while (pos != d->currPos)
+	// only the items after the first one move, and only once
+	setUpdatesEnabled(false);
+	d->takeFrom(first);
+	int to = first;
+	for (int from = first; from < d->items.count(); ++ from)
 	{
-		// move the next item here
-		d->incrementPos(pos);
-		QPoint next = pos;
-		d->decrementPos(pos);
-		d->replaceItem(d->layout->itemAtPosition(next.x(), next.y())->widget(), pos);
-		// increment
-		pos = next;
+		ItemWidget* item = d->items[from];
+		if (removed.contains(item))
+		{
+			d->indices.remove(item);
+			item->deleteLater();
+		}
+		else
+		{
+			d->items[to] = item;
+			++ to;
+		}
 	}
-	// get rid of the last item
-	QLayoutItem* temp = d->layout->itemAtPosition(d->currPos.x(), d->currPos.y());
-	d->layout->removeItem(temp);
-	delete temp;
+	d->items.erase(d->items.begin() + to, d->items.end());
+	d->placeFrom(first);
+	setUpdatesEnabled(true);
 }
 
 void ItemGridWidget::clear()
 {
-	QPoint origin(0, 0);
-	while (d->currPos != origin)
+	clearVirtualItems();
+	d->takeFrom(0);
+	for (auto item : d->items)
 	{
-		d->decrementPos(d->currPos);
-		d->replaceItem(nullptr, d->currPos);
+		item->deleteLater();
 	}
+	d->items.clear();
+	d->indices.clear();
+	d->placeFrom(0);
 }
 
 void ItemGridWidget::resizeEvent(QResizeEvent* event)
 {
 	ItemCollectionWidget::resizeEvent(event);
-	for (int i = 0; i < d->layout->count(); ++ i)
+	// the cells only depend on the size across the grid
+	if (expandsLeftToRight() ? event->size().height() == event->oldSize().height()
+		: event->size().width() == event->oldSize().width())
 	{
-		if (d->layout->itemAt(i)->widget())
-		{
-			ItemWidget* item = (ItemWidget*) d->layout->itemAt(i)->widget();
-			if (!expandsLeftToRight())
-			{
-				int w = (width() - d->layout->horizontalSpacing() * (d->num - 1))
-							/ d->num;
-				item->fixSizeToFitIn(QSize(QSize(w, 16777215)));
-			}
-			else
-			{
-				int h = (height() - d->layout->verticalSpacing() * (d->num - 1))
-							/ d->num;
-				item->fixSizeToFitIn(QSize(16777215, h));
-			}
-		}
+		return;
+	}
+	QSize size = d->cellSize();
+	for (auto item : d->items)
+	{
+		item->fixSizeToFitIn(size);
 	}
-
 }
 
-void ItemGridWidgetPrivate::incrementPos(QPoint& pos)
+QPoint ItemGridWidgetPrivate::posOf(int index) const
 {
 	if (!p->expandsLeftToRight())
 	{
-		pos.setY(pos.y() + 1);
-		if (pos.y() == num)
-		{
-			pos.setX(pos.x() + 1);
-			pos.setY(0);
-		}
+		return QPoint(index / num, index % num);
 	}
 	else
 	{
-		pos.setX(pos.x() + 1);
-		if (pos.x() == num)
-		{
-			pos.setY(pos.y() + 1);
-			pos.setX(0);
-		}
+		return QPoint(index % num, index / num);
 	}
 }
 
-void ItemGridWidgetPrivate::decrementPos(QPoint& pos)
+QSize ItemGridWidgetPrivate::cellSize() const
 {
 	if (!p->expandsLeftToRight())
 	{
-		pos.setY(pos.y() - 1);
-		if (pos.y() == -1)
-		{
-			pos.setX(pos.x() - 1);
-			pos.setY(num - 1);
-		}
+		int w = (p->width() - layout->horizontalSpacing() * (num - 1))
+					/ num;
+		return QSize(w, 16777215);
 	}
 	else
 	{
-		pos.setX(pos.x() - 1);
-		if (pos.x() == -1)
-		{
-			pos.setY(pos.y() - 1);
-			pos.setX(num - 1);
-		}
+		int h = (p->height() - layout->verticalSpacing() * (num - 1))
+					/ num;
+		return QSize(16777215, h);
+	}
+}
+
+void ItemGridWidgetPrivate::takeFrom(int index)
+{
+	while (layout->count() > index)
+	{
+		// the last one never moves anything else in the layout
+		delete layout->takeAt(layout->count() - 1);
 	}
 }
 
-void ItemGridWidgetPrivate::replaceItem(QWidget* item, QPoint pos)
+void ItemGridWidgetPrivate::placeFrom(int index)
 {
-	QLayoutItem* temp = layout->itemAtPosition(pos.x(), pos.y());
-	if (temp && temp->widget())
+	for (int i = index; i < items.count(); ++ i)
 	{
-		QWidget* widget = temp->widget();
-		layout->removeWidget(widget);
-		widget->deleteLater();
+		QPoint pos = posOf(i);
+		layout->addWidget(items[i], pos.x(), pos.y(), Qt::AlignCenter);
+		indices[items[i]] = i;
 	}
-	if (item)
+	// stretch the lines that have items, and only those
+	int newLines = (items.count() + num - 1) / num;
+	for (int i = qMin(lines, newLines); i < qMax(lines, newLines); ++ i)
 	{
-		layout->addWidget(item, pos.x(), pos.y(), Qt::AlignCenter);
+		int stretch = i < newLines ? 1 : 0;
+		if (!p->expandsLeftToRight())
+		{
+			layout->setRowStretch(i, stretch);
+		}
+		else
+		{
+			layout->setColumnStretch(i, stretch);
+		}
 	}
-}
\ No newline at end of file
+	lines = newLines;
+}
@@ -7,6 +7,9 @@
 // superclass
 #include "ItemCollectionWidget.h"
 
+// for adding and removing many items at once
+#include <QList>
+
 namespace UI
 {
 	// internal data class
@@ -14,6 +17,13 @@ namespace UI
 
 	/**
 	 * \brief An item collection based on a grid layout.
+	 *
+	 * The items are kept in order, and the cell of
+	 * an item is worked out from its index. Finding
+	 * an item takes constant time, and adding or
+	 * removing items only moves the items after them.
+	 * Adding or removing many items at once with
+	 * `addItems()` or `removeItems()` moves them once.
 	 **/
 	class AWEMC_BACKEND_LIBRARY ItemGridWidget : public ItemCollectionWidget
 	{
@@ -59,6 +69,26 @@ namespace UI
 			 **/
 			virtual int count() const;
 
+			/**
+			 * \brief Get the item at the given index.
+			 *
+			 * \param index The index of the item to get.
+			 *
+			 * \returns The item at the given index, or
+			 *			`nullptr` if there is none.
+			 **/
+			virtual ItemWidget* at(int index) const;
+
+			/**
+			 * \brief Get the index of an item.
+			 *
+			 * \param item The item to find.
+			 *
+			 * \returns The index of the item, or -1 if
+			 *			it is not in this grid.
+			 **/
+			virtual int indexOf(ItemWidget* item) const;
+
 		public slots:
 			/**
 			 * \brief Add an item to this list.
@@ -67,6 +97,31 @@ namespace UI
 			 **/
 			virtual void addItem(ItemWidget* item);
 
+			/**
+			 * \brief Add several items to the end of this grid.
+			 *
+			 * \param[in] items The items to add.
+			 **/
+			virtual void addItems(QList<ItemWidget*> items);
+
+			/**
+			 * \brief Insert an item into this grid.
+			 *
+			 * \param[in] index The index to place the
+			 *					item at.
+			 * \param[in] item The item to add.
+			 **/
+			virtual void insertItem(int index, ItemWidget* item);
+
+			/**
+			 * \brief Insert several items into this grid.
+			 *
+			 * \param[in] index The index to place the
+			 *					first item at.
+			 * \param[in] items The items to add, in order.
+			 **/
+			virtual void insertItems(int index, QList<ItemWidget*> items);
+
 			/**
 			 * \brief Remove an item from this list.
 			 *
@@ -74,6 +129,21 @@ namespace UI
 			 **/
 			virtual void removeItem(ItemWidget* item);
 
+			/**
+			 * \brief Remove the item at the given index.
+			 *
+			 * \param[in] index The index of the item
+			 *					to remove (and delete).
+			 **/
+			virtual void removeItem(int index);
+
+			/**
+			 * \brief Remove several items from this grid.
+			 *
+			 * \param[in] items The items to remove (and delete).
+			 **/
+			virtual void removeItems(QList<ItemWidget*> items);
+
 			/**
 			 * \brief Remove all items in a safe way.
 			 *
@@ -11,6 +11,9 @@
 // for retrieving items
 #include <QLayoutItem>
 
+// for resizing
+#include <QResizeEvent>
+
 namespace UI
 {
 	class ItemListWidgetPrivate
@@ -36,6 +39,7 @@ ItemListWidget::ItemListWidget(QWidget* parent, bool direction,
 		d->layout = new QVBoxLayout;
 	}
 	setContainerLayout(d->layout);
+	setVirtualLayout(1, d->layout->spacing());
 }
 
 ItemListWidget::~ItemListWidget()
@@ -51,6 +55,10 @@ QString ItemListWidget::getLayoutType() const
 
 ItemWidget* ItemListWidget::at(int index)
 {
+	if (isVirtual())
+	{
+		return getVirtualItem(index);
+	}
 	if (index >= count() || index < 0)
 	{
 		return nullptr;
@@ -60,6 +68,10 @@ ItemWidget* ItemListWidget::at(int index)
 
 const ItemWidget* ItemListWidget::at(int index) const
 {
+	if (isVirtual())
+	{
+		return getVirtualItem(index);
+	}
 	if (index >= count() || index < 0)
 	{
 		return nullptr;
@@ -106,6 +118,7 @@ void ItemListWidget::removeItem(int index)
 
 void ItemListWidget::clear()
 {
+	clearVirtualItems();
 	while (count() > 0)
 	{
 		removeItem(0);
@@ -115,7 +128,14 @@ void ItemListWidget::clear()
 void ItemListWidget::resizeEvent(QResizeEvent* event)
 {
 	ItemCollectionWidget::resizeEvent(event);
-	for (int i = 0; i < count(); ++ i)
+	// the items only depend on the size across the list
+	if (expandsLeftToRight() ? event->size().height() == event->oldSize().height()
+		: event->size().width() == event->oldSize().width())
+	{
+		return;
+	}
+	// virtual items are sized by the superclass
+	for (int i = 0; i < d->layout->count(); ++ i)
 	{
 		if (expandsLeftToRight())
 		{
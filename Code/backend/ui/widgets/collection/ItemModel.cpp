@@ -0,0 +1,47 @@
+// header file
+#include "ItemModel.h"
+
+namespace UI
+{
+	class ItemModelPrivate
+	{
+		public:
+			// The number of items.
+			int count;
+	};
+}
+
+using namespace UI;
+
+ItemModel::ItemModel(QObject* parent)
+	:	QObject(parent),
+		d(new ItemModelPrivate)
+{
+	d->count = 0;
+}
+
+ItemModel::~ItemModel()
+{
+	delete d;
+}
+
+int ItemModel::count() const
+{
+	return d->count;
+}
+
+void ItemModel::setCount(int count)
+{
+	d->count = qMax(0, count);
+	emit reset();
+}
+
+void ItemModel::changeItems(int first, int last)
+{
+	first = qMax(0, first);
+	last = qMin(d->count - 1, last);
+	if (first <= last)
+	{
+		emit itemsChanged(first, last);
+	}
+}
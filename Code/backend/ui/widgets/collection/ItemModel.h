@@ -0,0 +1,89 @@
+#ifndef ITEM_MODEL_H
+#define ITEM_MODEL_H
+
+// library macros
+#include "macros/BackendLibraryMacros.h"
+
+// superclass
+#include <QObject>
+
+namespace UI
+{
+	// internal data class
+	class ItemModelPrivate;
+
+	/**
+	 * \brief The items shown by one or more
+	 *			collection views.
+	 *
+	 * A model only knows how many items there are.
+	 * Each view that shows it decides what widget
+	 * to make for an item (see
+	 * `ItemCollectionWidget::setModel()`), and only
+	 * makes widgets for the items it can show, so
+	 * adding a view does not copy every item.
+	 *
+	 * Sub-classes hold the items themselves and
+	 * call `setCount()` when they change.
+	 **/
+	class AWEMC_BACKEND_LIBRARY ItemModel : public QObject
+	{
+		Q_OBJECT
+
+		public:
+			/**
+			 * \brief Make an empty model.
+			 *
+			 * \param[in] parent The parent object.
+			 **/
+			ItemModel(QObject* parent = nullptr);
+
+			/**
+			 * \brief Destroy this object.
+			 **/
+			virtual ~ItemModel();
+
+			/**
+			 * \brief Get the number of items.
+			 *
+			 * \returns The number of items.
+			 **/
+			virtual int count() const;
+
+		public slots:
+			/**
+			 * \brief Replace every item.
+			 *
+			 * \param[in] count The number of new items.
+			 **/
+			virtual void setCount(int count);
+
+			/**
+			 * \brief Indicate that some items look different
+			 *			now, without being added or removed.
+			 *
+			 * \param[in] first The index of the first item.
+			 * \param[in] last The index of the last item.
+			 **/
+			virtual void changeItems(int first, int last);
+
+		signals:
+			/**
+			 * \brief Sent when every item has been replaced.
+			 **/
+			void reset();
+
+			/**
+			 * \brief Sent when some items look different now.
+			 *
+			 * \param[in] first The index of the first item.
+			 * \param[in] last The index of the last item.
+			 **/
+			void itemsChanged(int first, int last);
+
+		private:
+			ItemModelPrivate* d;
+	};
+}
+
+#endif
@@ -0,0 +1,171 @@
+// header file
+#include "ItemMultiViewWidget.h"
+
+// widgets and layouts
+#include <QVBoxLayout>
+#include <QStackedLayout>
+#include <QComboBox>
+
+// for holding the views
+#include <QList>
+
+namespace UI
+{
+	class ItemMultiViewWidgetPrivate
+	{
+		public:
+			ItemMultiViewWidget* p;
+
+			// The items shown by every view.
+			ItemModel* model;
+
+			// The highlighted items of every view.
+			ItemSelectionModel* selection;
+
+			// How each view makes and changes its widgets.
+			QList<ItemCollectionWidget::ItemMaker> makers;
+			QList<ItemCollectionWidget::ItemBinder> binders;
+
+			QVBoxLayout* mainLayout;
+			QStackedLayout* collectionLayout;
+			QComboBox* selections;
+	};
+}
+
+using namespace UI;
+
+ItemMultiViewWidget::ItemMultiViewWidget(QWidget* parent,
+		ItemModel* model, bool multiselection)
+	:	QWidget(parent),
+		d(new ItemMultiViewWidgetPrivate)
+{
+	d->p = this;
+	d->model = model;
+	d->selection = new ItemSelectionModel(this, model, multiselection);
+	d->mainLayout = new QVBoxLayout(this);
+	d->collectionLayout = new QStackedLayout;
+	d->selections = new QComboBox(this);
+	d->mainLayout->setContentsMargins(0, 0, 0, 0);
+	d->mainLayout->addWidget(d->selections);
+	d->mainLayout->addLayout(d->collectionLayout);
+
+	// switching views from the menu
+	connect(d->selections, static_cast<void (QComboBox::*)(int)>
+			(&QComboBox::activated), this,
+			[this] (int i)
+			{
+				switchToView(i);
+			} );
+}
+
+ItemMultiViewWidget::~ItemMultiViewWidget()
+{
+	// the views go before the selection model they use
+	while (numViews() > 0)
+	{
+		QWidget* view = d->collectionLayout->widget(0);
+		d->collectionLayout->removeWidget(view);
+		delete view;
+	}
+	delete d;
+}
+
+ItemModel* ItemMultiViewWidget::getModel() const
+{
+	return d->model;
+}
+
+void ItemMultiViewWidget::setModel(ItemModel* model)
+{
+	d->model = model;
+	d->selection->setModel(model);
+	for (int i = 0; i < numViews(); ++ i)
+	{
+		getView(i)->setModel(model, d->makers[i], d->binders[i]);
+	}
+}
+
+ItemSelectionModel* ItemMultiViewWidget::getSelectionModel() const
+{
+	return d->selection;
+}
+
+int ItemMultiViewWidget::numViews() const
+{
+	return d->collectionLayout->count();
+}
+
+ItemCollectionWidget* ItemMultiViewWidget::getView(int i) const
+{
+	return (ItemCollectionWidget*) d->collectionLayout->widget(i);
+}
+
+ItemCollectionWidget* ItemMultiViewWidget::getCurrentView() const
+{
+	return (ItemCollectionWidget*) d->collectionLayout->currentWidget();
+}
+
+bool ItemMultiViewWidget::switchToView(ItemCollectionWidget* view)
+{
+	return switchToView(d->collectionLayout->indexOf(view));
+}
+
+bool ItemMultiViewWidget::switchToView(int i)
+{
+	if (i < 0 || i >= numViews())
+	{
+		return false;
+	}
+	// the view being hidden deletes its widgets
+	d->collectionLayout->setCurrentIndex(i);
+	d->selections->setCurrentIndex(i);
+	emit viewChanged(getView(i));
+	return true;
+}
+
+bool ItemMultiViewWidget::switchToView(QString name)
+{
+	return switchToView(d->selections->findText(name));
+}
+
+void ItemMultiViewWidget::addView(QString name, ItemCollectionWidget* view,
+	ItemCollectionWidget::ItemMaker make,
+	ItemCollectionWidget::ItemBinder bind)
+{
+	d->makers << make;
+	d->binders << bind;
+	view->setParent(this);
+	view->setSelectionModel(d->selection);
+	view->setModel(d->model, make, bind);
+	d->selections->addItem(name);
+	d->collectionLayout->addWidget(view);
+}
+
+bool ItemMultiViewWidget::removeView(ItemCollectionWidget* view)
+{
+	return removeView(d->collectionLayout->indexOf(view));
+}
+
+bool ItemMultiViewWidget::removeView(int i)
+{
+	if (i < 0 || i >= numViews())
+	{
+		return false;
+	}
+	ItemCollectionWidget* view = getView(i);
+	d->collectionLayout->removeWidget(view);
+	d->selections->removeItem(i);
+	d->makers.removeAt(i);
+	d->binders.removeAt(i);
+	view->deleteLater();
+	if (numViews() > 0)
+	{
+		switchToView(d->collectionLayout->currentIndex());
+	}
+	return true;
+}
+
+bool ItemMultiViewWidget::removeView(QString name)
+{
+	return removeView(d->selections->findText(name));
+}
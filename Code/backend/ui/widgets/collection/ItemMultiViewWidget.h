@@ -10,6 +10,10 @@
 // item container class
 #include "ItemCollectionWidget.h"
 
+// shared items
+#include "ItemModel.h"
+#include "ItemSelectionModel.h"
+
 namespace UI
 {
 	// internal data class
@@ -23,27 +27,32 @@ namespace UI
 	 * are displayed. A group of icons could be
 	 * displayed in a list, and changed to be
 	 * displayed via a grid.
+	 *
+	 * Every view shows the same `ItemModel` and
+	 * highlights the same items through one
+	 * `ItemSelectionModel`, so adding a view does
+	 * not copy the items. Only the view that is
+	 * shown has widgets.
 	 **/
-	class AWEMC_BACKEND_LIBRARY ItemMultiViewWidget : public ItemCollectionWidget
+	class AWEMC_BACKEND_LIBRARY ItemMultiViewWidget : public QWidget
 	{
 		Q_OBJECT
 
 		public:
 			/**
 			 * \brief Make for the given parent
-			 *			in the given direction.
+			 *			and model.
 			 *
 			 * \param[in] parent The parent widget.
-			 * \param[in] direction The direction of expansion;
-			 *						`true` if left-right,
-			 *						`false` if up-down.
+			 * \param[in] model The items to show. It is
+			 *					not owned by this widget.
 			 * \param[in] multiselection `true` if multiple items
 			 *								should be selectable
 			 *								at once, `false` if
 			 *								only one should be
 			 *								at a time.
 			 **/
-			ItemMultiViewWidget(QWidget* parent, bool direction = false,
+			ItemMultiViewWidget(QWidget* parent, ItemModel* model = nullptr,
 				bool multiselection = false);
 
 			/**
@@ -52,40 +61,55 @@ namespace UI
 			virtual ~ItemMultiViewWidget();
 
 			/**
-			 * \brief Get the way these collections are
-			 *			stored.
+			 * \brief Get the items that are shown.
 			 *
-			 * \returns `"Multiple Views"`.
+			 * \returns The model.
 			 **/
-			virtual QString getLayoutType() const;
+			virtual ItemModel* getModel() const;
 
 			/**
-			 * \brief Get the number of views.
+			 * \brief Change the items that are shown
+			 *			in every view.
 			 *
-			 * \returns The number of views.
+			 * \param[in] model The new model. It is not
+			 *					owned by this widget.
 			 **/
-			virtual int numViews() const;
+			virtual void setModel(ItemModel* model);
 
-		public slots:
 			/**
-			 * \brief Add an item to this collection.
+			 * \brief Get which items are highlighted.
 			 *
-			 * \param[in] item The item to add.
+			 * \returns The selection model shared by
+			 *			every view.
 			 **/
-			virtual void addItem(ItemWidget* item);
+			virtual ItemSelectionModel* getSelectionModel() const;
 
 			/**
-			 * \brief Remove an item from this collection.
+			 * \brief Get the number of views.
 			 *
-			 * \param[in] item The item to remove (and delete).
+			 * \returns The number of views.
 			 **/
-			virtual void removeItem(ItemWidget* item);
+			virtual int numViews() const;
 
 			/**
-			 * \brief Remove all items in a safe way.
+			 * \brief Get the `i`th view.
+			 *
+			 * \param i The index of the view.
+			 *
+			 * \returns The view, or `nullptr` if the
+			 *			index is not valid.
 			 **/
-			virtual void clear();
+			virtual ItemCollectionWidget* getView(int i) const;
 
+			/**
+			 * \brief Get the view that is shown.
+			 *
+			 * \returns The view, or `nullptr` if there
+			 *			are none.
+			 **/
+			virtual ItemCollectionWidget* getCurrentView() const;
+
+		public slots:
 			/**
 			 * \brief Switch to the given view.
 			 *
@@ -124,10 +148,15 @@ namespace UI
 			 *
 			 * \param name The name to assign to the view in
 			 *				the selection menu.
-			 *
 			 * \param view The view to add.
+			 * \param make Makes a widget for an item in
+			 *				this view.
+			 * \param bind Changes a widget of this view to
+			 *				show another item.
 			 **/
-			virtual void addView(QString name, ItemCollectionWidget* view);
+			virtual void addView(QString name, ItemCollectionWidget* view,
+				ItemCollectionWidget::ItemMaker make,
+				ItemCollectionWidget::ItemBinder bind);
 
 			/**
 			 * \brief Remove (and delete) a view.
@@ -159,6 +188,14 @@ namespace UI
 			 **/
 			virtual bool removeView(QString name);
 
+		signals:
+			/**
+			 * \brief Sent when a different view is shown.
+			 *
+			 * \param[in] view The view that is shown now.
+			 **/
+			void viewChanged(ItemCollectionWidget* view);
+
 		private:
 			friend class ItemMultiViewWidgetPrivate;
 
@@ -166,4 +203,4 @@ namespace UI
 	};
 }
 
-#endif // ITEM_MULTI_VIEW_WIDGET_H
\ No newline at end of file
+#endif // ITEM_MULTI_VIEW_WIDGET_H
@@ -0,0 +1,124 @@
+// header file
+#include "ItemSelectionModel.h"
+
+// the model
+#include "ItemModel.h"
+
+// for holding the highlighted items
+#include <QSet>
+#include <algorithm>
+
+namespace UI
+{
+	class ItemSelectionModelPrivate
+	{
+		public:
+			// The model whose items are highlighted.
+			ItemModel* model;
+
+			// Does this allow multiselection?
+			bool multiselection;
+
+			// The highlighted items.
+			QSet<int> highlighted;
+	};
+}
+
+using namespace UI;
+
+ItemSelectionModel::ItemSelectionModel(QObject* parent, ItemModel* model,
+										bool multiselection)
+	:	QObject(parent),
+		d(new ItemSelectionModelPrivate)
+{
+	d->model = nullptr;
+	d->multiselection = multiselection;
+	setModel(model);
+}
+
+ItemSelectionModel::~ItemSelectionModel()
+{
+	delete d;
+}
+
+ItemModel* ItemSelectionModel::getModel() const
+{
+	return d->model;
+}
+
+void ItemSelectionModel::setModel(ItemModel* model)
+{
+	if (d->model)
+	{
+		disconnect(d->model, 0, this, 0);
+	}
+	clear();
+	d->model = model;
+	if (d->model)
+	{
+		// the indices mean other items now
+		connect(d->model, &ItemModel::reset,
+				this, &ItemSelectionModel::clear);
+	}
+}
+
+bool ItemSelectionModel::acceptsMultiselection() const
+{
+	return d->multiselection;
+}
+
+bool ItemSelectionModel::isHighlighted(int index) const
+{
+	return d->highlighted.contains(index);
+}
+
+QList<int> ItemSelectionModel::getHighlighted() const
+{
+	QList<int> ans = d->highlighted.toList();
+	std::sort(ans.begin(), ans.end());
+	return ans;
+}
+
+void ItemSelectionModel::setHighlighting(int index, bool newState)
+{
+	if (index < 0 || (d->model && index >= d->model->count())
+		|| d->highlighted.contains(index) == newState)
+	{
+		return;
+	}
+	if (newState)
+	{
+		// only one at a time
+		if (!d->multiselection)
+		{
+			for (int other : d->highlighted.toList())
+			{
+				d->highlighted.remove(other);
+				emit highlightingChanged(false, other);
+			}
+		}
+		d->highlighted.insert(index);
+	}
+	else
+	{
+		d->highlighted.remove(index);
+	}
+	emit highlightingChanged(newState, index);
+}
+
+void ItemSelectionModel::clear()
+{
+	for (int index : d->highlighted.toList())
+	{
+		d->highlighted.remove(index);
+		emit highlightingChanged(false, index);
+	}
+}
+
+void ItemSelectionModel::select(int index)
+{
+	if (index >= 0 && (!d->model || index < d->model->count()))
+	{
+		emit selected(index);
+	}
+}
@@ -0,0 +1,149 @@
+#ifndef ITEM_SELECTION_MODEL_H
+#define ITEM_SELECTION_MODEL_H
+
+// library macros
+#include "macros/BackendLibraryMacros.h"
+
+// superclass
+#include <QObject>
+
+// for returning the highlighted items
+#include <QList>
+
+namespace UI
+{
+	// internal data class
+	class ItemSelectionModelPrivate;
+
+	// the model whose items are highlighted
+	class ItemModel;
+
+	/**
+	 * \brief Which items of an `ItemModel`
+	 *			are highlighted.
+	 *
+	 * Every view of a model that is given the same
+	 * selection model highlights the same items,
+	 * whether or not it has a widget for them, and
+	 * it is kept when the user switches views.
+	 *
+	 * The highlighting is forgotten when the items
+	 * of the model are replaced.
+	 **/
+	class AWEMC_BACKEND_LIBRARY ItemSelectionModel : public QObject
+	{
+		Q_OBJECT
+
+		public:
+			/**
+			 * \brief Make for the given model.
+			 *
+			 * \param[in] parent The parent object.
+			 * \param[in] model The model whose items are
+			 *					highlighted.
+			 * \param[in] multiselection `true` if multiple items
+			 *								should be highlighted
+			 *								at once, `false` if
+			 *								only one should be
+			 *								at a time.
+			 **/
+			ItemSelectionModel(QObject* parent, ItemModel* model = nullptr,
+				bool multiselection = false);
+
+			/**
+			 * \brief Destroy this object.
+			 **/
+			virtual ~ItemSelectionModel();
+
+			/**
+			 * \brief Get the model whose items are highlighted.
+			 *
+			 * \returns The model.
+			 **/
+			virtual ItemModel* getModel() const;
+
+			/**
+			 * \brief Change the model whose items are highlighted.
+			 *
+			 * This unhighlights everything.
+			 *
+			 * \param[in] model The new model.
+			 **/
+			virtual void setModel(ItemModel* model);
+
+			/**
+			 * \brief Does this accept multiselection?
+			 *
+			 * \returns `true` if multiple items can be
+			 *			highlighted, `false` otherwise.
+			 **/
+			virtual bool acceptsMultiselection() const;
+
+			/**
+			 * \brief Determine if an item is highlighted.
+			 *
+			 * \param[in] index The index of the item.
+			 *
+			 * \returns `true` if it is highlighted,
+			 *			`false` otherwise.
+			 **/
+			virtual bool isHighlighted(int index) const;
+
+			/**
+			 * \brief Get every highlighted item.
+			 *
+			 * \returns The indices of the items, in order.
+			 **/
+			virtual QList<int> getHighlighted() const;
+
+		public slots:
+			/**
+			 * \brief Change the highlighting of an item.
+			 *
+			 * If multiselection is not accepted, highlighting
+			 * an item unhighlights the one that was.
+			 *
+			 * \param[in] index The index of the item.
+			 * \param[in] newState `true` to highlight the item,
+			 *						`false` to unhighlight it.
+			 **/
+			virtual void setHighlighting(int index, bool newState);
+
+			/**
+			 * \brief Unhighlight every item.
+			 **/
+			virtual void clear();
+
+			/**
+			 * \brief Indicate that an item was selected
+			 *			(double-clicked or activated).
+			 *
+			 * \param[in] index The index of the item.
+			 **/
+			virtual void select(int index);
+
+		signals:
+			/**
+			 * \brief Sent when an item's highlighting state
+			 *			has changed.
+			 *
+			 * \param[in] newState `true` if the item is now
+			 *						highlighted, `false` if
+			 *						unhighlighted.
+			 * \param[in] index The index of the item.
+			 **/
+			void highlightingChanged(bool newState, int index);
+
+			/**
+			 * \brief Sent when an item has been selected.
+			 *
+			 * \param[in] index The index of the item.
+			 **/
+			void selected(int index);
+
+		private:
+			ItemSelectionModelPrivate* d;
+	};
+}
+
+#endif
@@ -0,0 +1,42 @@
+// header file
+#include "MediaItemModel.h"
+
+using namespace AWE;
+
+namespace UI
+{
+	class MediaItemModelPrivate
+	{
+		public:
+			// The items.
+			QList<MediaItem*> items;
+	};
+}
+
+using namespace UI;
+
+MediaItemModel::MediaItemModel(QObject* parent)
+	:	ItemModel(parent),
+		d(new MediaItemModelPrivate)
+{ }
+
+MediaItemModel::~MediaItemModel()
+{
+	delete d;
+}
+
+MediaItem* MediaItemModel::getItem(int index) const
+{
+	return d->items.value(index, nullptr);
+}
+
+QList<MediaItem*> MediaItemModel::getItems() const
+{
+	return d->items;
+}
+
+void MediaItemModel::setItems(QList<MediaItem*> items)
+{
+	d->items = items;
+	setCount(d->items.count());
+}
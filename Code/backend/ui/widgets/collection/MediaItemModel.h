@@ -0,0 +1,72 @@
+#ifndef MEDIA_ITEM_MODEL_H
+#define MEDIA_ITEM_MODEL_H
+
+// library macros
+#include "macros/BackendLibraryMacros.h"
+
+// superclass
+#include "ItemModel.h"
+
+// MediaItem class
+#include "items/MediaItem.h"
+
+// for holding the items
+#include <QList>
+
+namespace UI
+{
+	// internal data class
+	class MediaItemModelPrivate;
+
+	/**
+	 * \brief A model of media items, like the
+	 *			contents of a folder.
+	 **/
+	class AWEMC_BACKEND_LIBRARY MediaItemModel : public ItemModel
+	{
+		Q_OBJECT
+
+		public:
+			/**
+			 * \brief Make an empty model.
+			 *
+			 * \param[in] parent The parent object.
+			 **/
+			MediaItemModel(QObject* parent = nullptr);
+
+			/**
+			 * \brief Destroy this object.
+			 **/
+			virtual ~MediaItemModel();
+
+			/**
+			 * \brief Get an item.
+			 *
+			 * \param[in] index The index of the item.
+			 *
+			 * \returns The item, or `nullptr` if the
+			 *			index is not valid.
+			 **/
+			virtual AWE::MediaItem* getItem(int index) const;
+
+			/**
+			 * \brief Get every item.
+			 *
+			 * \returns The items.
+			 **/
+			virtual QList<AWE::MediaItem*> getItems() const;
+
+		public slots:
+			/**
+			 * \brief Replace every item.
+			 *
+			 * \param[in] items The new items.
+			 **/
+			virtual void setItems(QList<AWE::MediaItem*> items);
+
+		private:
+			MediaItemModelPrivate* d;
+	};
+}
+
+#endif
@@ -4,8 +4,19 @@
 // for painting
 #include <QPainter>
 
+// for pre-scaled images
+#include "image/ImageLoader.h"
+#include "image/ImageCache.h"
+
+// for waiting until resizing stops
+#include <QTimer>
+
 namespace UI
 {
+	/** \brief How long the size has to stay the same before a
+	 *			smooth copy of the image is made. **/
+	static const int settleMsec = 150;
+
 	class ImageItemWidgetPrivate
 	{
 		public:
@@ -14,15 +25,70 @@ namespace UI
 
 			// Helper function that scales the image.
 			inline void makeImageIcon(QSize size);
+
+			// Helper function that scales the image to
+			// fit the widget or the fixed size.
+			void remakeImageIcon();
+
+			// Helper function that gets a thumbnail of the
+			// image at the current icon size, or scales the
+			// image on a worker thread if it was set directly.
+			void requestThumbnail();
+
+			// Helper function that gets the scaled image at
+			// the given size from the image cache.
+			QPixmap findIcon(QSize size);
+
+			// Helper function that sets up the timer.
+			void makeSettleTimer();
+
+			// The key for this image in the image cache.
+			QString source() const;
+
+			// The size of the full image, even if it
+			// is not decoded yet.
+			QSize sourceSize() const;
 			
 			// The index of this file in the item's config file.
 			int index;
 
-			// The image (in full size).
+			// The image handle (null if set from a pixmap).
+			AWE::ImageHandle handle;
+
+			// Whether a thumbnail has been asked for at
+			// the current icon size.
+			bool requested;
+
+			// Whether the widget is being painted right now.
+			bool painting;
+
+			// The image (in full size), only if it was
+			// set directly.
 			QPixmap image;
 
-			// The icon (scaled down).
-			QPixmap iconImage;
+			// The size of the last smooth icon that was drawn,
+			// which is stretched while the size is changing. The
+			// icon itself is only looked up in the image cache,
+			// so that nothing here keeps it alive.
+			QSize lastIconSize;
+
+			// A smooth icon too big for the image cache,
+			// which is kept here instead.
+			QPixmap uncachedIcon;
+
+			// Whether the size changed too recently to make
+			// a smooth icon, and the timer that ends that.
+			bool settling;
+			QTimer* settleTimer;
+
+			// The size of the last thumbnail that was made,
+			// if the image came from a handle. The scaled
+			// images themselves are in the image cache.
+			QSize thumbnailSize;
+
+			// The size of the icon, even if it
+			// is not decoded yet.
+			QSize iconSize;
 
 			// The aspect ratio mode.
 			Qt::AspectRatioMode ratioMode;
@@ -42,7 +108,10 @@ ImageItemWidget::ImageItemWidget(QWidget* parent, int index, QString file,
 	d->p = this;
 	// make everything
 	d->index = index;
+	d->requested = false;
+	d->painting = false;
 	d->ratioMode = Qt::KeepAspectRatio;
+	d->makeSettleTimer();
 
 	fixSizeToFitIn(size);
 	setImage(file);
@@ -56,7 +125,28 @@ ImageItemWidget::ImageItemWidget(QWidget* parent, int index, QPixmap image,
 	d->p = this;
 	// make everything
 	d->index = index;
+	d->requested = false;
+	d->painting = false;
 	d->ratioMode = Qt::KeepAspectRatio;
+	d->makeSettleTimer();
+
+	fixSizeToFitIn(size);
+	setImage(image);
+}
+
+ImageItemWidget::ImageItemWidget(QWidget* parent, int index,
+									AWE::ImageHandle image,
+									bool highlightable, QSize size)
+	:	ItemWidget(parent, highlightable),
+		d(new ImageItemWidgetPrivate)
+{
+	d->p = this;
+	// make everything
+	d->index = index;
+	d->requested = false;
+	d->painting = false;
+	d->ratioMode = Qt::KeepAspectRatio;
+	d->makeSettleTimer();
 
 	fixSizeToFitIn(size);
 	setImage(image);
@@ -82,10 +172,10 @@ bool ImageItemWidget::fixSizeToFitIn(QSize size)
 	getContentsMargins(&left, &top, &right, &bottom);
 	d->makeImageIcon(QSize(size.width() - left - right,
 		size.height() - top - bottom));
-	setMaximumSize(d->iconImage.width() + left + right,
-		d->iconImage.height() + top + bottom);
-	setMinimumSize(d->iconImage.width() + left + right,
-		d->iconImage.height() + top + bottom);
+	setMaximumSize(d->iconSize.width() + left + right,
+		d->iconSize.height() + top + bottom);
+	setMinimumSize(d->iconSize.width() + left + right,
+		d->iconSize.height() + top + bottom);
 	return true;
 }
 
@@ -96,7 +186,7 @@ QSize ImageItemWidget::getSizeToFitIn() const
 
 int ImageItemWidget::heightForWidth(int w) const
 {
-	QSize imageSize(d->image.size());
+	QSize imageSize(d->sourceSize());
 	imageSize.scale(QSize(w, QWIDGETSIZE_MAX), Qt::KeepAspectRatio);
 	return imageSize.height();
 }
@@ -104,7 +194,7 @@ int ImageItemWidget::heightForWidth(int w) const
 void ImageItemWidget::setAspectRatioMode(Qt::AspectRatioMode mode)
 {
 	d->ratioMode = mode;
-	setImage(getImage());
+	d->remakeImageIcon();
 }
 
 Qt::AspectRatioMode ImageItemWidget::getAspectRatioMode() const
@@ -119,15 +209,34 @@ QString ImageItemWidget::getItemType() const
 
 ImageItemWidget* ImageItemWidget::makeCopy() const
 {
+	if (!d->handle.isNull())
+	{
+		return new ImageItemWidget(nullptr, getIndex(),
+			getImageHandle(), isHighlightable(), getSizeToFitIn());
+	}
 	return new ImageItemWidget(nullptr, getIndex(),
 		getImage(), isHighlightable(), getSizeToFitIn());
 }
 
 QPixmap ImageItemWidget::getImage() const
 {
+	if (d->image.isNull())
+	{
+		return d->handle.getPixmap();
+	}
 	return d->image;
 }
 
+AWE::ImageHandle ImageItemWidget::getImageHandle() const
+{
+	return d->handle;
+}
+
+bool ImageItemWidget::hasImage() const
+{
+	return !d->image.isNull() || d->handle.isValid();
+}
+
 int ImageItemWidget::getIndex() const
 {
 	return d->index;
@@ -135,24 +244,30 @@ int ImageItemWidget::getIndex() const
 
 void ImageItemWidget::setImage(QString file)
 {
-	setImage(QPixmap(file));
+	setImage(AWE::ImageHandle(file));
 }
 
 void ImageItemWidget::setImage(QPixmap image)
 {
+	d->handle = AWE::ImageHandle();
+	d->requested = false;
 	d->image = image;
-	int left, top, right, bottom;
-	getContentsMargins(&left, &top, &right, &bottom);
-	if (d->fitInSize.width() < 0)
-	{
-		d->makeImageIcon(QSize(width() - left - right,
-			height() - top - bottom));
-	}
-	else
-	{
-		d->makeImageIcon(QSize(d->fitInSize.width() - left - right,
-			d->fitInSize.height() - top - bottom));
-	}
+	d->lastIconSize = QSize();
+	d->uncachedIcon = QPixmap();
+	d->thumbnailSize = QSize();
+	d->remakeImageIcon();
+}
+
+void ImageItemWidget::setImage(AWE::ImageHandle image)
+{
+	d->handle = image;
+	d->requested = false;
+	// drawn from thumbnails, never the full image
+	d->image = QPixmap();
+	d->lastIconSize = QSize();
+	d->uncachedIcon = QPixmap();
+	d->thumbnailSize = QSize();
+	d->remakeImageIcon();
 }
 
 void ImageItemWidget::setIndex(int index)
@@ -163,10 +278,51 @@ void ImageItemWidget::setIndex(int index)
 void ImageItemWidget::paintEvent(QPaintEvent* event)
 {
 	ItemWidget::paintEvent(event);
+	if (d->iconSize.isEmpty())
+	{
+		return;
+	}
+	QPixmap icon = d->findIcon(d->iconSize);
+	if (icon.isNull() && !d->settling && hasImage())
+	{
+		// we are visible, so we need a smooth icon at this size now
+		d->painting = true;
+		d->requestThumbnail();
+		d->painting = false;
+		// it may have been made before
+		icon = d->findIcon(d->iconSize);
+	}
+	if (!icon.isNull())
+	{
+		d->lastIconSize = d->iconSize;
+	}
+	else if (!d->uncachedIcon.isNull())
+	{
+		icon = d->uncachedIcon;
+	}
+	// until it is ready, an old icon is stretched to fit,
+	// which is fast enough to do on every step of a resize
+	else if (d->lastIconSize.isValid())
+	{
+		icon = d->findIcon(d->lastIconSize);
+	}
+	if (icon.isNull() && d->thumbnailSize.isValid())
+	{
+		icon = d->findIcon(d->thumbnailSize);
+	}
+	if (icon.isNull())
+	{
+		icon = d->image;
+	}
+	if (icon.isNull())
+	{
+		return;
+	}
 	QPainter p(this);
-	p.drawPixmap(QPointF(width() / 2.0 - d->iconImage.width() / 2.0,
-		height() / 2.0 - d->iconImage.height() / 2.0),
-		d->iconImage);
+	p.drawPixmap(QRectF(width() / 2.0 - d->iconSize.width() / 2.0,
+		height() / 2.0 - d->iconSize.height() / 2.0,
+		d->iconSize.width(), d->iconSize.height()),
+		icon, QRectF(icon.rect()));
 }
 
 void ImageItemWidget::resizeEvent(QResizeEvent* event)
@@ -183,19 +339,142 @@ void ImageItemWidget::resizeEvent(QResizeEvent* event)
 
 void ImageItemWidgetPrivate::makeImageIcon(QSize size)
 {
-	int w = image.width();
-	int h = image.height();
-	if (w == 0 || h == 0)
+	QSize imageSize = sourceSize();
+	if (imageSize.width() == 0 || imageSize.height() == 0)
 	{
-		iconImage = QPixmap(0, 0);
-		iconImage.fill(QColor(0, 0, 0, 0));
+		iconSize = QSize(0, 0);
 	}
 	else
 	{
-		QSize iconSize(w, h);
+		QSize oldSize = iconSize;
+		iconSize = imageSize;
 		iconSize.scale(size, ratioMode);
-		iconImage = image.scaled(iconSize, ratioMode,
-			Qt::SmoothTransformation);
+		// the scaled image is found (or made) the next
+		// time this is painted
+		if (thumbnailSize != iconSize)
+		{
+			requested = false;
+		}
+		// wait for the size to stop changing before making
+		// another smooth icon
+		if (!oldSize.isEmpty() && oldSize != iconSize && p->isVisible())
+		{
+			settling = true;
+			settleTimer->start();
+		}
 	}
 	p->update();
-}
\ No newline at end of file
+}
+
+void ImageItemWidgetPrivate::remakeImageIcon()
+{
+	int left, top, right, bottom;
+	p->getContentsMargins(&left, &top, &right, &bottom);
+	if (fitInSize.width() < 0)
+	{
+		makeImageIcon(QSize(p->width() - left - right,
+			p->height() - top - bottom));
+	}
+	else
+	{
+		makeImageIcon(QSize(fitInSize.width() - left - right,
+			fitInSize.height() - top - bottom));
+	}
+}
+
+void ImageItemWidgetPrivate::requestThumbnail()
+{
+	if (requested || iconSize.isEmpty())
+	{
+		return;
+	}
+	requested = true;
+	AWE::ImageHandle waitingFor = handle;
+	QString waitingForSource = source();
+	QSize size = iconSize;
+	qreal ratio = p->devicePixelRatio();
+	auto whenDone = [this, waitingFor, waitingForSource, size, ratio]
+		(QImage thumbnail)
+		{
+			// the image may have been replaced in the meantime
+			if (handle != waitingFor || source() != waitingForSource
+				|| thumbnail.isNull())
+			{
+				return;
+			}
+			QPixmap icon = QPixmap::fromImage(thumbnail);
+			// stored under the size that findIcon() looks for
+			QSize pixels = image.isNull() ? icon.size() : size * ratio;
+			if (AWE::ImageCache::instance()->insert(source(), icon,
+				pixels, ratioMode))
+			{
+				uncachedIcon = QPixmap();
+				thumbnailSize = size;
+				// asked for again if it gets dropped from the cache
+				requested = false;
+			}
+			else
+			{
+				// too big to keep there, so it is kept here
+				// and not asked for again at this size
+				uncachedIcon = icon;
+			}
+			if (!painting)
+			{
+				p->update();
+			}
+		};
+
+	if (image.isNull())
+	{
+		AWE::ImageLoader::instance()->loadThumbnail(handle, size,
+			ratio, p, whenDone);
+	}
+	else
+	{
+		// shares the pixels of the pixmap, so nothing is copied
+		AWE::ImageLoader::instance()->scale(image.toImage(), source(), size,
+			ratio, ratioMode, p, whenDone);
+	}
+}
+
+QPixmap ImageItemWidgetPrivate::findIcon(QSize size)
+{
+	qreal ratio = p->devicePixelRatio();
+	QSize pixels = size * ratio;
+	AWE::ImageCache* cache = AWE::ImageCache::instance();
+	return cache->find(source(), pixels, ratioMode);
+}
+
+void ImageItemWidgetPrivate::makeSettleTimer()
+{
+	settling = false;
+	settleTimer = new QTimer(p);
+	settleTimer->setSingleShot(true);
+	settleTimer->setInterval(settleMsec);
+	QObject::connect(settleTimer, &QTimer::timeout, p,
+		[this] ()
+		{
+			settling = false;
+			// a smooth icon is made if this is still visible
+			p->update();
+		} );
+}
+
+QString ImageItemWidgetPrivate::source() const
+{
+	if (image.isNull())
+	{
+		return handle.getFile();
+	}
+	return AWE::ImageCache::sourceFor(image);
+}
+
+QSize ImageItemWidgetPrivate::sourceSize() const
+{
+	if (image.isNull())
+	{
+		return handle.getSize();
+	}
+	return image.size();
+}
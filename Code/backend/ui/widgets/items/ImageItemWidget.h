@@ -13,6 +13,7 @@
 // data
 #include <QPixmap>
 #include <QString>
+#include "image/ImageHandle.h"
 
 // for size
 #include <QSize>
@@ -25,6 +26,13 @@ namespace UI
 
 	/**
 	 * \brief A `QListWidgetItem` that holds an image.
+	 *
+	 * The image is drawn from scaled copies that are
+	 * made on worker threads, and only once the widget
+	 * is painted. While the widget is being resized,
+	 * the last copy is stretched to fit instead, and a
+	 * new one is only made once the size has stopped
+	 * changing for a moment.
 	 **/
 	class AWEMC_BACKEND_LIBRARY ImageItemWidget : public ItemWidget
 	{
@@ -59,6 +67,23 @@ namespace UI
 							bool highlightable = false,
 							QSize size = QSize(-1, -1));
 
+			/**
+			 * \brief Make with the given image handle.
+			 *
+			 * Nothing is decoded until this widget is
+			 * first painted.
+			 *
+			 * \param[in] parent The parent widget.
+			 * \param[in] image The image to show.
+			 * \param[in] highlightable `true` if this widget
+			 *						can be highlighted and
+			 *						selected, `false` if not.
+			 * \param[in] size The width and height of the image.
+			 **/
+			ImageItemWidget(QWidget* parent, int index, AWE::ImageHandle image,
+							bool highlightable = false,
+							QSize size = QSize(-1, -1));
+
 			/**
 			 * \brief Destroy this object.
 			 **/
@@ -141,6 +166,24 @@ namespace UI
 			 **/
 			virtual QPixmap getImage() const;
 
+			/**
+			 * \brief Get the handle to the image held by
+			 *			this widget.
+			 *
+			 * \returns The handle to the image, or a null
+			 *			handle if the image was set directly.
+			 **/
+			virtual AWE::ImageHandle getImageHandle() const;
+
+			/**
+			 * \brief Determine if this widget has an image
+			 *			to show, even if it is not decoded yet.
+			 *
+			 * \returns `true` if there is an image, `false`
+			 *			otherwise.
+			 **/
+			virtual bool hasImage() const;
+
 			/**
 			 * \brief Get the index for the image.
 			 *
@@ -163,6 +206,20 @@ namespace UI
 			 **/
 			virtual void setImage(QPixmap image);
 
+			/**
+			 * \brief Sets the image held by this widget.
+			 *
+			 * The image is drawn from a thumbnail at the
+			 * size it is shown at, which comes from the
+			 * `ThumbnailCache` or is decoded in the background
+			 * the first time this widget is painted at that
+			 * size. Until then, the size from the image's header
+			 * is used for layout.
+			 *
+			 * \param[in] image The handle to the new image.
+			 **/
+			virtual void setImage(AWE::ImageHandle image);
+
 			/**
 			 * \brief Set the index for the image.
 			 *
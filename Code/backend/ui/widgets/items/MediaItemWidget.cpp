@@ -113,7 +113,7 @@ bool MediaItemWidget::fixSizeToFitIn(QSize size)
 	{
 		case IconOnly:
 			// set to the icon's size if it is valid
-			if (!d->icon->getImage().isNull())
+			if (d->icon->hasImage())
 			{
 				ans = d->icon->fixSizeToFitIn(QSize(
 					size.width() - left - right,
@@ -215,7 +215,8 @@ void MediaItemWidget::setMediaItem(MediaItem* item)
 	// make connections for changing the icon image and name
 	auto respondToIconChange = [this] (int index)
 		{
-			d->icon->setImage(d->mediaItem->getDefaultIcon());
+			// only decoded once the widget is actually shown
+			d->icon->setImage(d->mediaItem->getDefaultIconHandle());
 			d->icon->setIndex(index);
 		};
 	auto respondToNameChange = [this] (QString name)
@@ -239,7 +240,7 @@ void MediaItemWidgetPrivate::enactDisplayMode()
 	switch (displayMode)
 	{
 		case MediaItemWidget::IconOnly:
-			if (!icon->getImage().isNull())
+			if (icon->hasImage())
 			{
 				layout->removeWidget(name);
 				layout->addWidget(icon);
@@ -6,6 +6,7 @@
 
 // for determining minimum size
 #include <cmath>
+#include <QCache>
 
 // for painting
 #include "skin/ColoredFont.h"
@@ -13,23 +14,60 @@
 #include <QPainter>
 #include <QPalette>
 #include <QColor>
+#include <QStaticText>
+#include <QTextOption>
 
 namespace UI
 {
+	/** \brief Measured text sizes, shared by every text item. **/
+	static QCache<QString, int>& measuredTextSizes()
+	{
+		static QCache<QString, int> sizes(4096);
+		return sizes;
+	}
+
 	class TextItemWidgetPrivate
 	{
 		public:
+			// parent
+			TextItemWidget* p;
+
+			// Helper function that measures the text, either its
+			// height at a width (if `width` is `true`) or its
+			// width at a height.
+			int measure(int limit, bool width) const;
+
+			// Helper function that looks the font up in the skin.
+			void findFont();
+
+			// Helper function that forgets the shaped text.
+			void invalidate();
+
+			// Helper function that updates the minimum size if
+			// no size to fit in was given.
+			void updateMinimumHeight();
+
 			// The text to display.
 			QString text;
 
 			// The font to use.
 			QString font;
 
+			// The font and color from the skin, looked up
+			// when the font or the skin changes.
+			QFont skinFont;
+			QPen skinPen;
+
 			// The alignment of text.
 			Qt::Alignment alignment;
 
 			// The containing size.
 			QSize fitInSize;
+
+			// The text, shaped for the width it was last
+			// painted at.
+			QStaticText shaped;
+			int shapedWidth;
 	};
 }
 
@@ -41,14 +79,19 @@ TextItemWidget::TextItemWidget(QWidget* parent, QString text, QString font,
 	:	ItemWidget(parent, highlightable),
 		d(new TextItemWidgetPrivate)
 {
+	d->p = this;
 	d->text = text;
 	d->alignment = Qt::AlignLeft | Qt::AlignTop;
 	d->fitInSize = QSize(-1, -1);
+	d->shaped.setTextFormat(Qt::PlainText);
+	d->shapedWidth = -1;
 
 	setFont(font);
 	connect(AWEMC::settings(), &GlobalSettings::skinChanged,
 			this,	[this] ()
 					{
+						// every font may be different now, but measured
+						// sizes are kept by font, so they are still right
 						setFont(d->font);
 					} );
 }
@@ -59,17 +102,13 @@ bool TextItemWidget::fixSizeToFitIn(QSize size)
 	if (size.width() < 0 || size.height() < 0)
 	{
 		setMinimumWidth(0);
-		setFont(d->font);
+		d->updateMinimumHeight();
+		update();
 		return true;
 	}
 	int h = heightForWidth(size.width());
 	int takeOff = (isHighlightable()) ? 21 : 1;
-	ColoredFont cf = AWEMC::settings()->getCurrentSkin()
-		->getFont(getFont());
-	QFontMetrics met = cf.getFontMetrics();
-	int w = met.boundingRect(0, 0, 16777215, h - takeOff,
-				d->alignment | Qt::TextWordWrap,
-				d->text).width() + takeOff;
+	int w = d->measure(h - takeOff, false) + takeOff;
 	setMinimumSize(w, h);
 	setMaximumSize(size.width(), h);
 	update();
@@ -83,14 +122,8 @@ QSize TextItemWidget::getSizeToFitIn() const
 
 int TextItemWidget::heightForWidth(int w) const
 {
-	ColoredFont cf = AWEMC::settings()->getCurrentSkin()
-		->getFont(getFont());
-	QFontMetrics met = cf.getFontMetrics();
 	int takeOff = (isHighlightable()) ? 21 : 1;
-	int ans = met.boundingRect(0, 0, w - takeOff, 16777215, 
-				d->alignment | Qt::TextWordWrap, 
-				d->text).height() + takeOff;
-	return ans;
+	return d->measure(w - takeOff, true) + takeOff;
 }
 
 QString TextItemWidget::getItemType() const
@@ -117,7 +150,9 @@ QString TextItemWidget::getFont() const
 void TextItemWidget::setAlignment(Qt::Alignment alignment)
 {
 	d->alignment = alignment;
-	setFont(d->font);
+	d->invalidate();
+	d->updateMinimumHeight();
+	update();
 }
 
 Qt::Alignment TextItemWidget::getAlignment() const
@@ -127,39 +162,110 @@ Qt::Alignment TextItemWidget::getAlignment() const
 
 void TextItemWidget::setText(QString text)
 {
+	if (d->text == text)
+	{
+		return;
+	}
 	d->text = text;
-	setFont(d->font);
+	d->invalidate();
+	d->updateMinimumHeight();
+	update();
 }
 
 void TextItemWidget::setFont(QString font)
 {
 	d->font = font;
-	if (d->fitInSize.width() < 0 || d->fitInSize.height() < 0)
-	{
-		setMinimumHeight(heightForWidth(width()));
-	}
+	d->findFont();
+	d->invalidate();
+	d->updateMinimumHeight();
 	update();
 }
 
 void TextItemWidget::resizeEvent(QResizeEvent* event)
 {
 	ItemWidget::resizeEvent(event);
-	setFont(d->font);
+	// the shaped text is remade when it is painted at the new width
+	d->updateMinimumHeight();
 }
 
 void TextItemWidget::paintEvent(QPaintEvent* event)
 {
 	ItemWidget::paintEvent(event);
-	// make the painter with the correct font/color
-	QPainter p(this);
-	ColoredFont cf = AWEMC::settings()->getCurrentSkin()
-		->getFont(d->font);
-	p.setFont(cf.getFont());
-	p.setPen(cf.getPen());
-	// paint the text
 	int left, top, right, bottom;
 	getContentsMargins(&left, &top, &right, &bottom);
-	QRectF drawInMe(left, top, width() - left - right - 1,
-		height() - top - bottom - 1);
-	p.drawText(drawInMe, d->alignment | Qt::TextWordWrap, d->text);
-}
\ No newline at end of file
+	int w = width() - left - right - 1;
+	int h = height() - top - bottom - 1;
+	// shape the text only when it or the width changed
+	if (d->shapedWidth != w)
+	{
+		QTextOption option(d->alignment & Qt::AlignHorizontal_Mask);
+		option.setWrapMode(QTextOption::WordWrap);
+		d->shaped.setTextOption(option);
+		d->shaped.setTextWidth(w);
+		d->shaped.prepare(QTransform(), d->skinFont);
+		d->shapedWidth = w;
+	}
+	// place the text like drawText() would
+	qreal y = top;
+	qreal textHeight = d->shaped.size().height();
+	if (d->alignment & Qt::AlignBottom)
+	{
+		y += h - textHeight;
+	}
+	else if (d->alignment & Qt::AlignVCenter)
+	{
+		y += (h - textHeight) / 2.0;
+	}
+	// paint the text with the correct font/color
+	QPainter p(this);
+	p.setFont(d->skinFont);
+	p.setPen(d->skinPen);
+	p.drawStaticText(QPointF(left, y), d->shaped);
+}
+
+int TextItemWidgetPrivate::measure(int limit, bool width) const
+{
+	// sizes are kept for the font, alignment, limit and text
+	QString key = skinFont.key() + '\n' + QString::number(alignment)
+		+ (width ? 'w' : 'h') + QString::number(limit) + '\n' + text;
+	QCache<QString, int>& sizes = measuredTextSizes();
+	if (int* size = sizes.object(key))
+	{
+		return *size;
+	}
+	QFontMetrics met(skinFont);
+	int ans;
+	if (width)
+	{
+		ans = met.boundingRect(0, 0, limit, 16777215,
+				alignment | Qt::TextWordWrap, text).height();
+	}
+	else
+	{
+		ans = met.boundingRect(0, 0, 16777215, limit,
+				alignment | Qt::TextWordWrap, text).width();
+	}
+	sizes.insert(key, new int(ans));
+	return ans;
+}
+
+void TextItemWidgetPrivate::findFont()
+{
+	ColoredFont cf = AWEMC::settings()->getCurrentSkin()->getFont(font);
+	skinFont = cf.getFont();
+	skinPen = cf.getPen();
+}
+
+void TextItemWidgetPrivate::invalidate()
+{
+	shaped.setText(text);
+	shapedWidth = -1;
+}
+
+void TextItemWidgetPrivate::updateMinimumHeight()
+{
+	if (fitInSize.width() < 0 || fitInSize.height() < 0)
+	{
+		p->setMinimumHeight(p->heightForWidth(p->width()));
+	}
+}
@@ -35,6 +35,11 @@ namespace UI
 	 *
 	 * In addition, this class signals mouse click
 	 * events
+	 *
+	 * The font is looked up in the skin only when it
+	 * or the skin changes. Measured sizes are kept for
+	 * every text, font and width, and the text is shaped
+	 * once per width and reused by every paint.
 	 **/
 	class AWEMC_BACKEND_LIBRARY TextItemWidget : public ItemWidget
 	{
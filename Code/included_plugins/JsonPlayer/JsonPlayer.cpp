@@ -5,7 +5,7 @@
 #include <QProcess>
 
 // for matching files
-#include <QStringList>
+#include <QList>
 #include <QRegExp>
 
 // for debug
@@ -26,8 +26,8 @@ class JsonPlayerPrivate
 		// the command string
 		QString command;
 
-		// file types this can play
-		QStringList playable;
+		// file types this can play, compiled once
+		QList<QRegExp> playable;
 
 		// determines if the console is shown
 		bool showConsole;
@@ -65,7 +65,8 @@ JsonPlayer::JsonPlayer(ConfigFile* file)
 	{
 		if (str.isString())
 		{
-			d->playable << str.toString();
+			d->playable << QRegExp(str.toString(), Qt::CaseSensitive,
+				QRegExp::Wildcard);
 		}
 	}
 	if (d->playable.isEmpty())
@@ -112,12 +113,9 @@ bool JsonPlayer::canPlay(MediaFile* file) const
 	{
 		return false;
 	}
-	QRegExp regex;
 	QString f = file->getMediaFile();
-	for (auto str : d->playable)
+	for (auto regex : d->playable)
 	{
-		regex.setPattern(str);
-		regex.setPatternSyntax(QRegExp::Wildcard);
 		if (regex.exactMatch(f))
 		{
 			return true;
@@ -17,7 +17,7 @@ class JsonPlayerFactory : public QObject, public AWE::MediaPlayerFactory
 {
 	Q_OBJECT
 	Q_INTERFACES(AWE::MediaPlayerFactory)
-	Q_PLUGIN_METADATA(IID "com.awe.MediaPlayerFactory")
+	Q_PLUGIN_METADATA(IID "com.awe.MediaPlayerFactory" FILE "JsonPlayer.json")
 
 	public:
 		/**
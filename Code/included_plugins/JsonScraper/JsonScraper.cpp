@@ -6,6 +6,9 @@
 
 // for reading files
 #include "libs/generic_file_reader/file_reader.h"
+#include "libs/internet_reader/internet_reader.h"
+#include "libs/internet_reader/web_fetcher.h"
+#include <QUrl>
 
 // for regular expressions
 #include <QRegularExpression>
@@ -14,6 +17,8 @@
 
 // other important classes
 #include <QVector>
+#include <QHash>
+#include <QTextStream>
 
 // debug
 #include <QDebug>
@@ -25,6 +30,87 @@ using Match = QRegularExpressionMatch;
 using Regex = QRegularExpression;
 using Matches = QVector<QRegularExpressionMatch>;
 
+/**
+ * \brief A string with backreferences like `$1`, split up
+ *			once so that it can be filled in with a single pass.
+ **/
+class BackrefTemplate
+{
+	public:
+		BackrefTemplate()
+			:	length(0),
+				highest(-1)
+			{ }
+
+		explicit BackrefTemplate(const QString& str);
+
+		// fill in the backreferences
+		QString expand(const Match& refs) const;
+
+		// the highest backreference used, or -1 if there are none
+		int getHighestBackref() const { return highest; }
+
+	private:
+		// literal text, or a backreference if `ref` is not -1
+		struct Part
+		{
+			QString text;
+			int ref;
+		};
+		QVector<Part> parts;
+		int length;
+		int highest;
+};
+
+/** \brief A detail to set, with its template if it is a string. **/
+struct CompiledDetail
+{
+	QString key;
+	JsonValue value;
+	bool isString;
+	BackrefTemplate string;
+};
+
+/**
+ * \brief One procedure of the `"scraping procedure"`, read
+ *			from the JSON once when the scraper is made.
+ **/
+struct CompiledProcedure
+{
+	bool repeat;
+	QString textPrompt;
+	QString imagePrompt;
+
+	BackrefTemplate lookInFile;
+	BackrefTemplate lookFor;
+	// compiled ahead of time if "for" has no backreferences
+	bool regexIsConstant;
+	Regex regex;
+
+	bool setsName;
+	BackrefTemplate name;
+	bool setsDescription;
+	BackrefTemplate description;
+	QVector<CompiledDetail> details;
+	QVector<BackrefTemplate> icons;
+	QVector<BackrefTemplate> fanarts;
+
+	QVector<CompiledProcedure> procedures;
+};
+
+/** \brief What one scrape needs to keep track of. **/
+struct JsonScrapeContext
+{
+	// what was found for the item
+	ScrapedMetadata* item;
+
+	// the flags for this scrape
+	JsonScraper::ScraperSettings config;
+
+	// for file contents and speed
+	QHash<QString, QString> previouslyReadFiles;
+};
+
 class JsonScraperPrivate
 {
 	public:
@@ -43,43 +129,50 @@ class JsonScraperPrivate
 		// can there be multiple items per file?
 		bool multipleItemsPerFile;
 
-		// root procedure settings
-		JsonArray rootProcedures;
-
-		// the current item being edited
-		MetadataHolder* currItem;
+		// how many pages to read from one host at once
+		int connectionsPerHost;
 
-		// the current flags
-		JsonScraper::ScraperSettings currConfig;
+		// the root procedures, never changed after the
+		// constructor so that scrapes can share them
+		QVector<CompiledProcedure> rootProcedures;
 
-		// check the scraper's validity
-		inline void checkValidity();
-		inline int getHighestBackref(const QString& refString);
+		// read a procedure, and everything under it, from JSON;
+		// `numRefs` is how many backreferences the enclosing
+		// match has, or -1 if that is not known
+		inline bool compile(const JsonValue& proc, int numRefs,
+			CompiledProcedure* out);
+		// warn about backreferences that can never be filled in
+		inline bool checkBackrefs(const BackrefTemplate& str, int numRefs,
+			const char* member);
 
 		// replace item's metadata with default metadata
-		inline void makeDefault();
+		inline void makeDefault(JsonScrapeContext& context);
 
 		// Execute a procedure
-		inline bool executeProcedure(const JsonValue& proc, const Match& refs);
+		inline bool executeProcedure(JsonScrapeContext& context,
+			const CompiledProcedure& proc, const Match& refs);
 
 		// gets the matches for a given procedure
-		inline Matches getMatches(const JsonValue& proc, const Match& refs);
-
-		// replace backreferences
-		inline void replaceBackrefs(QString& str, const Match& refs);
+		inline Matches getMatches(JsonScrapeContext& context,
+			const CompiledProcedure& proc, const Match& refs);
 
 		// set values for a match
-		inline void getProperties(const JsonValue& proc, const Match& refs);
+		inline void getProperties(JsonScrapeContext& context,
+			const CompiledProcedure& proc, const Match& refs);
+
+		// read a file, once per scrape
+		inline QString getFileContents(JsonScrapeContext& context,
+			const QString& file);
 
-		// for file contents and speed
-		QHash<QString, QString> previouslyReadFiles;
-		inline QString getFileContents(const QString& file);
+		// read every web page that some procedures will look
+		// in for some matches, all at once
+		inline void prefetch(JsonScrapeContext& context,
+			const QVector<CompiledProcedure>& procs, const Matches& refs);
 };
 
 JsonScraper::JsonScraper(ConfigFile* file)
 	:	d(new JsonScraperPrivate)
 {
-	d->currItem = nullptr;
 	if (!file || !file->isValid())
 	{
 		qWarning() << "JsonScraper: Configuration file badly formatted";
@@ -100,7 +193,16 @@ JsonScraper::JsonScraper(ConfigFile* file)
 		d->valid = false;
 		return;
 	}
-	d->fileName = file->getMember({"metadata", "file name"}).toString();
+	d->fileName.setPattern(file->getMember({"metadata", "file name"}).toString());
+	if (!d->fileName.isValid())
+	{
+		qWarning() << "JsonScraper: Bad file name regex for" << d->name
+			<< ":" << d->fileName.errorString();
+		d->valid = false;
+		return;
+	}
+	// compiled now, instead of by the first scrape
+	d->fileName.optimize();
 
 	// get the root procedures array
 	if (!file->getMember({"scraping procedure", "procedures"}).isArray())
@@ -108,15 +210,42 @@ JsonScraper::JsonScraper(ConfigFile* file)
 		qWarning() << "JsonScraper: Missing root procedures array for"
 			<< d->name;
 	}
-	d->rootProcedures = file->getMember({"scraping procedure",
-		"procedures"}).toArray();
+	const JsonArray procs = file->getMember({"scraping procedure",
+		"procedures"}).constToArray();
+	int numRefs = d->fileName.captureCount();
+	for (auto proc : procs)
+	{
+		CompiledProcedure compiled;
+		if (!d->compile(proc, numRefs, &compiled))
+		{
+			d->valid = false;
+		}
+		d->rootProcedures << compiled;
+	}
 
 	// item multiplicity
 	d->multipleItemsPerFile = file->getMember({"scraping procedure",
 		"repeat"}).toBoolean();
 
-	// check the validity of the procedures
-	d->checkValidity();
+	// parallel downloads
+	d->connectionsPerHost = 4;
+	if (file->getMember({"scraping procedure", "connections per host"}).isNumber())
+	{
+		d->connectionsPerHost = file->getMember({"scraping procedure",
+			"connections per host"}).toInteger();
+	}
+
+	// the API quotas of the sites this reads
+	if (file->getMember({"scraping procedure", "rate limits"}).isObject())
+	{
+		const JsonObject limits = file->getMember({"scraping procedure",
+			"rate limits"}).toObject();
+		for (auto host : limits)
+		{
+			WebFetcher::instance()->setRateLimit(host.key(),
+				(*host).toDouble());
+		}
+	}
 }
 
 JsonScraper::~JsonScraper()
@@ -127,96 +256,230 @@ JsonScraper::~JsonScraper()
 bool JsonScraper::addMetadata(MetadataHolder* item,
 	JsonScraper::ScraperSettings config)
 {
-	currItem = item;
-	d->makeDefault();
-	Match fileNameMatch = fileName.match(item->getLocation());
-	if (!fileNameMatch.isValid())
+	// the item is only announced as changed once it is done
+	ScrapedMetadata metadata = ScrapedMetadata::forItem(item);
+	bool ans = scrape(metadata, config);
+	metadata.fetchImages();
+	metadata.applyTo(item);
+	return ans;
+}
+
+bool JsonScraper::isReentrant()
+{
+	// everything a scrape changes is in its context
+	return true;
+}
+
+bool JsonScraper::scrape(ScrapedMetadata& metadata,
+	JsonScraper::ScraperSettings config)
+{
+	if (!d->valid)
 	{
-		qWarning() << "JsonScraper: File name does not match for" << item->getName();
-		currItem = nullptr;
 		return false;
 	}
+	JsonScrapeContext context;
+	context.item = &metadata;
+	context.config = config;
+	d->makeDefault(context);
+	Match fileNameMatch = d->fileName.match(metadata.getLocation());
+	if (!fileNameMatch.hasMatch())
+	{
+		qWarning() << "JsonScraper: File name does not match for"
+			<< metadata.getName();
+		return false;
+	}
+	d->prefetch(context, d->rootProcedures, Matches() << fileNameMatch);
 	bool ans = true;
-	const JsonArray procArray = rootProcedures;
-	for (const auto& proc : procArray)
+	for (const auto& proc : d->rootProcedures)
 	{
-		ans &&= d->executeProcedure(proc, fileNameMatch);
+		ans = d->executeProcedure(context, proc, fileNameMatch) && ans;
 	}
 	return ans;
 }
 
 // TODO makeMediaItems
 
-bool JsonScraperPrivate::executeProcedure(const JsonValue& proc, const Match& refs)
+bool JsonScraper::isValid()
+{
+	return d->valid;
+}
+
+QString JsonScraper::getName()
 {
-	Matches newRefs = getMatches(proc, refs);
+	return d->name;
+}
+
+QString JsonScraper::getType()
+{
+	return d->type;
+}
+
+bool JsonScraperPrivate::executeProcedure(JsonScrapeContext& context,
+	const CompiledProcedure& proc, const Match& refs)
+{
+	Matches newRefs = getMatches(context, proc, refs);
+	// the pages of every child depend only on these matches,
+	// so they are all read before the children are run in order
+	prefetch(context, proc.procedures, newRefs);
 	bool ans = true;
-	for (auto currRefs : newRefs)
+	for (const auto& currRefs : newRefs)
 	{
-		getProperties(proc, currRefs);
-		const JsonArray newProcs = proc["procedures"].toArray();
-		for (auto newProc : newProcs)
+		getProperties(context, proc, currRefs);
+		for (const auto& newProc : proc.procedures)
 		{
-			ans &&= executeProcedure(newProc, currRefs);
+			ans = executeProcedure(context, newProc, currRefs) && ans;
 		}
 	}
+	return ans;
 }
 
-void JsonScraperPrivate::checkValidity()
+bool JsonScraperPrivate::compile(const JsonValue& proc, int numRefs,
+	CompiledProcedure* out)
 {
-	// TODO
+	if (!proc.isObject())
+	{
+		qWarning() << "JsonScraper: Non-object procedure in" << name;
+		return false;
+	}
+	bool ok = true;
+	out->repeat = proc["repeat"].toBoolean();
+	out->textPrompt = proc["ask user with text"].toString();
+	out->imagePrompt = proc["ask user with image"].toString();
+
+	out->lookInFile = BackrefTemplate(proc["look in file"].toString());
+	ok = checkBackrefs(out->lookInFile, numRefs, "look in file") && ok;
+	out->lookFor = BackrefTemplate(proc["for"].toString());
+	ok = checkBackrefs(out->lookFor, numRefs, "for") && ok;
+	out->regexIsConstant = out->lookFor.getHighestBackref() == -1;
+	int newNumRefs = -1;
+	if (out->regexIsConstant)
+	{
+		out->regex.setPattern(proc["for"].toString());
+		if (!out->regex.isValid())
+		{
+			qWarning() << "JsonScraper: Bad regex in" << name << ":"
+				<< out->regex.errorString();
+			return false;
+		}
+		// compiled (and JIT compiled, if possible) now
+		out->regex.optimize();
+		newNumRefs = out->regex.captureCount();
+	}
+
+	out->setsName = proc["set name"].isString();
+	if (out->setsName)
+	{
+		out->name = BackrefTemplate(proc["set name"].toString());
+		ok = checkBackrefs(out->name, newNumRefs, "set name") && ok;
+	}
+	out->setsDescription = proc["set description"].isString();
+	if (out->setsDescription)
+	{
+		out->description = BackrefTemplate(proc["set description"].toString());
+		ok = checkBackrefs(out->description, newNumRefs, "set description") && ok;
+	}
+	if (proc["set details"].isObject())
+	{
+		const JsonObject obj = proc["set details"].toObject();
+		for (auto detail : obj)
+		{
+			CompiledDetail compiled;
+			compiled.key = detail.key();
+			compiled.value = *detail;
+			compiled.isString = compiled.value.isString();
+			if (compiled.isString)
+			{
+				compiled.string = BackrefTemplate(compiled.value.toString());
+				ok = checkBackrefs(compiled.string, newNumRefs, "set details")
+					&& ok;
+			}
+			out->details << compiled;
+		}
+	}
+	const JsonArray icons = proc["add icons"].toArray();
+	for (auto i : icons)
+	{
+		if (!i.isString())
+		{
+			qWarning() << "JsonScraper: Non-string icon in" << name;
+			continue;
+		}
+		out->icons << BackrefTemplate(i.toString());
+		ok = checkBackrefs(out->icons.last(), newNumRefs, "add icons") && ok;
+	}
+	const JsonArray fanarts = proc["add fanarts"].toArray();
+	for (auto i : fanarts)
+	{
+		if (!i.isString())
+		{
+			qWarning() << "JsonScraper: Non-string fanart in" << name;
+			continue;
+		}
+		out->fanarts << BackrefTemplate(i.toString());
+		ok = checkBackrefs(out->fanarts.last(), newNumRefs, "add fanarts") && ok;
+	}
+
+	const JsonArray procs = proc["procedures"].toArray();
+	for (auto newProc : procs)
+	{
+		CompiledProcedure compiled;
+		ok = compile(newProc, newNumRefs, &compiled) && ok;
+		out->procedures << compiled;
+	}
+	return ok;
 }
 
-int JsonScraperPrivate::getHighestBackref(const QString& refString)
+bool JsonScraperPrivate::checkBackrefs(const BackrefTemplate& str,
+	int numRefs, const char* member)
 {
-	// TODO
-	return (int) (((uint) (-1)) >> 1);
+	if (numRefs != -1 && str.getHighestBackref() > numRefs)
+	{
+		qWarning() << "JsonScraper: Backreference" << str.getHighestBackref()
+			<< "in" << member << "of" << name << "does not exist";
+		return false;
+	}
+	return true;
 }
 
-void JsonScraperPrivate::makeDefault()
+void JsonScraperPrivate::makeDefault(JsonScrapeContext& context)
 {
+	Q_UNUSED(context);
 	// TODO
 }
 
-Matches JsonScraperPrivate::getMatches(const JsonValue& proc,
-	const Match& refs)
+Matches JsonScraperPrivate::getMatches(JsonScrapeContext& context,
+	const CompiledProcedure& proc, const Match& refs)
 {
-	// get all of the repeat/ask user members
-	const JsonObject obj = proc.toObject();
-	bool multi = proc["repeat"].toBoolean();
-	bool shouldAsk = currConfig & JsonScraper::AskUser;
-	QString textPromptFormat = proc["ask user with text"].toString();
-	QString imagePromptFormat = proc["ask user with image"].toString();
+	bool shouldAsk = context.config & JsonScraper::AskUser;
 
 	// get the file's contents
-	QString fileToRead = proc["look in file"].toString();
-	replaceBackrefs(fileToRead, refs);
-	QString textToLookIn = getFileContents(fileToRead);
+	QString textToLookIn = getFileContents(context,
+		proc.lookInFile.expand(refs));
 
-	// get the "for" regex
-	QString textToLookFor = proc["for"].toString();
-	replaceBackrefs(textToLookFor, refs);
-	Regex regex(textToLookFor);
+	// get the "for" regex, which only has to be made
+	// here if it depends on the enclosing match
+	Regex regex = proc.regexIsConstant ? proc.regex
+		: Regex(proc.lookFor.expand(refs));
 
 	// get the answer
 	Matches ans;
-	if (shouldAsk && !textPromptFormat.isEmpty()
-		&& !imagePromptFormat.isEmpty())
+	if (shouldAsk && !proc.textPrompt.isEmpty()
+		&& !proc.imagePrompt.isEmpty())
 	{
 		// ask user with both text and images
 		// TODO
 	}
-	if (shouldAsk && !textPromptFormat.isEmpty())
+	if (shouldAsk && !proc.textPrompt.isEmpty())
 	{
 		// ask user with just text
 		// TODO
 	}
-	if (shouldAsk && !imagePromptFormat.isEmpty())
+	if (shouldAsk && !proc.imagePrompt.isEmpty())
 	{
 		// ask user with just images
 		// TODO
 	}
-	if (multi)
+	if (proc.repeat)
 	{
 		// just get all of the matches
 		QRegularExpressionMatchIterator iter = regex.globalMatch(textToLookIn);
@@ -235,58 +498,87 @@ Matches JsonScraperPrivate::getMatches(const JsonValue& proc,
 	}
 }
 
-inline void replaceBackrefs(QString& str, const Match& refs)
+BackrefTemplate::BackrefTemplate(const QString& str)
+	:	length(0),
+		highest(-1)
 {
+	QString literal;
 	int i = 0;
-	while (i < str.count() - 1)
+	while (i < str.length())
 	{
-		if (str[i] == '$')
+		if (str[i] == '$' && i + 1 < str.length())
 		{
-			char c = str[i + 1];
-			switch (c)
+			QChar c = str[i + 1];
+			if (c.isDigit() && c.digitValue() <= 9)
+			{
+				// numbered backref
+				if (!literal.isEmpty())
+				{
+					parts << Part { literal, -1 };
+					length += literal.length();
+					literal.clear();
+				}
+				int ref = c.digitValue();
+				parts << Part { QString(), ref };
+				highest = qMax(highest, ref);
+				i += 2;
+				continue;
+			}
+			if (c == '$')
 			{
-				case '0': case '1': case '2': case '3':
-				case '4': case '5': case '6': case '7':
-				case '8': case '9': // numbered backrefs
-					str.replace(i, 2, refs.captured(c - '0'));
-					i += 2;
-					break;
-				case '$':
-					str.replace(i, 2, "$");
-					i += 2;
-					break;
-				default:
-					// this makes no sense, so leave it alone
-					// this should never even happen with correct
-					// validity checking
-					qWarning() << "JsonScraper: Found invalid reference string"
-						<< "while scraping";
-					++ i;
-					break;
+				literal += '$';
+				i += 2;
+				continue;
 			}
+			// this makes no sense, so leave it alone
+			qWarning() << "JsonScraper: Found invalid reference string" << str;
+		}
+		literal += str[i];
+		++ i;
+	}
+	if (!literal.isEmpty())
+	{
+		parts << Part { literal, -1 };
+		length += literal.length();
+	}
+}
+
+QString BackrefTemplate::expand(const Match& refs) const
+{
+	// most templates are plain text
+	if (parts.count() == 1 && parts[0].ref == -1)
+	{
+		return parts[0].text;
+	}
+	QString ans;
+	ans.reserve(length + 16 * parts.count());
+	for (const auto& part : parts)
+	{
+		if (part.ref == -1)
+		{
+			ans += part.text;
 		}
 		else
 		{
-			++ i;
+			ans += refs.captured(part.ref);
 		}
 	}
+	return ans;
 }
 
-inline void getProperties(const JsonValue& proc, const Match& refs)
+void JsonScraperPrivate::getProperties(JsonScrapeContext& context,
+	const CompiledProcedure& proc, const Match& refs)
 {
+	ScrapedMetadata* currItem = context.item;
 	// name
-	if (proc["set name"].isString())
+	if (proc.setsName)
 	{
-		QString newName = proc["set name"].toString();
-		replaceBackrefs(newName, refs);
-		currItem->setName(newName);
+		currItem->setName(proc.name.expand(refs));
 	}
 	// description
-	if (proc["set description"].isString())
+	if (proc.setsDescription)
 	{
-		QString newDescription = proc["set description"].toString();
-		replaceBackrefs(newDescription, refs);
-		currItem->setDescription(newDescription);
+		currItem->setDescription(proc.description.expand(refs));
 	}
 	// details
 	/*	Details are added according to these rules:
@@ -308,195 +600,185 @@ inline void getProperties(const JsonValue& proc, const Match& refs)
 		- If the value to be edited is an array, the new value is appended.
 		- If the value to be edited is an object or null, the value is replaced.
 	*/
-	if (proc["set details"].isObject())
+	for (const auto& detail : proc.details)
 	{
-		const JsonObject obj = proc["set details"].toObject();
-		for (auto detail : obj)
+		JsonValue detailValue = detail.isString
+			? JsonValue(detail.string.expand(refs)) : detail.value;
+		JsonValue::Type newType = detailValue.getType();
+		JsonValue::Type shouldType = currItem
+			->getDetailValue(detail.key).getType();
+		switch (shouldType)
 		{
-			JsonValue detailValue = *detail;
-			JsonValue::Type newType = detailValue.getType();
-			if (newType == JsonValue::String)
-			{
-				QString temp = detailValue.toString();
-				replaceBackrefs(temp, refs);
-				detailValue = temp;
-			}
-			JsonValue::Type shouldType = currItem
-				->getDetailValue(detail.key()).getType();
-			switch (shouldType)
-			{
-				case JsonValue::String:
-					switch (newType)
-					{
-						case JsonValue::String:
-							currItem->addDetail(detail.key(), detailValue);
-							break;
-						case JsonValue::Number:
-							currItem->addDetail(detail.key(), 
-								QString::number(detailValue.toDouble()));
-							break;
-						case JsonValue::Boolean:
-							if (detailValue.toBoolean())
-							{
-								currItem->addDetail(detail.key(),
-									"Yes");
-							}
-							else
-							{
-								currItem->addDetail(detail.key(),
-									"No");
-							}
-							break;
-						case JsonValue::Array: case JsonValue::Object:
-						case JsonValue::Null: default:
-							// TODO multiple add with arrays?
-							qWarning() << "JsonScraper: Found invalid detail value"
-								<< "while scraping";
-							break;
-					}
-					break;
-				case JsonValue::Number:
-					switch (newType)
+			case JsonValue::String:
+				switch (newType)
+				{
+					case JsonValue::String:
+						currItem->addDetail(detail.key, detailValue);
+						break;
+					case JsonValue::Number:
+						currItem->addDetail(detail.key, 
+							QString::number(detailValue.toDouble()));
+						break;
+					case JsonValue::Boolean:
+						if (detailValue.toBoolean())
+						{
+							currItem->addDetail(detail.key,
+								"Yes");
+						}
+						else
+						{
+							currItem->addDetail(detail.key,
+								"No");
+						}
+						break;
+					case JsonValue::Array: case JsonValue::Object:
+					case JsonValue::Null: default:
+						// TODO multiple add with arrays?
+						qWarning() << "JsonScraper: Found invalid detail value"
+							<< "while scraping";
+						break;
+				}
+				break;
+			case JsonValue::Number:
+				switch (newType)
+				{
+					case JsonValue::String:
 					{
-						case JsonValue::String:
-							bool stringToNumberOk;
-							double detailValueAsNumber = detailValue
-								.toString().toDouble(&stringToNumberOk);
-							if (stringToNumberOk)
-							{
-								currItem->addDetail(detail.key(), detailValueAsNumber);
-							}
-							else
-							{
-								qWarning() << "JsonScraper: Invalid string-to-number"
-									<< "while scraping";
-							}
-							break;
-						case JsonValue::Number:
-							currItem->addDetail(detail.key(), detailValue);
-							break;
-						case JsonValue::Boolean:
-							if (detailValue.toBoolean())
-							{
-								currItem->addDetail(detail.key(), 1);
-							}
-							else
-							{
-								currItem->addDetail(detail.key(), 0);
-							}
-							break;
-						case JsonValue::Array: case JsonValue::Object:
-						case JsonValue::Null: default:
-							qWarning() << "JsonScraper: Invalid detail value"
+						bool stringToNumberOk;
+						double detailValueAsNumber = detailValue
+							.toString().toDouble(&stringToNumberOk);
+						if (stringToNumberOk)
+						{
+							currItem->addDetail(detail.key, detailValueAsNumber);
+						}
+						else
+						{
+							qWarning() << "JsonScraper: Invalid string-to-number"
 								<< "while scraping";
-							break;
+						}
+						break;
 					}
-					break;
-				case JsonValue::Boolean:
-					switch (newType)
+					case JsonValue::Number:
+						currItem->addDetail(detail.key, detailValue);
+						break;
+					case JsonValue::Boolean:
+						if (detailValue.toBoolean())
+						{
+							currItem->addDetail(detail.key, 1);
+						}
+						else
+						{
+							currItem->addDetail(detail.key, 0);
+						}
+						break;
+					case JsonValue::Array: case JsonValue::Object:
+					case JsonValue::Null: default:
+						qWarning() << "JsonScraper: Invalid detail value"
+							<< "while scraping";
+						break;
+				}
+				break;
+			case JsonValue::Boolean:
+				switch (newType)
+				{
+					case JsonValue::String:
 					{
-						case JsonValue::String:
-							QString boolString = detailValue.toString();
-							if (!QString::compare(boolString, "yes",
-								Qt::CaseInsensitive) || !QString::compare(
-								boolString, "true", Qt::CaseInsensitive))
-							{
-								currItem->addDetail(detail.key(), true);
-							}
-							else if (!QString::compare(boolString, "no",
-								Qt::CaseInsensitive) || !QString::compare(
-								boolString, "false", Qt::CaseInsensitive))
-							{
-								currItem->addDetail(detail.key(), false);
-							}
-							else
-							{
-								qWarning() << "JsonScraper: Invalid string-to-bool"
-									<< "conversion.";
-							}
-							break;
-						case JsonValue::Number:
-							currItem->addDetail(detail.key(), (bool)
-								detailValue.toInteger());
-							break;
-						case JsonValue::Boolean:
-							currItem->addDetail(detail.key(), detailValue);
-							break;
-						case JsonValue::Array: case JsonValue::Object:
-						case JsonValue::Null: default:
-							qWarning() << "JsonScraper: Invalid detail value"
-								<< "while scraping";
-							break;
+						QString boolString = detailValue.toString();
+						if (!QString::compare(boolString, "yes",
+							Qt::CaseInsensitive) || !QString::compare(
+							boolString, "true", Qt::CaseInsensitive))
+						{
+							currItem->addDetail(detail.key, true);
+						}
+						else if (!QString::compare(boolString, "no",
+							Qt::CaseInsensitive) || !QString::compare(
+							boolString, "false", Qt::CaseInsensitive))
+						{
+							currItem->addDetail(detail.key, false);
+						}
+						else
+						{
+							qWarning() << "JsonScraper: Invalid string-to-bool"
+								<< "conversion.";
+						}
+						break;
 					}
-					break;
-				case JsonValue::Array: case JsonValue::Object:
-				case JsonValue::Null: default:
-					currItem->addDetail(detail.key(), detailValue);
-					break;
-			}
+					case JsonValue::Number:
+						currItem->addDetail(detail.key, (bool)
+							detailValue.toInteger());
+						break;
+					case JsonValue::Boolean:
+						currItem->addDetail(detail.key, detailValue);
+						break;
+					case JsonValue::Array: case JsonValue::Object:
+					case JsonValue::Null: default:
+						qWarning() << "JsonScraper: Invalid detail value"
+							<< "while scraping";
+						break;
+				}
+				break;
+			case JsonValue::Array: case JsonValue::Object:
+			case JsonValue::Null: default:
+				currItem->addDetail(detail.key, detailValue);
+				break;
 		}
 	}
 	// icons
-	if (proc["add icons"].isArray())
+	for (const auto& icon : proc.icons)
 	{
-		const JsonArray arr = proc["add icons"].toArray();
-		for (auto i : arr)
-		{
-			if (!i.isString())
-			{
-				qWarning() << "JsonScraper: Non-string icon while scraping";
-			}
-			else
-			{
-				QString iconToAdd = i.toString();
-				replaceBackrefs(iconToAdd, refs);
-				if (currConfig & JsonScraper::ImportIcons)
-				{
-					currItem->importIcon(iconToAdd);
-				}
-				else
-				{
-					currItem->addIcon(iconToAdd);
-				}
-			}
-		}
+		currItem->addIcon(icon.expand(refs),
+			context.config.testFlag(JsonScraper::ImportIcons));
 	}
 	// fanarts
-	if (proc["add fanarts"].isArray())
+	for (const auto& fanart : proc.fanarts)
 	{
-		const JsonArray arr = proc["add fanarts"].toArray();
-		for (auto i : arr)
-		{
-			if (!i.isString())
-			{
-				qWarning() << "JsonScraper: Non-string fanart while scraping";
-			}
-			else
-			{
-				QString fanartToAdd = i.toString();
-				replaceBackrefs(fanartToAdd, refs);
-				if (currConfig & JsonScraper::ImportFanarts)
-				{
-					currItem->importFanart(fanartToAdd);
-				}
-				else
-				{
-					currItem->addFanart(fanartToAdd);
-				}
-			}
-		}
+		currItem->addFanart(fanart.expand(refs),
+			context.config.testFlag(JsonScraper::ImportFanarts));
 	}
 }
 
-QString JsonScraperPrivate::getFileContents(const QString& file)
+QString JsonScraperPrivate::getFileContents(JsonScrapeContext& context,
+	const QString& file)
 {
-	if (previouslyReadFiles.contains(file))
+	if (context.previouslyReadFiles.contains(file))
 	{
-		return previouslyReadFiles[files];
+		return context.previouslyReadFiles[file];
 	}
 	QString contents;
 	QTextStream stream(&contents);
 	copyFile(file, stream);
-	previouslyReadFiles[file] = contents;
+	context.previouslyReadFiles[file] = contents;
 	return contents;
-}
\ No newline at end of file
+}
+
+void JsonScraperPrivate::prefetch(JsonScrapeContext& context,
+	const QVector<CompiledProcedure>& procs, const Matches& refs)
+{
+	QList<QString> pages;
+	for (const auto& currRefs : refs)
+	{
+		for (const auto& proc : procs)
+		{
+			QString file = proc.lookInFile.expand(currRefs);
+			QUrl url(file);
+			// local files are read when they are needed
+			if (url.isValid() && !url.isRelative()
+				&& !context.previouslyReadFiles.contains(file)
+				&& !pages.contains(file))
+			{
+				pages << file;
+			}
+		}
+	}
+	// one page is read the usual way
+	if (pages.count() < 2)
+	{
+		return;
+	}
+	QList<QString> contents;
+	readURLsIntoStrings(pages, contents, connectionsPerHost);
+	for (int i = 0; i < pages.count(); ++ i)
+	{
+		context.previouslyReadFiles[pages[i]] = contents[i];
+	}
+}
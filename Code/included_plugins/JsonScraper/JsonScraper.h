@@ -45,6 +45,26 @@ class JsonScraper : public AWE::MetadataScraper
 		virtual bool addMetadata(AWE::MetadataHolder* item,
 			ScraperSettings config);
 
+		/**
+		 * \brief Determines if `scrape()` may be called from
+		 *			several threads at once.
+		 *
+		 * \returns `true`, since each scrape keeps its own state.
+         */
+		virtual bool isReentrant();
+
+		/**
+		 * \brief Retrieves metadata for a copy of a metadata object.
+		 *
+		 * \param[inout] metadata The copy of the object.
+		 * \param[in] config Settings to determine scraping behaviour.
+		 *
+		 * \returns `true` if the scraper was able to get the metadata,
+		 *			`false` if it was not.
+         */
+		virtual bool scrape(AWE::ScrapedMetadata& metadata,
+			ScraperSettings config);
+
 		/**
 		 * \brief Create a media item (or multiple if applicable) from a
 		 *			given file or folder.
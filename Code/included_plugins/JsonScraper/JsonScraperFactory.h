@@ -17,7 +17,7 @@ class JsonScraperFactory : public QObject, public AWE::MetadataScraperFactory
 {
 	Q_OBJECT
 	Q_INTERFACES(AWE::MetadataScraperFactory)
-	Q_PLUGIN_METADATA(IID "com.awe.MetadataScraperFactory")
+	Q_PLUGIN_METADATA(IID "com.awe.MetadataScraperFactory/2" FILE "JsonScraper.json")
 
 	public:
 		/**
@@ -17,7 +17,7 @@ class JsonServiceFactory : public QObject, public AWE::MediaServiceFactory
 {
 	Q_OBJECT
 	Q_INTERFACES(AWE::MediaServiceFactory)
-	Q_PLUGIN_METADATA(IID "com.awe.MediaServiceFactory")
+	Q_PLUGIN_METADATA(IID "com.awe.MediaServiceFactory" FILE "JsonService.json")
 
 	public:
 		/**